@@ -55,6 +55,11 @@ AdvectionDriver::AdvectionDriver(ParameterInput *pin, ApplicationInput *app_in,
 // See the advection.hpp declaration for a description of how this function gets called.
 TaskCollection AdvectionDriver::MakeTaskCollection(BlockList_t &blocks, const int stage) {
   using namespace parthenon::Update;
+  auto pkg = pmesh->packages.Get("advection_package");
+  if (pkg->Param<bool>("overlap_comm")) {
+    return MakeOverlappingTaskCollection(blocks, stage);
+  }
+
   TaskCollection tc;
   TaskID none(0);
 
@@ -105,7 +110,8 @@ TaskCollection AdvectionDriver::MakeTaskCollection(BlockList_t &blocks, const in
     // effectively, sc1 = sc0 + dudt*dt
     auto &sc1 = pmb->meshblock_data.Get(stage_name[stage]);
 
-    auto advect_flux = tl.AddTask(none, advection_package::CalculateFluxes, sc0);
+    auto advect_flux = tl.AddTask(none, advection_package::CalculateFluxes, sc0,
+                                  advection_package::FluxRegion::all);
   }
 
   // note that task within this region that contains one tasklist per pack
@@ -163,4 +169,81 @@ TaskCollection AdvectionDriver::MakeTaskCollection(BlockList_t &blocks, const in
   return tc;
 }
 
+TaskCollection AdvectionDriver::MakeOverlappingTaskCollection(BlockList_t &blocks,
+                                                              const int stage) {
+  using namespace parthenon::Update;
+  using advection_package::FluxRegion;
+  TaskCollection tc;
+  TaskID none(0);
+
+  const Real beta = integrator->beta[stage - 1];
+  const Real dt = integrator->dt;
+  const auto &stage_name = integrator->stage_name;
+  const bool last_stage = stage == integrator->nstages;
+  const auto any = parthenon::BoundaryType::any;
+
+  auto partitions = pmesh->GetDefaultBlockPartitions();
+  TaskRegion &single_tasklist_per_pack_region = tc.AddRegion(partitions.size());
+  for (int i = 0; i < partitions.size(); i++) {
+    auto &tl = single_tasklist_per_pack_region[i];
+    auto &mbase = pmesh->mesh_data.Add("base", partitions[i]);
+    auto &mc0 = pmesh->mesh_data.Add(stage_name[stage - 1], mbase);
+    auto &mc1 = pmesh->mesh_data.Add(stage_name[stage], mbase);
+    auto &mdudt = pmesh->mesh_data.Add("dUdt", mbase);
+
+    auto start_flxcor = tl.AddTask(none, parthenon::StartReceiveFluxCorrections, mc0);
+
+    // The previous stage only sent the ghost zones of its output. Receives for this
+    // stage's output are posted once they have arrived since both use the same buffers.
+    auto ghosts = none;
+    if (stage > 1) {
+      ghosts = parthenon::AddBoundaryReceiveTasks(none, tl, mc0, pmesh->multilevel);
+    }
+    auto start_recv = tl.AddTask(ghosts, parthenon::StartReceiveBoundBufs<any>, mc1);
+
+    // The core fluxes are added after the receive so that they run while it waits
+    auto flx = none;
+    for (int b = 0; b < mc0->NumBlocks(); b++) {
+      auto &sc0 = mc0->GetBlockData(b);
+      auto fill_derived = ghosts;
+      if (stage > 1) {
+        fill_derived = tl.AddTask(ghosts, FillDerived<MeshBlockData<Real>>, sc0.get());
+      }
+      auto core =
+          tl.AddTask(none, advection_package::CalculateFluxes, sc0, FluxRegion::core);
+      auto shell = tl.AddTask(fill_derived, advection_package::CalculateFluxes, sc0,
+                              FluxRegion::shell);
+      flx = flx | core | shell;
+    }
+
+    auto set_flx =
+        parthenon::AddFluxCorrectionTasks(start_flxcor | flx, tl, mc0, pmesh->multilevel);
+
+    auto flux_div =
+        tl.AddTask(set_flx, FluxDivergence<MeshData<Real>>, mc0.get(), mdudt.get());
+    auto avg_data = tl.AddTask(flux_div, AverageIndependentData<MeshData<Real>>,
+                               mc0.get(), mbase.get(), beta);
+    auto update = tl.AddTask(avg_data, UpdateIndependentData<MeshData<Real>>, mc0.get(),
+                             mdudt.get(), beta * dt, mc1.get());
+
+    if (!last_stage) {
+      parthenon::AddBoundarySendTasks(update | start_recv, tl, mc1, pmesh->multilevel);
+      continue;
+    }
+
+    // Outputs, refinement and the next cycle need complete ghost zones
+    auto boundaries = parthenon::AddBoundaryExchangeTasks(update | start_recv, tl, mc1,
+                                                          pmesh->multilevel);
+    for (int b = 0; b < mc1->NumBlocks(); b++) {
+      auto sc1 = mc1->GetBlockData(b).get();
+      auto fill_derived = tl.AddTask(boundaries, FillDerived<MeshBlockData<Real>>, sc1);
+      tl.AddTask(fill_derived, EstimateTimestep<MeshBlockData<Real>>, sc1);
+      if (pmesh->adaptive) {
+        tl.AddTask(fill_derived, parthenon::Refinement::Tag<MeshBlockData<Real>>, sc1);
+      }
+    }
+  }
+  return tc;
+}
+
 } // namespace advection_example
@@ -34,6 +34,10 @@ class AdvectionDriver : public MultiStageDriver {
   //       DriverUtils::ConstructAndExecuteTaskLists (driver.hpp)
   //         AdvectionDriver::MakeTaskCollection (advection_driver.cpp)
   TaskCollection MakeTaskCollection(BlockList_t &blocks, int stage);
+  // Used instead of MakeTaskCollection if <Advection>/overlap_comm = true. The ghost
+  // zones a stage produces are only waited for by the next stage, which in the meantime
+  // computes all fluxes that do not depend on them.
+  TaskCollection MakeOverlappingTaskCollection(BlockList_t &blocks, int stage);
 };
 
 void ProblemGenerator(MeshBlock *pmb, parthenon::ParameterInput *pin);
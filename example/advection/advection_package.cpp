@@ -76,6 +76,11 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   auto fill_derived = pin->GetOrAddBoolean("Advection", "fill_derived", true);
   pkg->AddParam<>("fill_derived", fill_derived);
 
+  // Compute fluxes that do not need ghost zones while the ghost zones are exchanged, see
+  // AdvectionDriver::MakeOverlappingTaskCollection
+  auto overlap_comm = pin->GetOrAddBoolean("Advection", "overlap_comm", false);
+  pkg->AddParam<>("overlap_comm", overlap_comm);
+
   // For wavevector along coordinate axes, set desired values of ang_2/ang_3.
   //    For example, for 1D problem use ang_2 = ang_3 = 0.0
   //    For wavevector along grid diagonal, do not input values for ang_2/ang_3.
@@ -493,19 +498,44 @@ Real EstimateTimestepBlock(MeshBlockData<Real> *rc) {
   return cfl * min_dt;
 }
 
+namespace {
+// Faces normal to dir that lie in region. Donor cell reconstruction reads one cell on
+// either side of a face, and only along the face normal, so faces at least one cell away
+// from the ghost zones in that direction can be computed before ghosts are received.
+std::vector<parthenon::IndexBox> FluxBoxes(const parthenon::IndexShape &cellbounds,
+                                           const int dir, const FluxRegion region) {
+  using TE = parthenon::TopologicalElement;
+  const TE face = dir == X1DIR ? TE::F1 : (dir == X2DIR ? TE::F2 : TE::F3);
+  const auto interior = cellbounds.GetBox(IndexDomain::interior, face);
+  if (region == FluxRegion::all) return {interior};
+
+  constexpr int stencil_width = 1;
+  auto core = interior;
+  if (dir == X1DIR) core.i = cellbounds.GetCoreBoundsI(stencil_width, face);
+  if (dir == X2DIR) core.j = cellbounds.GetCoreBoundsJ(stencil_width, face);
+  if (dir == X3DIR) core.k = cellbounds.GetCoreBoundsK(stencil_width, face);
+  if (region == FluxRegion::core) {
+    if (core.empty()) return {};
+    return {core};
+  }
+  std::vector<parthenon::IndexBox> shell;
+  for (const auto &box : cellbounds.GetShellBoxes(core, face)) {
+    if (!box.empty()) shell.push_back(box);
+  }
+  return shell;
+}
+} // namespace
+
 // Compute fluxes at faces given the constant velocity field and
 // some field "advected" that we are pushing around.
 // This routine implements all the "physics" in this example
-TaskStatus CalculateFluxes(std::shared_ptr<MeshBlockData<Real>> &rc) {
+TaskStatus CalculateFluxes(std::shared_ptr<MeshBlockData<Real>> &rc,
+                           const FluxRegion region) {
   using parthenon::MetadataFlag;
 
   PARTHENON_INSTRUMENT
   auto pmb = rc->GetBlockPointer();
 
-  IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-  IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-  IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
-
   auto pkg = pmb->packages.Get("advection_package");
   const auto &vx = pkg->Param<Real>("vx");
   const auto &vy = pkg->Param<Real>("vy");
@@ -525,122 +555,139 @@ TaskStatus CalculateFluxes(std::shared_ptr<MeshBlockData<Real>> &rc) {
   const int nvar = v.GetDim(4);
   size_t scratch_size_in_bytes = parthenon::ScratchPad2D<Real>::shmem_size(nvar, nx1);
   // get x-fluxes
-  pmb->par_for_outer(
-      PARTHENON_AUTO_LABEL, 2 * scratch_size_in_bytes, scratch_level, kb.s, kb.e, jb.s,
-      jb.e, KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int k, const int j) {
-        parthenon::ScratchPad2D<Real> ql(member.team_scratch(scratch_level), nvar, nx1);
-        parthenon::ScratchPad2D<Real> qr(member.team_scratch(scratch_level), nvar, nx1);
-        // get reconstructed state on faces
-        parthenon::DonorCellX1(member, k, j, ib.s - 1, ib.e + 1, v, ql, qr);
-        // Sync all threads in the team so that scratch memory is consistent
-        member.team_barrier();
-
-        for (int n = 0; n < nvar; n++) {
-          par_for_inner(member, ib.s, ib.e + 1, [&](const int i) {
-            // standard avection with fixed, global vx
-            if (v_const) {
-              if (vx > 0.0) {
-                v.flux(X1DIR, n, k, j, i) = ql(n, i) * vx;
-              } else {
-                v.flux(X1DIR, n, k, j, i) = qr(n, i) * vx;
-              }
-              // Custom flux function to move isolated, cells around. Just used for
-              // bvals testing.
-            } else {
-              v.flux(X1DIR, n, k, j, i) =
-                  ql(idx_v, i) > 0.0 ? ql(n, i) * ql(idx_v, i) : 0.0;
-              v.flux(X1DIR, n, k, j, i) +=
-                  qr(idx_v, i) < 0.0 ? qr(n, i) * qr(idx_v, i) : 0.0;
-            }
-          });
-        }
-      });
-
-  // get y-fluxes
-  if (pmb->pmy_mesh->ndim >= 2) {
+  for (const auto &box : FluxBoxes(pmb->cellbounds, X1DIR, region)) {
+    const IndexRange ib = box.i;
     pmb->par_for_outer(
-        PARTHENON_AUTO_LABEL, 3 * scratch_size_in_bytes, scratch_level, kb.s, kb.e, jb.s,
-        jb.e + 1, KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int k, const int j) {
-          // the overall algorithm/use of scratch pad here is clear inefficient and kept
-          // just for demonstrating purposes. The key point is that we cannot reuse
-          // reconstructed arrays for different `j` with `j` being part of the outer
-          // loop given that this loop can be handled by multiple threads simultaneously.
-
+        PARTHENON_AUTO_LABEL, 2 * scratch_size_in_bytes, scratch_level, box.k.s, box.k.e,
+        box.j.s, box.j.e,
+        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int k, const int j) {
           parthenon::ScratchPad2D<Real> ql(member.team_scratch(scratch_level), nvar, nx1);
           parthenon::ScratchPad2D<Real> qr(member.team_scratch(scratch_level), nvar, nx1);
-          parthenon::ScratchPad2D<Real> q_unused(member.team_scratch(scratch_level), nvar,
-                                                 nx1);
           // get reconstructed state on faces
-          parthenon::DonorCellX2(member, k, j - 1, ib.s, ib.e, v, ql, q_unused);
-          parthenon::DonorCellX2(member, k, j, ib.s, ib.e, v, q_unused, qr);
+          parthenon::DonorCellX1(member, k, j, ib.s - 1, ib.e, v, ql, qr);
           // Sync all threads in the team so that scratch memory is consistent
           member.team_barrier();
+
           for (int n = 0; n < nvar; n++) {
             par_for_inner(member, ib.s, ib.e, [&](const int i) {
-              // standard avection with fixed, global vy
+              // standard avection with fixed, global vx
               if (v_const) {
-                if (vy > 0.0) {
-                  v.flux(X2DIR, n, k, j, i) = ql(n, i) * vy;
+                if (vx > 0.0) {
+                  v.flux(X1DIR, n, k, j, i) = ql(n, i) * vx;
                 } else {
-                  v.flux(X2DIR, n, k, j, i) = qr(n, i) * vy;
+                  v.flux(X1DIR, n, k, j, i) = qr(n, i) * vx;
                 }
                 // Custom flux function to move isolated, cells around. Just used for
                 // bvals testing.
               } else {
-                v.flux(X2DIR, n, k, j, i) = ql(idx_v + X2DIR - 1, i) > 0.0
-                                                ? ql(n, i) * ql(idx_v + X2DIR - 1, i)
-                                                : 0.0;
-                v.flux(X2DIR, n, k, j, i) += qr(idx_v + X2DIR - 1, i) < 0.0
-                                                 ? qr(n, i) * qr(idx_v + X2DIR - 1, i)
-                                                 : 0.0;
+                v.flux(X1DIR, n, k, j, i) =
+                    ql(idx_v, i) > 0.0 ? ql(n, i) * ql(idx_v, i) : 0.0;
+                v.flux(X1DIR, n, k, j, i) +=
+                    qr(idx_v, i) < 0.0 ? qr(n, i) * qr(idx_v, i) : 0.0;
               }
             });
           }
         });
   }
 
+  // get y-fluxes
+  if (pmb->pmy_mesh->ndim >= 2) {
+    for (const auto &box : FluxBoxes(pmb->cellbounds, X2DIR, region)) {
+      const IndexRange ib = box.i;
+      pmb->par_for_outer(
+          PARTHENON_AUTO_LABEL, 3 * scratch_size_in_bytes, scratch_level, box.k.s,
+          box.k.e, box.j.s, box.j.e,
+          KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int k, const int j) {
+            // the overall algorithm/use of scratch pad here is clear inefficient and kept
+            // just for demonstrating purposes. The key point is that we cannot reuse
+            // reconstructed arrays for different `j` with `j` being part of the outer
+            // loop given that this loop can be handled by multiple threads
+            // simultaneously.
+
+            parthenon::ScratchPad2D<Real> ql(member.team_scratch(scratch_level), nvar,
+                                             nx1);
+            parthenon::ScratchPad2D<Real> qr(member.team_scratch(scratch_level), nvar,
+                                             nx1);
+            parthenon::ScratchPad2D<Real> q_unused(member.team_scratch(scratch_level),
+                                                   nvar, nx1);
+            // get reconstructed state on faces
+            parthenon::DonorCellX2(member, k, j - 1, ib.s, ib.e, v, ql, q_unused);
+            parthenon::DonorCellX2(member, k, j, ib.s, ib.e, v, q_unused, qr);
+            // Sync all threads in the team so that scratch memory is consistent
+            member.team_barrier();
+            for (int n = 0; n < nvar; n++) {
+              par_for_inner(member, ib.s, ib.e, [&](const int i) {
+                // standard avection with fixed, global vy
+                if (v_const) {
+                  if (vy > 0.0) {
+                    v.flux(X2DIR, n, k, j, i) = ql(n, i) * vy;
+                  } else {
+                    v.flux(X2DIR, n, k, j, i) = qr(n, i) * vy;
+                  }
+                  // Custom flux function to move isolated, cells around. Just used for
+                  // bvals testing.
+                } else {
+                  v.flux(X2DIR, n, k, j, i) = ql(idx_v + X2DIR - 1, i) > 0.0
+                                                  ? ql(n, i) * ql(idx_v + X2DIR - 1, i)
+                                                  : 0.0;
+                  v.flux(X2DIR, n, k, j, i) += qr(idx_v + X2DIR - 1, i) < 0.0
+                                                   ? qr(n, i) * qr(idx_v + X2DIR - 1, i)
+                                                   : 0.0;
+                }
+              });
+            }
+          });
+    }
+  }
+
   // get z-fluxes
   if (pmb->pmy_mesh->ndim == 3) {
-    pmb->par_for_outer(
-        PARTHENON_AUTO_LABEL, 3 * scratch_size_in_bytes, scratch_level, kb.s, kb.e + 1,
-        jb.s, jb.e,
-        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int k, const int j) {
-          // the overall algorithm/use of scratch pad here is clear inefficient and kept
-          // just for demonstrating purposes. The key point is that we cannot reuse
-          // reconstructed arrays for different `j` with `j` being part of the outer
-          // loop given that this loop can be handled by multiple threads simultaneously.
-
-          parthenon::ScratchPad2D<Real> ql(member.team_scratch(scratch_level), nvar, nx1);
-          parthenon::ScratchPad2D<Real> qr(member.team_scratch(scratch_level), nvar, nx1);
-          parthenon::ScratchPad2D<Real> q_unused(member.team_scratch(scratch_level), nvar,
-                                                 nx1);
-          // get reconstructed state on faces
-          parthenon::DonorCellX3(member, k - 1, j, ib.s, ib.e, v, ql, q_unused);
-          parthenon::DonorCellX3(member, k, j, ib.s, ib.e, v, q_unused, qr);
-          // Sync all threads in the team so that scratch memory is consistent
-          member.team_barrier();
-          for (int n = 0; n < nvar; n++) {
-            par_for_inner(member, ib.s, ib.e, [&](const int i) {
-              // standard avection with fixed, global vz
-              if (v_const) {
-                if (vz > 0.0) {
-                  v.flux(X3DIR, n, k, j, i) = ql(n, i) * vz;
+    for (const auto &box : FluxBoxes(pmb->cellbounds, X3DIR, region)) {
+      const IndexRange ib = box.i;
+      pmb->par_for_outer(
+          PARTHENON_AUTO_LABEL, 3 * scratch_size_in_bytes, scratch_level, box.k.s,
+          box.k.e, box.j.s, box.j.e,
+          KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int k, const int j) {
+            // the overall algorithm/use of scratch pad here is clear inefficient and kept
+            // just for demonstrating purposes. The key point is that we cannot reuse
+            // reconstructed arrays for different `j` with `j` being part of the outer
+            // loop given that this loop can be handled by multiple threads
+            // simultaneously.
+
+            parthenon::ScratchPad2D<Real> ql(member.team_scratch(scratch_level), nvar,
+                                             nx1);
+            parthenon::ScratchPad2D<Real> qr(member.team_scratch(scratch_level), nvar,
+                                             nx1);
+            parthenon::ScratchPad2D<Real> q_unused(member.team_scratch(scratch_level),
+                                                   nvar, nx1);
+            // get reconstructed state on faces
+            parthenon::DonorCellX3(member, k - 1, j, ib.s, ib.e, v, ql, q_unused);
+            parthenon::DonorCellX3(member, k, j, ib.s, ib.e, v, q_unused, qr);
+            // Sync all threads in the team so that scratch memory is consistent
+            member.team_barrier();
+            for (int n = 0; n < nvar; n++) {
+              par_for_inner(member, ib.s, ib.e, [&](const int i) {
+                // standard avection with fixed, global vz
+                if (v_const) {
+                  if (vz > 0.0) {
+                    v.flux(X3DIR, n, k, j, i) = ql(n, i) * vz;
+                  } else {
+                    v.flux(X3DIR, n, k, j, i) = qr(n, i) * vz;
+                  }
+                  // Custom flux function to move isolated, cells around. Just used for
+                  // bvals testing.
                 } else {
-                  v.flux(X3DIR, n, k, j, i) = qr(n, i) * vz;
+                  v.flux(X3DIR, n, k, j, i) = ql(idx_v + X3DIR - 1, i) > 0.0
+                                                  ? ql(n, i) * ql(idx_v + X3DIR - 1, i)
+                                                  : 0.0;
+                  v.flux(X3DIR, n, k, j, i) += qr(idx_v + X3DIR - 1, i) < 0.0
+                                                   ? qr(n, i) * qr(idx_v + X3DIR - 1, i)
+                                                   : 0.0;
                 }
-                // Custom flux function to move isolated, cells around. Just used for
-                // bvals testing.
-              } else {
-                v.flux(X3DIR, n, k, j, i) = ql(idx_v + X3DIR - 1, i) > 0.0
-                                                ? ql(n, i) * ql(idx_v + X3DIR - 1, i)
-                                                : 0.0;
-                v.flux(X3DIR, n, k, j, i) += qr(idx_v + X3DIR - 1, i) < 0.0
-                                                 ? qr(n, i) * qr(idx_v + X3DIR - 1, i)
-                                                 : 0.0;
-              }
-            });
-          }
-        });
+              });
+            }
+          });
+    }
   }
 
   return TaskStatus::complete;
@@ -28,7 +28,10 @@ void PreFill(MeshBlockData<Real> *rc);
 void SquareIt(MeshBlockData<Real> *rc);
 void PostFill(MeshBlockData<Real> *rc);
 Real EstimateTimestepBlock(MeshBlockData<Real> *rc);
-TaskStatus CalculateFluxes(std::shared_ptr<MeshBlockData<Real>> &rc);
+// Faces covered by CalculateFluxes. The core faces only read interior cells and can be
+// computed while ghost zones are being exchanged, the shell faces are the rest.
+enum class FluxRegion { all, core, shell };
+TaskStatus CalculateFluxes(std::shared_ptr<MeshBlockData<Real>> &rc, FluxRegion region);
 template <typename T>
 Real AdvectionHst(MeshData<Real> *md);
 template <typename T>
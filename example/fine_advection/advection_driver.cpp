@@ -155,7 +155,7 @@ TaskCollection AdvectionDriver::MakeTaskCollection(BlockList_t &blocks, const in
         tl.AddTask(boundaries, parthenon::Update::FillDerived<MeshData<Real>>, mc1.get());
 
     if (stage == integrator->nstages) {
-      auto new_dt = tl.AddTask(fill_derived, EstimateTimestep<MeshData<Real>>, mc1.get());
+      auto new_dt = tl.AddTask(fill_derived, EstimateTimestepDevice, mc1.get());
       if (pmesh->adaptive) {
         auto tag_refine =
             tl.AddTask(new_dt, parthenon::Refinement::Tag<MeshData<Real>>, mc1.get());
@@ -163,6 +163,13 @@ TaskCollection AdvectionDriver::MakeTaskCollection(BlockList_t &blocks, const in
     }
   }
 
+  if (stage == integrator->nstages) {
+    // Bring the estimates of all partitions to the host at once and reduce them over
+    // ranks while the driver finishes the cycle
+    TaskRegion &single_tasklist_region = tc.AddRegion(1);
+    single_tasklist_region[0].AddTask(none, StartTimestepReduction, pmesh);
+  }
+
   return tc;
 }
 
@@ -95,7 +95,7 @@ std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
       Metadata({Metadata::Cell, Metadata::Derived, Metadata::OneCopy}));
 
   pkg->CheckRefinementBlock = CheckRefinement;
-  pkg->EstimateTimestepMesh = EstimateTimestep;
+  pkg->EstimateTimestepMeshDevice = EstimateTimestep;
   pkg->FillDerivedMesh = FillDerived;
   return pkg;
 }
@@ -133,7 +133,7 @@ AmrTag CheckRefinement(MeshBlockData<Real> *rc) {
   return AmrTag::same;
 }
 
-Real EstimateTimestep(MeshData<Real> *md) {
+void EstimateTimestep(MeshData<Real> *md, parthenon::ParArray0D<Real> &dt) {
   std::shared_ptr<StateDescriptor> pkg =
       md->GetMeshPointer()->packages.Get("advection_package");
   const auto &cfl = pkg->Param<Real>("cfl");
@@ -148,23 +148,22 @@ Real EstimateTimestep(MeshData<Real> *md) {
   IndexRange jb = md->GetBoundsJ(IndexDomain::interior);
   IndexRange kb = md->GetBoundsK(IndexDomain::interior);
 
-  // This is obviously overkill for this constant velocity problem
-  Real min_dt;
+  // This is obviously overkill for this constant velocity problem. The minimum stays on
+  // device and is only brought to the host once for the whole mesh.
+  const Real fac = cfl / 2.0;
   parthenon::par_reduce(
       parthenon::loop_pattern_mdrange_tag, PARTHENON_AUTO_LABEL, DevExecSpace(), 0,
       pack.GetNBlocks() - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
       KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lmin_dt) {
         auto &coords = pack.GetCoordinates(b);
-        lmin_dt = std::min(
-            lmin_dt, parthenon::robust::ratio(coords.Dxc<X1DIR>(k, j, i), std::abs(vx)));
-        lmin_dt = std::min(
-            lmin_dt, parthenon::robust::ratio(coords.Dxc<X2DIR>(k, j, i), std::abs(vy)));
-        lmin_dt = std::min(
-            lmin_dt, parthenon::robust::ratio(coords.Dxc<X3DIR>(k, j, i), std::abs(vz)));
+        lmin_dt = std::min(lmin_dt, fac * parthenon::robust::ratio(
+                                              coords.Dxc<X1DIR>(k, j, i), std::abs(vx)));
+        lmin_dt = std::min(lmin_dt, fac * parthenon::robust::ratio(
+                                              coords.Dxc<X2DIR>(k, j, i), std::abs(vy)));
+        lmin_dt = std::min(lmin_dt, fac * parthenon::robust::ratio(
+                                              coords.Dxc<X3DIR>(k, j, i), std::abs(vz)));
       },
-      Kokkos::Min<Real>(min_dt));
-
-  return cfl * min_dt / 2.0;
+      Kokkos::Min<Real, parthenon::DevMemSpace>(dt.KokkosView()));
 }
 
 TaskStatus FillDerived(MeshData<Real> *md) {
@@ -48,7 +48,7 @@ VARIABLE(advection, divD);
 
 std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin);
 AmrTag CheckRefinement(MeshBlockData<Real> *rc);
-Real EstimateTimestep(MeshData<Real> *md);
+void EstimateTimestep(MeshData<Real> *md, parthenon::ParArray0D<Real> &dt);
 TaskStatus FillDerived(MeshData<Real> *md);
 
 template <class pack_desc_t>
@@ -208,6 +208,8 @@ void ProblemGenerator(MeshBlock *pmb, ParameterInput *pin) {
 }
 
 TaskStatus TransportParticles(MeshData<Real> *md, const StagedIntegrator *integrator) {
+  // The push dominates the cost of this example and scales with the number of particles
+  load_balance::CostTimer cost_timer(md, load_balance::CostWeight::particles);
   const auto swarm_name = "my_particles";
   const Real dt = integrator->dt;
 
@@ -275,10 +277,10 @@ TaskListStatus ParticleDriver::Step() {
   // Enforce fixed timestep
   integrator.dt = tm.dt;
 
-  status = MakeParticlesUpdateTaskCollection().Execute();
+  status = MakeParticlesUpdateTaskCollection().Execute(*pthread_pool);
 
   // Use a more traditional task list for predictable post-MPI evaluations.
-  status = MakeFinalizationTaskCollection().Execute();
+  status = MakeFinalizationTaskCollection().Execute(*pthread_pool);
 
   return status;
 }
@@ -475,14 +475,14 @@ TaskListStatus ParticleDriver::Step() {
   auto num_task_lists_executed_independently = blocks.size();
 
   // Create all the particles that will be created during the step
-  status = MakeParticlesCreationTaskCollection().Execute();
+  status = MakeParticlesCreationTaskCollection().Execute(*pthread_pool);
 
   // Loop over repeated MPI calls until every particle is finished. This logic is
   // required because long-distance particle pushes can lead to a large, unpredictable
   // number of MPI sends and receives.
   bool particles_update_done = false;
   while (!particles_update_done) {
-    status = MakeParticlesUpdateTaskCollection().Execute();
+    status = MakeParticlesUpdateTaskCollection().Execute(*pthread_pool);
 
     particles_update_done = true;
     for (auto &block : blocks) {
@@ -496,7 +496,7 @@ TaskListStatus ParticleDriver::Step() {
   }
 
   // Use a more traditional task list for predictable post-MPI evaluations.
-  status = MakeFinalizationTaskCollection().Execute();
+  status = MakeFinalizationTaskCollection().Execute(*pthread_pool);
 
   return status;
 }
@@ -12,9 +12,11 @@
 //========================================================================================
 #include "amr_criteria/amr_criteria.hpp"
 
+#include <algorithm>
 #include <memory>
 
 #include "amr_criteria/refinement_package.hpp"
+#include "interface/mesh_data.hpp"
 #include "interface/meshblock_data.hpp"
 #include "interface/variable.hpp"
 #include "mesh/mesh.hpp"
@@ -83,6 +85,28 @@ AMRBounds AMRCriteria::GetBounds(const MeshBlockData<Real> *rc) const {
   return AMRBounds(ib, jb, kb);
 }
 
+void AMRCriteria::operator()(MeshData<Real> *md, ParArray1D<AmrTag> &delta_levels) const {
+  auto delta_levels_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), delta_levels);
+  for (int b = 0; b < md->NumBlocks(); ++b) {
+    auto *rc = md->GetBlockData(b).get();
+    const AmrTag tag = LimitToMaxLevel((*this)(rc), rc->GetBlockPointer()->loc.level());
+    delta_levels_h(b) = std::max(delta_levels_h(b), tag);
+  }
+  Kokkos::deep_copy(delta_levels, delta_levels_h);
+}
+
+ParArray1D<bool> AMRCriteria::GetAtMaxLevel(MeshData<Real> *md) const {
+  // No block can be on a level beyond the maximum level of the mesh
+  if (max_level > md->GetMeshPointer()->GetMaxLevel()) return ParArray1D<bool>();
+  ParArray1D<bool> at_max_level("at_max_level", md->NumBlocks());
+  auto at_max_level_h = Kokkos::create_mirror_view(at_max_level);
+  for (int b = 0; b < md->NumBlocks(); ++b) {
+    at_max_level_h(b) = md->GetBlockData(b)->GetBlockPointer()->loc.level() >= max_level;
+  }
+  Kokkos::deep_copy(at_max_level, at_max_level_h);
+  return at_max_level;
+}
+
 AmrTag AMRFirstDerivative::operator()(const MeshBlockData<Real> *rc) const {
   if (!rc->HasVariable(field) || !rc->IsAllocated(field)) {
     return AmrTag::same;
@@ -103,4 +127,14 @@ AmrTag AMRSecondDerivative::operator()(const MeshBlockData<Real> *rc) const {
   return Refinement::SecondDerivative(bnds, q, refine_criteria, derefine_criteria);
 }
 
+void AMRFirstDerivative::operator()(MeshData<Real> *md,
+                                    ParArray1D<AmrTag> &delta_levels) const {
+  Refinement::FirstDerivative(*this, md, delta_levels);
+}
+
+void AMRSecondDerivative::operator()(MeshData<Real> *md,
+                                     ParArray1D<AmrTag> &delta_levels) const {
+  Refinement::SecondDerivative(*this, md, delta_levels);
+}
+
 } // namespace parthenon
@@ -18,12 +18,15 @@
 
 #include "defs.hpp"
 #include "mesh/domain.hpp"
+#include "parthenon_arrays.hpp"
 
 namespace parthenon {
 
 class ParameterInput;
 template <class>
 class MeshBlockData;
+template <class>
+class MeshData;
 
 struct AMRBounds {
   AMRBounds(const IndexRange &ib, const IndexRange &jb, const IndexRange &kb)
@@ -36,6 +39,10 @@ struct AMRCriteria {
   AMRCriteria(ParameterInput *pin, std::string &block_name);
   virtual ~AMRCriteria() {}
   virtual AmrTag operator()(const MeshBlockData<Real> *rc) const = 0;
+  // Raises delta_levels(b) to the tag recommended for block b of md. The default calls
+  // the per-block criterion on the host, criteria with a device implementation should
+  // override this to evaluate all blocks in a single kernel.
+  virtual void operator()(MeshData<Real> *md, ParArray1D<AmrTag> &delta_levels) const;
   std::string field;
   Real refine_criteria, derefine_criteria;
   int max_level;
@@ -43,18 +50,27 @@ struct AMRCriteria {
   static std::shared_ptr<AMRCriteria>
   MakeAMRCriteria(std::string &criteria, ParameterInput *pin, std::string &block_name);
   AMRBounds GetBounds(const MeshBlockData<Real> *rc) const;
+  // Adjusts a tag recommended for a block on the given level for max_level
+  AmrTag LimitToMaxLevel(AmrTag tag, int level) const {
+    return (tag == AmrTag::refine && level >= max_level) ? AmrTag::same : tag;
+  }
+  // Flags the blocks of md on which this criterion must not recommend refinement. Empty
+  // if max_level does not restrict any block beyond the limit of the mesh.
+  ParArray1D<bool> GetAtMaxLevel(MeshData<Real> *md) const;
 };
 
 struct AMRFirstDerivative : public AMRCriteria {
   AMRFirstDerivative(ParameterInput *pin, std::string &block_name)
       : AMRCriteria(pin, block_name) {}
   AmrTag operator()(const MeshBlockData<Real> *rc) const override;
+  void operator()(MeshData<Real> *md, ParArray1D<AmrTag> &delta_levels) const override;
 };
 
 struct AMRSecondDerivative : public AMRCriteria {
   AMRSecondDerivative(ParameterInput *pin, std::string &block_name)
       : AMRCriteria(pin, block_name) {}
   AmrTag operator()(const MeshBlockData<Real> *rc) const override;
+  void operator()(MeshData<Real> *md, ParArray1D<AmrTag> &delta_levels) const override;
 };
 
 } // namespace parthenon
@@ -17,10 +17,13 @@
 #include <exception>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "amr_criteria/amr_criteria.hpp"
+#include "interface/make_pack_descriptor.hpp"
 #include "interface/mesh_data.hpp"
 #include "interface/meshblock_data.hpp"
+#include "interface/sparse_pack.hpp"
 #include "interface/state_descriptor.hpp"
 #include "mesh/mesh.hpp"
 #include "mesh/mesh_refinement.hpp"
@@ -30,6 +33,141 @@
 namespace parthenon {
 namespace Refinement {
 
+namespace {
+// Relative first and second derivatives at a cell, maximized over directions
+struct FirstDerivativeOp {
+  template <typename View_t>
+  KOKKOS_INLINE_FUNCTION Real operator()(const View_t &q, const int ndim, const int k,
+                                         const int j, const int i) const {
+    Real scale = std::abs(q(k, j, i));
+    Real d = 0.5 * std::abs((q(k, j, i + 1) - q(k, j, i - 1))) / (scale + TINY_NUMBER);
+    Real maxd = d;
+    if (ndim > 1) {
+      d = 0.5 * std::abs((q(k, j + 1, i) - q(k, j - 1, i))) / (scale + TINY_NUMBER);
+      maxd = (d > maxd ? d : maxd);
+    }
+    if (ndim > 2) {
+      d = 0.5 * std::abs((q(k + 1, j, i) - q(k - 1, j, i))) / (scale + TINY_NUMBER);
+      maxd = (d > maxd ? d : maxd);
+    }
+    return maxd;
+  }
+};
+
+struct SecondDerivativeOp {
+  template <typename View_t>
+  KOKKOS_INLINE_FUNCTION Real operator()(const View_t &q, const int ndim, const int k,
+                                         const int j, const int i) const {
+    Real aqt = std::abs(q(k, j, i)) + TINY_NUMBER;
+    Real qavg = 0.5 * (q(k, j, i + 1) + q(k, j, i - 1));
+    Real d = std::abs(qavg - q(k, j, i)) / (std::abs(qavg) + aqt);
+    Real maxd = d;
+    if (ndim > 1) {
+      qavg = 0.5 * (q(k, j + 1, i) + q(k, j - 1, i));
+      d = std::abs(qavg - q(k, j, i)) / (std::abs(qavg) + aqt);
+      maxd = (d > maxd ? d : maxd);
+    }
+    if (ndim > 2) {
+      qavg = 0.5 * (q(k + 1, j, i) + q(k - 1, j, i));
+      d = std::abs(qavg - q(k, j, i)) / (std::abs(qavg) + aqt);
+      maxd = (d > maxd ? d : maxd);
+    }
+    return maxd;
+  }
+};
+
+KOKKOS_INLINE_FUNCTION
+AmrTag DerivativeTag(const Real maxd, const Real refine_criteria,
+                     const Real derefine_criteria) {
+  if (maxd > refine_criteria) return AmrTag::refine;
+  if (maxd < derefine_criteria) return AmrTag::derefine;
+  return AmrTag::same;
+}
+
+template <typename Op_t>
+AmrTag BlockDerivative(const AMRBounds &bnds, const ParArray3D<Real> &q,
+                       const Real refine_criteria, const Real derefine_criteria) {
+  const int ndim = 1 + (bnds.je > bnds.js) + (bnds.ke > bnds.ks);
+  Real maxd = 0.0;
+  par_reduce(
+      loop_pattern_mdrange_tag, PARTHENON_AUTO_LABEL, DevExecSpace(), bnds.ks, bnds.ke,
+      bnds.js, bnds.je, bnds.is, bnds.ie,
+      KOKKOS_LAMBDA(int k, int j, int i, Real &maxd) {
+        const Real d = Op_t()(q, ndim, k, j, i);
+        maxd = (d > maxd ? d : maxd);
+      },
+      Kokkos::Max<Real>(maxd));
+  return DerivativeTag(maxd, refine_criteria, derefine_criteria);
+}
+
+// One team per block reduces the derivative over the cells of the block, so that all
+// blocks of md are tagged by a single kernel without synchronizing with the host
+template <typename Op_t>
+void MeshDerivative(const AMRCriteria &crit, MeshData<Real> *md,
+                    ParArray1D<AmrTag> &delta_levels) {
+  const int nblocks = md->NumBlocks();
+  if (nblocks == 0) return;
+  const auto &field = crit.field;
+  const Real refine_criteria = crit.refine_criteria;
+  const Real derefine_criteria = crit.derefine_criteria;
+
+  // Like in the per-block criterion, blocks that do not have the field allocated are
+  // kept from derefining
+  auto pmbd = md->GetBlockData(0);
+  if (!pmbd->HasVariable(field)) {
+    parthenon::par_for(
+        DEFAULT_LOOP_PATTERN, PARTHENON_AUTO_LABEL, DevExecSpace(), 0, nblocks - 1,
+        KOKKOS_LAMBDA(const int b) {
+          if (delta_levels(b) < AmrTag::same) delta_levels(b) = AmrTag::same;
+        });
+    return;
+  }
+  const auto &var = pmbd->Get(field);
+  const int comp = (crit.comp6 * var.GetDim(5) + crit.comp5) * var.GetDim(4) + crit.comp4;
+
+  auto desc = MakePackDescriptor(md->GetMeshPointer()->resolved_packages.get(), {field});
+  auto pack = desc.GetPack(md);
+
+  const AMRBounds bnds(md->GetBoundsI(IndexDomain::interior),
+                       md->GetBoundsJ(IndexDomain::interior),
+                       md->GetBoundsK(IndexDomain::interior));
+  const int ndim = 1 + (bnds.je > bnds.js) + (bnds.ke > bnds.ks);
+  const int ks = bnds.ks, js = bnds.js, is = bnds.is;
+  const int nj = bnds.je - bnds.js + 1, ni = bnds.ie - bnds.is + 1;
+  const int ncells = (bnds.ke - bnds.ks + 1) * nj * ni;
+
+  auto at_max_level = crit.GetAtMaxLevel(md);
+  const bool check_level = at_max_level.size() > 0;
+
+  Kokkos::parallel_for(
+      PARTHENON_AUTO_LABEL,
+      Kokkos::TeamPolicy<>(parthenon::DevExecSpace(), nblocks, Kokkos::AUTO),
+      KOKKOS_LAMBDA(parthenon::team_mbr_t team_member) {
+        const int b = team_member.league_rank();
+        AmrTag tag = AmrTag::same;
+        if (pack.Contains(b)) {
+          const auto &q = pack(b, pack.GetLowerBound(b) + comp);
+          Real maxd = 0.0;
+          Kokkos::parallel_reduce(
+              Kokkos::TeamThreadRange<>(team_member, ncells),
+              [&](const int idx, Real &lmaxd) {
+                const int k = ks + idx / (nj * ni);
+                const int j = js + (idx / ni) % nj;
+                const int i = is + idx % ni;
+                const Real d = Op_t()(q, ndim, k, j, i);
+                lmaxd = (d > lmaxd ? d : lmaxd);
+              },
+              Kokkos::Max<Real, DevMemSpace>(maxd));
+          tag = DerivativeTag(maxd, refine_criteria, derefine_criteria);
+          if (check_level && tag == AmrTag::refine && at_max_level(b)) tag = AmrTag::same;
+        }
+        Kokkos::single(Kokkos::PerTeam(team_member), [&]() {
+          if (tag > delta_levels(b)) delta_levels(b) = tag;
+        });
+      });
+}
+} // namespace
+
 std::shared_ptr<StateDescriptor> Initialize(ParameterInput *pin) {
   auto ref = std::make_shared<StateDescriptor>("Refinement");
 
@@ -73,11 +211,8 @@ AmrTag CheckAllRefinement(MeshBlockData<Real> *rc) {
     // call parthenon criteria that were registered
     for (auto &amr : desc->amr_criteria) {
       // get the recommended change in refinement level from this criteria
-      AmrTag temp_delta = (*amr)(rc);
-      if ((temp_delta == AmrTag::refine) && pmb->loc.level() >= amr->max_level) {
-        // don't refine if we're at the max level
-        temp_delta = AmrTag::same;
-      }
+      // don't refine if we're at the max level
+      AmrTag temp_delta = amr->LimitToMaxLevel((*amr)(rc), pmb->loc.level());
       // maintain the max across all criteria
       delta_level = std::max(delta_level, temp_delta);
       if (delta_level == AmrTag::refine) {
@@ -92,61 +227,59 @@ AmrTag CheckAllRefinement(MeshBlockData<Real> *rc) {
 AmrTag FirstDerivative(const AMRBounds &bnds, const ParArray3D<Real> &q,
                        const Real refine_criteria, const Real derefine_criteria) {
   PARTHENON_INSTRUMENT
-  const int ndim = 1 + (bnds.je > bnds.js) + (bnds.ke > bnds.ks);
-  Real maxd = 0.0;
-  par_reduce(
-      loop_pattern_mdrange_tag, PARTHENON_AUTO_LABEL, DevExecSpace(), bnds.ks, bnds.ke,
-      bnds.js, bnds.je, bnds.is, bnds.ie,
-      KOKKOS_LAMBDA(int k, int j, int i, Real &maxd) {
-        Real scale = std::abs(q(k, j, i));
-        Real d =
-            0.5 * std::abs((q(k, j, i + 1) - q(k, j, i - 1))) / (scale + TINY_NUMBER);
-        maxd = (d > maxd ? d : maxd);
-        if (ndim > 1) {
-          d = 0.5 * std::abs((q(k, j + 1, i) - q(k, j - 1, i))) / (scale + TINY_NUMBER);
-          maxd = (d > maxd ? d : maxd);
-        }
-        if (ndim > 2) {
-          d = 0.5 * std::abs((q(k + 1, j, i) - q(k - 1, j, i))) / (scale + TINY_NUMBER);
-          maxd = (d > maxd ? d : maxd);
-        }
-      },
-      Kokkos::Max<Real>(maxd));
-
-  if (maxd > refine_criteria) return AmrTag::refine;
-  if (maxd < derefine_criteria) return AmrTag::derefine;
-  return AmrTag::same;
+  return BlockDerivative<FirstDerivativeOp>(bnds, q, refine_criteria, derefine_criteria);
 }
 
 AmrTag SecondDerivative(const AMRBounds &bnds, const ParArray3D<Real> &q,
                         const Real refine_criteria, const Real derefine_criteria) {
   PARTHENON_INSTRUMENT
-  const int ndim = 1 + (bnds.je > bnds.js) + (bnds.ke > bnds.ks);
-  Real maxd = 0.0;
-  par_reduce(
-      loop_pattern_mdrange_tag, PARTHENON_AUTO_LABEL, DevExecSpace(), bnds.ks, bnds.ke,
-      bnds.js, bnds.je, bnds.is, bnds.ie,
-      KOKKOS_LAMBDA(int k, int j, int i, Real &maxd) {
-        Real aqt = std::abs(q(k, j, i)) + TINY_NUMBER;
-        Real qavg = 0.5 * (q(k, j, i + 1) + q(k, j, i - 1));
-        Real d = std::abs(qavg - q(k, j, i)) / (std::abs(qavg) + aqt);
-        maxd = (d > maxd ? d : maxd);
-        if (ndim > 1) {
-          qavg = 0.5 * (q(k, j + 1, i) + q(k, j - 1, i));
-          d = std::abs(qavg - q(k, j, i)) / (std::abs(qavg) + aqt);
-          maxd = (d > maxd ? d : maxd);
-        }
-        if (ndim > 2) {
-          qavg = 0.5 * (q(k + 1, j, i) + q(k - 1, j, i));
-          d = std::abs(qavg - q(k, j, i)) / (std::abs(qavg) + aqt);
-          maxd = (d > maxd ? d : maxd);
-        }
-      },
-      Kokkos::Max<Real>(maxd));
+  return BlockDerivative<SecondDerivativeOp>(bnds, q, refine_criteria, derefine_criteria);
+}
 
-  if (maxd > refine_criteria) return AmrTag::refine;
-  if (maxd < derefine_criteria) return AmrTag::derefine;
-  return AmrTag::same;
+void FirstDerivative(const AMRCriteria &crit, MeshData<Real> *md,
+                     ParArray1D<AmrTag> &delta_levels) {
+  PARTHENON_INSTRUMENT
+  MeshDerivative<FirstDerivativeOp>(crit, md, delta_levels);
+}
+
+void SecondDerivative(const AMRCriteria &crit, MeshData<Real> *md,
+                      ParArray1D<AmrTag> &delta_levels) {
+  PARTHENON_INSTRUMENT
+  MeshDerivative<SecondDerivativeOp>(crit, md, delta_levels);
+}
+
+void CheckAllRefinement(MeshData<Real> *md, ParArray1D<AmrTag> &delta_levels) {
+  // Same as the per-block version above, but all blocks are checked at once and the
+  // built-in criteria run on the device
+  PARTHENON_INSTRUMENT
+  const int nblocks = md->NumBlocks();
+  Kokkos::deep_copy(delta_levels, AmrTag::derefine);
+  // Packages that only provide a per-block check are evaluated on the host
+  std::vector<AmrTag> block_tags;
+  for (auto &pkg : md->GetMeshPointer()->packages.AllPackages()) {
+    auto &desc = pkg.second;
+    if (desc->CheckRefinementMesh != nullptr) {
+      desc->CheckRefinement(md, delta_levels);
+    } else if (desc->CheckRefinementBlock != nullptr) {
+      block_tags.resize(nblocks, AmrTag::derefine);
+      for (int b = 0; b < nblocks; ++b) {
+        block_tags[b] =
+            std::max(block_tags[b], desc->CheckRefinement(md->GetBlockData(b).get()));
+      }
+    }
+    // call parthenon criteria that were registered
+    for (auto &amr : desc->amr_criteria) {
+      (*amr)(md, delta_levels);
+    }
+  }
+  if (!block_tags.empty()) {
+    auto delta_levels_h =
+        Kokkos::create_mirror_view_and_copy(HostMemSpace(), delta_levels);
+    for (int b = 0; b < nblocks; ++b) {
+      delta_levels_h(b) = std::max(delta_levels_h(b), block_tags[b]);
+    }
+    Kokkos::deep_copy(delta_levels, delta_levels_h);
+  }
 }
 
 void SetRefinement_(MeshBlockData<Real> *rc) {
@@ -164,8 +297,12 @@ TaskStatus Tag(MeshBlockData<Real> *rc) {
 template <>
 TaskStatus Tag(MeshData<Real> *rc) {
   PARTHENON_INSTRUMENT
+  ParArray1D<AmrTag> delta_levels("delta_levels", rc->NumBlocks());
+  CheckAllRefinement(rc, delta_levels);
+  // the tags of all blocks are brought back to the host at once
+  auto delta_levels_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), delta_levels);
   for (int i = 0; i < rc->NumBlocks(); i++) {
-    SetRefinement_(rc->GetBlockData(i).get());
+    rc->GetBlockData(i)->GetBlockPointer()->pmr->SetRefinement(delta_levels_h(i));
   }
   return TaskStatus::complete;
 }
@@ -30,6 +30,7 @@ template <typename T>
 class MeshData;
 class StateDescriptor;
 class AMRBounds;
+struct AMRCriteria;
 
 namespace Refinement {
 
@@ -38,6 +39,9 @@ template <typename T>
 TaskStatus Tag(T *rc);
 
 AmrTag CheckAllRefinement(MeshBlockData<Real> *rc);
+// Sets delta_levels(b) to the maximum recommended change in refinement level over all
+// criteria for block b of md
+void CheckAllRefinement(MeshData<Real> *md, ParArray1D<AmrTag> &delta_levels);
 
 AmrTag FirstDerivative(const AMRBounds &bnds, const ParArray3D<Real> &q,
                        const Real refine_criteria, const Real derefine_criteria);
@@ -45,6 +49,13 @@ AmrTag FirstDerivative(const AMRBounds &bnds, const ParArray3D<Real> &q,
 AmrTag SecondDerivative(const AMRBounds &bnds, const ParArray3D<Real> &q,
                         const Real refine_criteria, const Real derefine_criteria);
 
+// Evaluate a derivative criterion on all blocks of md in a single kernel, raising
+// delta_levels(b) to the tag recommended for block b
+void FirstDerivative(const AMRCriteria &crit, MeshData<Real> *md,
+                     ParArray1D<AmrTag> &delta_levels);
+void SecondDerivative(const AMRCriteria &crit, MeshData<Real> *md,
+                      ParArray1D<AmrTag> &delta_levels);
+
 } // namespace Refinement
 
 } // namespace parthenon
@@ -22,6 +22,7 @@
 #include "bvals/boundary_conditions.hpp"
 #include "defs.hpp"
 #include "interface/state_descriptor.hpp"
+#include "mesh/load_balance.hpp"
 #include "outputs/output_parameters.hpp"
 #include "parameter_input.hpp"
 #include "parthenon_arrays.hpp"
@@ -57,6 +58,8 @@ struct ApplicationInput {
 
   std::function<void(Mesh *, ParameterInput *, SimTime &)> UserWorkAfterLoop = nullptr;
   std::function<void(Mesh *, ParameterInput *, SimTime &)> UserWorkBeforeLoop = nullptr;
+  // Overrides <parthenon/loadbalancing>/partitioner, see load_balance.hpp
+  load_balance::PartitionFn_t PartitionMeshBlocks = nullptr;
   BValFunc boundary_conditions[BOUNDARY_NFACES] = {nullptr};
   SBValFunc swarm_boundary_conditions[BOUNDARY_NFACES] = {nullptr};
 
@@ -11,7 +11,9 @@
 // the public, perform publicly and display publicly, and to permit others to do so.
 //========================================================================================
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "bvals/boundary_conditions.hpp"
@@ -31,30 +33,43 @@ bool DoPhysicalBoundary_(const BoundaryFlag flag, const BoundaryFace face,
                          const int ndim);
 bool DoPhysicalSwarmBoundary_(const BoundaryFlag flag, const BoundaryFace face,
                               const int ndim);
+bool IsFusedBoundary_(const BoundaryFlag flag);
+void BuildPhysicalBndCache_(MeshData<Real> *md, PhysicalBndCache_t &cache);
+void ApplyFusedBoundaryConditions_(MeshData<Real> *md, const PhysicalBndCache_t &cache,
+                                   int dir, bool coarse);
+void ApplyUnfusedBoundaryConditions_(std::shared_ptr<MeshBlockData<Real>> &rc,
+                                     BoundaryFace face, bool coarse);
+
+// Applies the physical boundary conditions on face i of a block. If fused is true, the
+// built-in conditions on cell-centered variables have already been applied by the fused
+// kernel and only the remaining variables are treated here.
+void ApplyFaceBoundaryConditions_(std::shared_ptr<MeshBlockData<Real>> &rc, int i,
+                                  bool coarse, bool fused) {
+  MeshBlock *pmb = rc->GetBlockPointer();
+  Mesh *pmesh = pmb->pmy_mesh;
+  if (!DoPhysicalBoundary_(pmb->boundary_flag[i], static_cast<BoundaryFace>(i),
+                           pmesh->ndim))
+    return;
+
+  auto *tree = pmesh->forest.GetTreePtr(pmb->loc.tree()).get();
+  if (fused && IsFusedBoundary_(tree->boundary_conditions[i])) {
+    ApplyUnfusedBoundaryConditions_(rc, static_cast<BoundaryFace>(i), coarse);
+  } else {
+    PARTHENON_DEBUG_REQUIRE(tree->MeshBndryFnctn[i] != nullptr,
+                            "boundary function must not be null");
+    tree->MeshBndryFnctn[i](rc, coarse);
+  }
+  for (auto &bnd_func : tree->UserBoundaryFunctions[i]) {
+    bnd_func(rc, coarse);
+  }
+}
 } // namespace boundary_cond_impl
 
 TaskStatus ApplyBoundaryConditionsOnCoarseOrFine(std::shared_ptr<MeshBlockData<Real>> &rc,
                                                  bool coarse) {
   PARTHENON_INSTRUMENT
-  using namespace boundary_cond_impl;
-  MeshBlock *pmb = rc->GetBlockPointer();
-  Mesh *pmesh = pmb->pmy_mesh;
-  const int ndim = pmesh->ndim;
-
-  auto &tree_bnd_func = pmesh->forest.GetTreePtr(pmb->loc.tree())->MeshBndryFnctn;
-  auto &tree_bnd_func_user =
-      pmesh->forest.GetTreePtr(pmb->loc.tree())->UserBoundaryFunctions;
-  for (int i = 0; i < BOUNDARY_NFACES; i++) {
-    if (DoPhysicalBoundary_(pmb->boundary_flag[i], static_cast<BoundaryFace>(i), ndim)) {
-      PARTHENON_DEBUG_REQUIRE(tree_bnd_func[i] != nullptr,
-                              "boundary function must not be null");
-      tree_bnd_func[i](rc, coarse);
-      for (auto &bnd_func : tree_bnd_func_user[i]) {
-        bnd_func(rc, coarse);
-      }
-    }
-  }
-
+  for (int i = 0; i < BOUNDARY_NFACES; i++)
+    boundary_cond_impl::ApplyFaceBoundaryConditions_(rc, i, coarse, false);
   return TaskStatus::complete;
 }
 
@@ -81,15 +96,28 @@ TaskStatus ApplySwarmBoundaryConditions(std::shared_ptr<Swarm> &swarm) {
 }
 
 TaskStatus ApplyBoundaryConditionsMD(std::shared_ptr<MeshData<Real>> &pmd) {
-  for (int b = 0; b < pmd->NumBlocks(); ++b)
-    ApplyBoundaryConditions(pmd->GetBlockData(b));
-  return TaskStatus::complete;
+  return ApplyBoundaryConditionsOnCoarseOrFineMD(pmd, false);
 }
 
 TaskStatus ApplyBoundaryConditionsOnCoarseOrFineMD(std::shared_ptr<MeshData<Real>> &pmd,
                                                    bool coarse) {
-  for (int b = 0; b < pmd->NumBlocks(); ++b)
-    ApplyBoundaryConditionsOnCoarseOrFine(pmd->GetBlockData(b), coarse);
+  PARTHENON_INSTRUMENT
+  using namespace boundary_cond_impl;
+  if (pmd->NumBlocks() == 0) return TaskStatus::complete;
+  const bool fused = pmd->GetMeshPointer()->FusedPhysicalBoundaries();
+  auto &cache = pmd->GetBvarsCache().physical_bnd;
+  if (fused) BuildPhysicalBndCache_(pmd.get(), cache);
+  // Ghost zones of different directions overlap at edges and corners, so directions
+  // are treated one after the other as in the per-block path. Within a direction, the
+  // built-in conditions on cell-centered variables of all blocks are applied in a
+  // single kernel, everything else (including user conditions) block by block.
+  for (int dir = 0; dir < 3; ++dir) {
+    if (fused) ApplyFusedBoundaryConditions_(pmd.get(), cache, dir, coarse);
+    for (int b = 0; b < pmd->NumBlocks(); ++b) {
+      for (int i = 2 * dir; i < 2 * dir + 2; ++i)
+        ApplyFaceBoundaryConditions_(pmd->GetBlockData(b), i, coarse, fused);
+    }
+  }
   return TaskStatus::complete;
 }
 
@@ -218,6 +246,158 @@ bool DoPhysicalSwarmBoundary_(const BoundaryFlag flag, const BoundaryFace face,
   return true; // outflow, periodic, user, dims (particles always 3D) correct
 }
 
+// Ghost zones of a face and the index of the interior cell next to them
+struct FaceBounds {
+  IndexRange ib, jb, kb;
+  int ref;
+};
+
+bool IsFusedBoundary_(const BoundaryFlag flag) {
+  return flag == BoundaryFlag::outflow || flag == BoundaryFlag::reflect;
+}
+
+void BuildPhysicalBndCache_(MeshData<Real> *md, PhysicalBndCache_t &cache) {
+  const int nblocks = md->NumBlocks();
+  std::vector<int> gids(nblocks);
+  for (int b = 0; b < nblocks; ++b)
+    gids[b] = md->GetBlockData(b)->GetBlockPointer()->gid;
+  if (gids == cache.gids && cache.faces.KokkosView().is_allocated()) return;
+
+  // Faces are sorted by direction, so that each direction can be treated separately
+  std::vector<PhysicalBndFace> faces;
+  cache.dir_offsets[0] = 0;
+  for (int dir = 0; dir < 3; ++dir) {
+    for (int b = 0; b < nblocks; ++b) {
+      MeshBlock *pmb = md->GetBlockData(b)->GetBlockPointer();
+      Mesh *pmesh = pmb->pmy_mesh;
+      auto &tree = pmesh->forest.GetTreePtr(pmb->loc.tree());
+      for (int f = 2 * dir; f < 2 * dir + 2; ++f) {
+        const auto flag = tree->boundary_conditions[f];
+        if (DoPhysicalBoundary_(pmb->boundary_flag[f], static_cast<BoundaryFace>(f),
+                                pmesh->ndim) &&
+            IsFusedBoundary_(flag)) {
+          faces.push_back({b, f, flag == BoundaryFlag::reflect});
+        }
+      }
+    }
+    cache.dir_offsets[dir + 1] = faces.size();
+  }
+
+  cache.gids = std::move(gids);
+  cache.nfaces = faces.size();
+  cache.faces = ParArray1D<PhysicalBndFace>("physical boundary faces",
+                                            std::max(cache.nfaces, 1));
+  auto faces_h = cache.faces.GetHostMirror();
+  for (int n = 0; n < cache.nfaces; ++n)
+    faces_h(n) = faces[n];
+  cache.faces.DeepCopy(faces_h);
+}
+
+// Applies the built-in conditions on cell-centered variables to the faces of all blocks
+// in direction dir (0, 1 or 2)
+void ApplyFusedBoundaryConditions_(MeshData<Real> *md, const PhysicalBndCache_t &cache,
+                                   int dir, bool coarse) {
+  const int nstart = cache.dir_offsets[dir];
+  const int nend = cache.dir_offsets[dir + 1] - 1;
+  if (nend < nstart) return;
+  using TE = TopologicalElement;
+  const std::vector<MetadataFlag> flags{Metadata::FillGhost, Metadata::Cell};
+  static auto desc = MakePackDescriptor<variable_names::any>(md, flags);
+  static auto desc_coarse =
+      MakePackDescriptor<variable_names::any>(md, flags, {PDOpt::Coarse});
+  auto q = (coarse ? desc_coarse : desc).GetPack(md, false);
+
+  // All blocks share the same index shape, so the ghost zones of each face and the
+  // interior cell they are filled from are the same for every block
+  MeshBlock *pmb = md->GetBlockData(0)->GetBlockPointer();
+  const auto &bounds = coarse ? pmb->c_cellbounds : pmb->cellbounds;
+  constexpr IndexDomain domains[BOUNDARY_NFACES] = {
+      IndexDomain::inner_x1, IndexDomain::outer_x1, IndexDomain::inner_x2,
+      IndexDomain::outer_x2, IndexDomain::inner_x3, IndexDomain::outer_x3};
+  Kokkos::Array<FaceBounds, BOUNDARY_NFACES> face_bounds;
+  for (int f = 0; f < BOUNDARY_NFACES; ++f) {
+    auto &fb = face_bounds[f];
+    fb.ib = bounds.GetBoundsI(domains[f], TE::CC);
+    fb.jb = bounds.GetBoundsJ(domains[f], TE::CC);
+    fb.kb = bounds.GetBoundsK(domains[f], TE::CC);
+    const auto &range = (f / 2 == 0)   ? bounds.GetBoundsI(IndexDomain::interior)
+                        : (f / 2 == 1) ? bounds.GetBoundsJ(IndexDomain::interior)
+                                       : bounds.GetBoundsK(IndexDomain::interior);
+    fb.ref = (f % 2 == 0) ? range.s : range.e;
+  }
+
+  auto faces = cache.faces;
+  const int scratch_size = 0;
+  const int scratch_level = 0;
+  parthenon::par_for_outer(
+      DEFAULT_OUTER_LOOP_PATTERN, "ApplyFusedBoundaryConditions", DevExecSpace(),
+      scratch_size, scratch_level, nstart, nend,
+      KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int n) {
+        const PhysicalBndFace face = faces(n);
+        const FaceBounds &fb = face_bounds[face.face];
+        const int b = face.block;
+        const int lstart = q.GetLowerBound(b);
+        const int lend = q.GetUpperBound(b);
+        if (lend < lstart) return;
+        const int face_dir = face.face / 2 + 1;
+        const bool X1 = (face_dir == X1DIR);
+        const bool X2 = (face_dir == X2DIR);
+        const bool X3 = (face_dir == X3DIR);
+        const bool reflect = face.reflect;
+        const int ref = fb.ref;
+        // used for reflections
+        const int offset = 2 * ref + (face.face % 2 == 0 ? -1 : 1);
+        parthenon::par_for_inner(
+            DEFAULT_INNER_LOOP_PATTERN, member, lstart, lend, fb.kb.s, fb.kb.e, fb.jb.s,
+            fb.jb.e, fb.ib.s, fb.ib.e,
+            [&](const int l, const int k, const int j, const int i) {
+              const int ksrc = X3 ? (reflect ? offset - k : ref) : k;
+              const int jsrc = X2 ? (reflect ? offset - j : ref) : j;
+              const int isrc = X1 ? (reflect ? offset - i : ref) : i;
+              const bool flip = reflect && (q(b, TE::CC, l).vector_component == face_dir);
+              q(b, TE::CC, l, k, j, i) =
+                  (flip ? -1.0 : 1.0) * q(b, TE::CC, l, ksrc, jsrc, isrc);
+            });
+      });
+}
+
+template <CoordinateDirection DIR, BoundaryFunction::BCSide SIDE,
+          BoundaryFunction::BCType TYPE>
+void UnfusedBC(std::shared_ptr<MeshBlockData<Real>> &rc, bool coarse) {
+  using namespace BoundaryFunction;
+  using TE = TopologicalElement;
+  GenericBC<DIR, SIDE, TYPE, variable_names::any>(rc, coarse, TE::CC, true, 0.0);
+  for (auto el : {TE::F1, TE::F2, TE::F3, TE::E1, TE::E2, TE::E3, TE::NN})
+    GenericBC<DIR, SIDE, TYPE, variable_names::any>(rc, coarse, el, 0.0);
+}
+
+// The part of the built-in conditions not covered by ApplyFusedBoundaryConditions_,
+// i.e. fine cell-centered variables and variables on faces, edges and nodes
+void ApplyUnfusedBoundaryConditions_(std::shared_ptr<MeshBlockData<Real>> &rc,
+                                     BoundaryFace face, bool coarse) {
+  using BoundaryFunction::BCSide;
+  using BoundaryFunction::BCType;
+  using BValFunc_t = void (*)(std::shared_ptr<MeshBlockData<Real>> &, bool);
+  static const BValFunc_t outflow[BOUNDARY_NFACES] = {
+      UnfusedBC<X1DIR, BCSide::Inner, BCType::Outflow>,
+      UnfusedBC<X1DIR, BCSide::Outer, BCType::Outflow>,
+      UnfusedBC<X2DIR, BCSide::Inner, BCType::Outflow>,
+      UnfusedBC<X2DIR, BCSide::Outer, BCType::Outflow>,
+      UnfusedBC<X3DIR, BCSide::Inner, BCType::Outflow>,
+      UnfusedBC<X3DIR, BCSide::Outer, BCType::Outflow>};
+  static const BValFunc_t reflect[BOUNDARY_NFACES] = {
+      UnfusedBC<X1DIR, BCSide::Inner, BCType::Reflect>,
+      UnfusedBC<X1DIR, BCSide::Outer, BCType::Reflect>,
+      UnfusedBC<X2DIR, BCSide::Inner, BCType::Reflect>,
+      UnfusedBC<X2DIR, BCSide::Outer, BCType::Reflect>,
+      UnfusedBC<X3DIR, BCSide::Inner, BCType::Reflect>,
+      UnfusedBC<X3DIR, BCSide::Outer, BCType::Reflect>};
+  MeshBlock *pmb = rc->GetBlockPointer();
+  const auto flag =
+      pmb->pmy_mesh->forest.GetTreePtr(pmb->loc.tree())->boundary_conditions[face];
+  (flag == BoundaryFlag::reflect ? reflect : outflow)[face](rc, coarse);
+}
+
 } // namespace boundary_cond_impl
 
 } // namespace parthenon
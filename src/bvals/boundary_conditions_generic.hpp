@@ -173,7 +173,7 @@ GetPackDescriptorMap(std::shared_ptr<MeshBlockData<Real>> &rc) {
 
 template <CoordinateDirection DIR, BCSide SIDE, BCType TYPE, class... var_ts>
 void GenericBC(std::shared_ptr<MeshBlockData<Real>> &rc, bool coarse,
-               TopologicalElement el, Real val) {
+               TopologicalElement el, bool fine, Real val) {
   // make sure DIR is X[123]DIR so we don't have to check again
   static_assert(DIR == X1DIR || DIR == X2DIR || DIR == X3DIR, "DIR must be X[123]DIR");
 
@@ -184,74 +184,79 @@ void GenericBC(std::shared_ptr<MeshBlockData<Real>> &rc, bool coarse,
   constexpr bool INNER = (SIDE == BCSide::Inner);
 
   static auto descriptors = impl::GetPackDescriptorMap<var_ts...>(rc);
-  for (auto fine : {false, true}) {
-    auto q = descriptors[impl::desc_key_t{coarse, fine, GetTopologicalType(el)}].GetPack(
-        rc.get());
-    const int b = 0;
-    const int lstart = q.GetLowerBoundHost(b);
-    const int lend = q.GetUpperBoundHost(b);
-    if (lend < lstart) return;
-    auto nb = IndexRange{lstart, lend};
+  const impl::desc_key_t key{coarse, fine, GetTopologicalType(el)};
+  auto q = descriptors[key].GetPack(rc.get());
+  const int b = 0;
+  const int lstart = q.GetLowerBoundHost(b);
+  const int lend = q.GetUpperBoundHost(b);
+  if (lend < lstart) return;
+  auto nb = IndexRange{lstart, lend};
 
-    MeshBlock *pmb = rc->GetBlockPointer();
-    const auto &bounds = fine ? (coarse ? pmb->cellbounds : pmb->f_cellbounds)
-                              : (coarse ? pmb->c_cellbounds : pmb->cellbounds);
+  MeshBlock *pmb = rc->GetBlockPointer();
+  const auto &bounds = fine ? (coarse ? pmb->cellbounds : pmb->f_cellbounds)
+                            : (coarse ? pmb->c_cellbounds : pmb->cellbounds);
 
-    const auto &range = X1 ? bounds.GetBoundsI(IndexDomain::interior, el)
-                           : (X2 ? bounds.GetBoundsJ(IndexDomain::interior, el)
-                                 : bounds.GetBoundsK(IndexDomain::interior, el));
-    const int ref = INNER ? range.s : range.e;
+  const auto &range = X1 ? bounds.GetBoundsI(IndexDomain::interior, el)
+                         : (X2 ? bounds.GetBoundsJ(IndexDomain::interior, el)
+                               : bounds.GetBoundsK(IndexDomain::interior, el));
+  const int ref = INNER ? range.s : range.e;
 
-    std::string label = (TYPE == BCType::Reflect ? "Reflect" : "Outflow");
-    label += (INNER ? "Inner" : "Outer");
-    label += "X" + std::to_string(DIR);
+  std::string label = (TYPE == BCType::Reflect ? "Reflect" : "Outflow");
+  label += (INNER ? "Inner" : "Outer");
+  label += "X" + std::to_string(DIR);
 
-    constexpr IndexDomain domain =
-        INNER ? (X1 ? IndexDomain::inner_x1
-                    : (X2 ? IndexDomain::inner_x2 : IndexDomain::inner_x3))
-              : (X1 ? IndexDomain::outer_x1
-                    : (X2 ? IndexDomain::outer_x2 : IndexDomain::outer_x3));
+  constexpr IndexDomain domain =
+      INNER ? (X1 ? IndexDomain::inner_x1
+                  : (X2 ? IndexDomain::inner_x2 : IndexDomain::inner_x3))
+            : (X1 ? IndexDomain::outer_x1
+                  : (X2 ? IndexDomain::outer_x2 : IndexDomain::outer_x3));
 
-    // used for reflections
-    const int offset = 2 * ref + (INNER ? -1 : 1);
+  // used for reflections
+  const int offset = 2 * ref + (INNER ? -1 : 1);
 
-    // used for derivatives
-    const int offsetin = INNER;
-    const int offsetout = !INNER;
-    pmb->par_for_bndry(
-        PARTHENON_AUTO_LABEL, nb, domain, el, coarse, fine,
-        KOKKOS_LAMBDA(const int &l, const int &k, const int &j, const int &i) {
-          if (TYPE == BCType::Reflect) {
-            const bool reflect = (q(b, el, l).vector_component == DIR);
-            q(b, el, l, k, j, i) =
-                (reflect ? -1.0 : 1.0) * q(b, el, l, X3 ? offset - k : k,
-                                           X2 ? offset - j : j, X1 ? offset - i : i);
-          } else if (TYPE == BCType::FixedFace) {
-            q(b, el, l, k, j, i) =
-                2.0 * val - q(b, el, l, X3 ? offset - k : k, X2 ? offset - j : j,
-                              X1 ? offset - i : i);
-          } else if (TYPE == BCType::ConstantDeriv) {
-            Real dq = q(b, el, l, X3 ? ref + offsetin : k, X2 ? ref + offsetin : j,
-                        X1 ? ref + offsetin : i) -
-                      q(b, el, l, X3 ? ref - offsetout : k, X2 ? ref - offsetout : j,
-                        X1 ? ref - offsetout : i);
-            Real delta = 0.0;
-            if (X1) {
-              delta = i - ref;
-            } else if (X2) {
-              delta = j - ref;
-            } else {
-              delta = k - ref;
-            }
-            q(b, el, l, k, j, i) =
-                q(b, el, l, X3 ? ref : k, X2 ? ref : j, X1 ? ref : i) + delta * dq;
-          } else if (TYPE == BCType::Fixed) {
-            q(b, el, l, k, j, i) = val;
+  // used for derivatives
+  const int offsetin = INNER;
+  const int offsetout = !INNER;
+  pmb->par_for_bndry(
+      PARTHENON_AUTO_LABEL, nb, domain, el, coarse, fine,
+      KOKKOS_LAMBDA(const int &l, const int &k, const int &j, const int &i) {
+        if (TYPE == BCType::Reflect) {
+          const bool reflect = (q(b, el, l).vector_component == DIR);
+          q(b, el, l, k, j, i) =
+              (reflect ? -1.0 : 1.0) * q(b, el, l, X3 ? offset - k : k,
+                                         X2 ? offset - j : j, X1 ? offset - i : i);
+        } else if (TYPE == BCType::FixedFace) {
+          q(b, el, l, k, j, i) =
+              2.0 * val - q(b, el, l, X3 ? offset - k : k, X2 ? offset - j : j,
+                            X1 ? offset - i : i);
+        } else if (TYPE == BCType::ConstantDeriv) {
+          Real dq = q(b, el, l, X3 ? ref + offsetin : k, X2 ? ref + offsetin : j,
+                      X1 ? ref + offsetin : i) -
+                    q(b, el, l, X3 ? ref - offsetout : k, X2 ? ref - offsetout : j,
+                      X1 ? ref - offsetout : i);
+          Real delta = 0.0;
+          if (X1) {
+            delta = i - ref;
+          } else if (X2) {
+            delta = j - ref;
           } else {
-            q(b, el, l, k, j, i) = q(b, el, l, X3 ? ref : k, X2 ? ref : j, X1 ? ref : i);
+            delta = k - ref;
           }
-        });
-  }
+          q(b, el, l, k, j, i) =
+              q(b, el, l, X3 ? ref : k, X2 ? ref : j, X1 ? ref : i) + delta * dq;
+        } else if (TYPE == BCType::Fixed) {
+          q(b, el, l, k, j, i) = val;
+        } else {
+          q(b, el, l, k, j, i) = q(b, el, l, X3 ? ref : k, X2 ? ref : j, X1 ? ref : i);
+        }
+      });
+}
+
+template <CoordinateDirection DIR, BCSide SIDE, BCType TYPE, class... var_ts>
+void GenericBC(std::shared_ptr<MeshBlockData<Real>> &rc, bool coarse,
+               TopologicalElement el, Real val) {
+  for (auto fine : {false, true})
+    GenericBC<DIR, SIDE, TYPE, var_ts...>(rc, coarse, el, fine, val);
 }
 
 template <CoordinateDirection DIR, BCSide SIDE, BCType TYPE, class... var_ts>
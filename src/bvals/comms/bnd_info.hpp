@@ -18,11 +18,13 @@
 #ifndef BVALS_COMMS_BND_INFO_HPP_
 #define BVALS_COMMS_BND_INFO_HPP_
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "basic_types.hpp"
+#include "bvals/comms/message_aggregation.hpp"
 #include "bvals/neighbor_block.hpp"
 #include "coordinates/coordinates.hpp"
 #include "interface/variable_state.hpp"
@@ -172,6 +174,7 @@ struct BvarsSubCache_t {
     bnd_info = BndInfoArr_t{};
     bnd_info_h = BndInfoArr_t::host_mirror_type{};
     prores_cache.clear();
+    agg_send.clear();
   }
   // Stores prolongation and restriction information for boundary regions
   ProResCache_t prores_cache;
@@ -185,10 +188,41 @@ struct BvarsSubCache_t {
 
   BndInfoArr_t bnd_info{};
   BndInfoArr_t::host_mirror_type bnd_info_h{};
+
+  // One entry per destination rank if boundary messages are aggregated
+  std::vector<std::shared_ptr<AggregatedSend>> agg_send;
+};
+
+// A block face of a MeshData object on which a built-in (outflow or reflecting) physical
+// boundary condition is applied
+struct PhysicalBndFace {
+  int block;
+  int face;
+  bool reflect;
+};
+
+// The faces to which ApplyBoundaryConditionsOnCoarseOrFineMD applies the built-in
+// boundary conditions in one kernel launch per direction. Rebuilt whenever the blocks
+// change.
+struct PhysicalBndCache_t {
+  void clear() {
+    gids.clear();
+    faces = ParArray1D<PhysicalBndFace>{};
+    nfaces = 0;
+    dir_offsets = {0, 0, 0, 0};
+  }
+  // Global ids of the blocks the list of faces was built for
+  std::vector<int> gids;
+  // Faces sorted by direction, those in direction d are [dir_offsets[d],
+  // dir_offsets[d + 1])
+  ParArray1D<PhysicalBndFace> faces;
+  std::array<int, 4> dir_offsets{0, 0, 0, 0};
+  int nfaces = 0;
 };
 
 struct BvarsCache_t {
   std::array<BvarsSubCache_t, NUM_BNDRY_TYPES * 2> caches;
+  PhysicalBndCache_t physical_bnd;
   auto &GetSubCache(BoundaryType boundType, bool send) {
     return caches[2 * static_cast<int>(boundType) + send];
   }
@@ -197,6 +231,7 @@ struct BvarsCache_t {
   void clear() {
     for (int i = 0; i < caches.size(); ++i)
       caches[i].clear();
+    physical_bnd.clear();
   }
 };
 
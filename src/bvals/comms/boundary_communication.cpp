@@ -54,7 +54,7 @@ TaskStatus SendBoundBufs(std::shared_ptr<MeshData<Real>> &md) {
 
   if (cache.buf_vec.size() == 0)
     InitializeBufferCache<bound_type>(md, &(pmesh->boundary_comm_map), &cache, SendKey,
-                                      true);
+                                      true, pmesh->AggregateBoundaryMessages());
 
   auto [rebuild, nbound, other_communication_unfinished] =
       CheckSendBufferCacheForRebuild<bound_type, true>(md);
@@ -65,6 +65,9 @@ TaskStatus SendBoundBufs(std::shared_ptr<MeshData<Real>> &md) {
   if (other_communication_unfinished) {
     return TaskStatus::incomplete;
   }
+  for (auto &agg : cache.agg_send) {
+    if (!agg->IsAvailableForWrite()) return TaskStatus::incomplete;
+  }
 
   if (rebuild) {
     if constexpr (bound_type == BoundaryType::gmg_restrict_send) {
@@ -152,6 +155,10 @@ TaskStatus SendBoundBufs(std::shared_ptr<MeshData<Real>> &md) {
     else
       buf.SendNull();
   }
+  // Non-local buffers that are aggregated are only sent here
+  for (auto &agg : cache.agg_send) {
+    agg->Send();
+  }
 
   return TaskStatus::complete;
 }
@@ -174,10 +181,11 @@ TaskStatus StartReceiveBoundBufs(std::shared_ptr<MeshData<Real>> &md) {
   auto &cache = md->GetBvarsCache().GetSubCache(bound_type, false);
   if (cache.buf_vec.size() == 0)
     InitializeBufferCache<bound_type>(md, &(pmesh->boundary_comm_map), &cache, ReceiveKey,
-                                      false);
+                                      false, false);
 
   std::for_each(std::begin(cache.buf_vec), std::end(cache.buf_vec),
                 [](auto pbuf) { pbuf->TryStartReceive(); });
+  if (pmesh->boundary_mailbox) pmesh->boundary_mailbox->Progress();
 
   return TaskStatus::complete;
 }
@@ -203,7 +211,9 @@ TaskStatus ReceiveBoundBufs(std::shared_ptr<MeshData<Real>> &md) {
   auto &cache = md->GetBvarsCache().GetSubCache(bound_type, false);
   if (cache.buf_vec.size() == 0)
     InitializeBufferCache<bound_type>(md, &(pmesh->boundary_comm_map), &cache, ReceiveKey,
-                                      false);
+                                      false, false);
+
+  if (pmesh->boundary_mailbox) pmesh->boundary_mailbox->Progress();
 
   bool all_received = true;
   std::for_each(
@@ -399,6 +409,42 @@ ProlongateBounds<BoundaryType::nonlocal>(std::shared_ptr<MeshData<Real>> &);
 template TaskStatus
 ProlongateBounds<BoundaryType::gmg_prolongate_recv>(std::shared_ptr<MeshData<Real>> &);
 
+template <BoundaryType bounds>
+TaskID AddBoundarySendTasks(TaskID dependency, TaskList &tl,
+                            std::shared_ptr<MeshData<Real>> &md, bool multilevel) {
+  static_assert(bounds == BoundaryType::any || bounds == BoundaryType::gmg_same);
+  return tl.AddTask(dependency, TF(SendBoundBufs<bounds>), md);
+}
+template TaskID
+AddBoundarySendTasks<BoundaryType::any>(TaskID, TaskList &,
+                                        std::shared_ptr<MeshData<Real>> &, bool);
+template TaskID
+AddBoundarySendTasks<BoundaryType::gmg_same>(TaskID, TaskList &,
+                                             std::shared_ptr<MeshData<Real>> &, bool);
+
+template <BoundaryType bounds>
+TaskID AddBoundaryReceiveTasks(TaskID dependency, TaskList &tl,
+                               std::shared_ptr<MeshData<Real>> &md, bool multilevel) {
+  static_assert(bounds == BoundaryType::any || bounds == BoundaryType::gmg_same);
+  auto recv = tl.AddTask(dependency, TF(ReceiveBoundBufs<bounds>), md);
+  auto set = tl.AddTask(recv, TF(SetBounds<bounds>), md);
+
+  auto pro = set;
+  if (md->GetMeshPointer()->multilevel) {
+    auto cbound = tl.AddTask(set, TF(ApplyBoundaryConditionsOnCoarseOrFineMD), md, true);
+    pro = tl.AddTask(cbound, TF(ProlongateBounds<bounds>), md);
+  }
+  auto fbound = tl.AddTask(pro, TF(ApplyBoundaryConditionsOnCoarseOrFineMD), md, false);
+
+  return fbound;
+}
+template TaskID
+AddBoundaryReceiveTasks<BoundaryType::any>(TaskID, TaskList &,
+                                           std::shared_ptr<MeshData<Real>> &, bool);
+template TaskID
+AddBoundaryReceiveTasks<BoundaryType::gmg_same>(TaskID, TaskList &,
+                                                std::shared_ptr<MeshData<Real>> &, bool);
+
 // Adds all relevant boundary communication to a single task list
 template <BoundaryType bounds>
 TaskID AddBoundaryExchangeTasks(TaskID dependency, TaskList &tl,
@@ -428,18 +474,8 @@ TaskID AddBoundaryExchangeTasks(TaskID dependency, TaskList &tl,
 
   // auto out = (pro_local | pro);
 
-  auto send = tl.AddTask(dependency, TF(SendBoundBufs<bounds>), md);
-  auto recv = tl.AddTask(dependency, TF(ReceiveBoundBufs<bounds>), md);
-  auto set = tl.AddTask(recv, TF(SetBounds<bounds>), md);
-
-  auto pro = set;
-  if (md->GetMeshPointer()->multilevel) {
-    auto cbound = tl.AddTask(set, TF(ApplyBoundaryConditionsOnCoarseOrFineMD), md, true);
-    pro = tl.AddTask(cbound, TF(ProlongateBounds<bounds>), md);
-  }
-  auto fbound = tl.AddTask(pro, TF(ApplyBoundaryConditionsOnCoarseOrFineMD), md, false);
-
-  return fbound;
+  AddBoundarySendTasks<bounds>(dependency, tl, md, multilevel);
+  return AddBoundaryReceiveTasks<bounds>(dependency, tl, md, multilevel);
 }
 template TaskID
 AddBoundaryExchangeTasks<BoundaryType::any>(TaskID, TaskList &,
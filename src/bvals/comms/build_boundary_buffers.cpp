@@ -81,6 +81,10 @@ void BuildBoundaryBufferSubset(std::shared_ptr<MeshData<Real>> &md,
 #endif
 
     bool use_sparse_buffers = v->IsSet(Metadata::Sparse);
+    // Non-local buffers can be sent as part of a single message per rank pair
+    const bool aggregate =
+        pmesh->AggregateBoundaryMessages() && (sender_rank != receiver_rank);
+    const bool persistent = pmesh->PersistentBoundaryRequests();
     auto get_resource_method = [pmesh, buf_size]() {
       return buf_pool_t<Real>::owner_t(pmesh->pool_map.at(buf_size).Get());
     };
@@ -88,20 +92,24 @@ void BuildBoundaryBufferSubset(std::shared_ptr<MeshData<Real>> &md,
     // Build send buffer (unless this is a receiving flux boundary)
     if constexpr (IsSender(BTYPE)) {
       auto s_key = SendKey(pmb, nb, v, BTYPE);
-      if (buf_map.count(s_key) == 0)
+      if (buf_map.count(s_key) == 0) {
         buf_map[s_key] = CommBuffer<buf_pool_t<Real>::owner_t>(
             tag, sender_rank, receiver_rank, comm, get_resource_method,
-            use_sparse_buffers);
+            use_sparse_buffers, aggregate, persistent);
+        buf_map[s_key].PreparePersistentRequests();
+      }
     }
 
     // Also build the non-local receive buffers here
     if constexpr (IsReceiver(BTYPE)) {
       if (sender_rank != receiver_rank) {
         auto r_key = ReceiveKey(pmb, nb, v, BTYPE);
-        if (buf_map.count(r_key) == 0)
+        if (buf_map.count(r_key) == 0) {
           buf_map[r_key] = CommBuffer<buf_pool_t<Real>::owner_t>(
               tag, receiver_rank, sender_rank, comm, get_resource_method,
-              use_sparse_buffers);
+              use_sparse_buffers, aggregate, persistent);
+          buf_map[r_key].PreparePersistentRequests();
+        }
       }
     }
   });
@@ -84,6 +84,17 @@ template <BoundaryType bounds = BoundaryType::any>
 TaskID AddBoundaryExchangeTasks(TaskID dependency, TaskList &tl,
                                 std::shared_ptr<MeshData<Real>> &md, bool multilevel);
 
+// The two halves of AddBoundaryExchangeTasks. Work that does not read ghost zones, e.g.
+// on the cells of IndexShape::GetCoreBox, can be scheduled next to the receive tasks so
+// that it runs while messages are in flight, and the send and receive may also be added
+// to different task collections as long as the receive comes after the send.
+template <BoundaryType bounds = BoundaryType::any>
+TaskID AddBoundarySendTasks(TaskID dependency, TaskList &tl,
+                            std::shared_ptr<MeshData<Real>> &md, bool multilevel);
+template <BoundaryType bounds = BoundaryType::any>
+TaskID AddBoundaryReceiveTasks(TaskID dependency, TaskList &tl,
+                               std::shared_ptr<MeshData<Real>> &md, bool multilevel);
+
 // Adds all relevant flux correction tasks to a single task list
 TaskID AddFluxCorrectionTasks(TaskID dependency, TaskList &tl,
                               std::shared_ptr<MeshData<Real>> &md, bool multilevel);
@@ -18,6 +18,7 @@
 #define BVALS_COMMS_BVALS_UTILS_HPP_
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <random>
 #include <string>
@@ -39,6 +40,7 @@ inline auto &GetSenderGid(Mesh::channel_key_t &key) { return std::get<0>(key); }
 inline auto &GetReceiverGid(Mesh::channel_key_t &key) { return std::get<1>(key); }
 inline auto &GetVariable(Mesh::channel_key_t &key) { return std::get<2>(key); }
 inline auto &GetLocIdx(Mesh::channel_key_t &key) { return std::get<3>(key); }
+inline auto &GetOther(Mesh::channel_key_t &key) { return std::get<4>(key); }
 
 inline Mesh::channel_key_t SendKey(const MeshBlock *pmb, const NeighborBlock &nb,
                                    const std::shared_ptr<Variable<Real>> &pcv,
@@ -80,18 +82,25 @@ inline Mesh::channel_key_t ReceiveKey(const MeshBlock *pmb, const NeighborBlock
 // simple tests, this did not have a big impact on performance but I think it is useful to
 // leave the machinery here since it doesn't seem to have a big overhead associated with
 // it (LFR).
+//
+// If aggregate is true, the non-local buffers are also grouped by destination rank into
+// aggregated sends. This only makes sense for the sending side.
 template <BoundaryType bound_type, class COMM_MAP, class F>
 void InitializeBufferCache(std::shared_ptr<MeshData<Real>> &md, COMM_MAP *comm_map,
-                           BvarsSubCache_t *pcache, F KeyFunc, bool initialize_flags) {
+                           BvarsSubCache_t *pcache, F KeyFunc, bool initialize_flags,
+                           bool aggregate) {
   using namespace loops;
   using namespace loops::shorthands;
   Mesh *pmesh = md->GetMeshPointer();
 
   std::vector<std::tuple<int, int, Mesh::channel_key_t>> key_order;
+  // Destination rank and maximum buffer size, only needed for aggregated messages
+  std::vector<std::pair<int, int>> dest_info;
 
   int boundary_idx = 0;
   ForEachBoundary<bound_type>(md, [&](auto pmb, sp_mbd_t rc, nb_t &nb, const sp_cv_t v) {
     auto key = KeyFunc(pmb, nb, v, bound_type);
+    if (aggregate) dest_info.push_back({nb.rank, GetBufferSize(pmb, nb, v)});
     PARTHENON_DEBUG_REQUIRE(comm_map->count(key) > 0,
                             "Boundary communicator does not exist");
     // Create a unique index by combining receiver gid (second element of the key
@@ -126,6 +135,32 @@ void InitializeBufferCache(std::shared_ptr<MeshData<Real>> &md, COMM_MAP *comm_m
     (pcache->idx_vec)[std::get<1>(t)] = buff_idx++;
   });
 
+  // Group the non-local buffers by destination rank so that each group can be
+  // sent as a single message
+  pcache->agg_send.clear();
+#ifdef MPI_PARALLEL
+  if (aggregate) {
+    std::map<int, std::shared_ptr<AggregatedSend>> agg_by_rank;
+    for (int ibuf = 0; ibuf < key_order.size(); ++ibuf) {
+      auto *pbuf = pcache->buf_vec[ibuf];
+      if (!pbuf->IsAggregated()) continue;
+      auto key = std::get<2>(key_order[ibuf]);
+      const auto [rank, max_size] = dest_info[std::get<1>(key_order[ibuf])];
+      auto &agg = agg_by_rank[rank];
+      if (agg == nullptr)
+        agg = std::make_shared<AggregatedSend>(rank, pmesh->GetBoundaryAggregationComm());
+      agg->AddMember(pbuf,
+                     {GetSenderGid(key), GetReceiverGid(key),
+                      pmesh->GetCommLabelId(GetVariable(key)), GetLocIdx(key),
+                      GetOther(key)},
+                     max_size);
+    }
+    for (auto &[rank, agg] : agg_by_rank) {
+      pcache->agg_send.push_back(agg);
+    }
+  }
+#endif
+
   const int nbound = pcache->buf_vec.size();
   if (initialize_flags && nbound > 0) {
     if (nbound != pcache->sending_non_zero_flags.size()) {
@@ -0,0 +1,316 @@
+//========================================================================================
+// Parthenon performance portable AMR framework
+// Copyright(C) 2024 The Parthenon collaboration
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bvals/comms/message_aggregation.hpp"
+#include "globals.hpp"
+#include "kokkos_abstraction.hpp"
+#include "mesh/mesh.hpp"
+#include "utils/error_checking.hpp"
+
+namespace parthenon {
+
+namespace aggregation {
+// Header layout (as integers): nmembers, channel ids of every member, sizes of every
+// member. The integers are bitwise copied into the leading Reals of the message.
+int HeaderSize(int nmembers) {
+  const std::size_t nbytes = (1 + (nchannel_ids + 1) * nmembers) * sizeof(int);
+  return (nbytes + sizeof(Real) - 1) / sizeof(Real);
+}
+
+namespace {
+using HostHeader_t = Kokkos::View<Real *, LayoutWrapper, Kokkos::HostSpace, MemUnmanaged>;
+
+// Copy every slice of msg into its buffer (or every buffer into its slice of msg)
+template <bool TO_MESSAGE>
+void CopySlices(const BufArray1D<Real> &msg, const SliceArr_t &slices, int nslices) {
+  if (nslices == 0) return;
+  Kokkos::parallel_for(
+      PARTHENON_AUTO_LABEL,
+      Kokkos::TeamPolicy<>(parthenon::DevExecSpace(), nslices, Kokkos::AUTO),
+      KOKKOS_LAMBDA(parthenon::team_mbr_t team_member) {
+        const int m = team_member.league_rank();
+        const int offset = slices(m).offset;
+        Kokkos::parallel_for(Kokkos::TeamVectorRange<>(team_member, slices(m).size),
+                             [&](const int i) {
+                               if constexpr (TO_MESSAGE) {
+                                 msg(offset + i) = slices(m).buf(i);
+                               } else {
+                                 slices(m).buf(i) = msg(offset + i);
+                               }
+                             });
+      });
+}
+
+void EnsureSliceCapacity(SliceArr_t *slices, SliceArr_t::HostMirror *slices_h, int n) {
+  if (slices->KokkosView().extent_int(0) < n) {
+    *slices = SliceArr_t("aggregated slices", n);
+    *slices_h = Kokkos::create_mirror_view(*slices);
+  }
+}
+} // namespace
+} // namespace aggregation
+
+AggregatedSend::AggregatedSend(int dest_rank, mpi_comm_t comm)
+    : dest_rank_(dest_rank), comm_(comm), max_message_size_(0) {
+#ifdef MPI_PARALLEL
+  request_ = MPI_REQUEST_NULL;
+#endif
+}
+
+AggregatedSend::~AggregatedSend() {
+#ifdef MPI_PARALLEL
+  // The message storage is owned by this object, so the last send has to finish
+  PARTHENON_MPI_CHECK(MPI_Wait(&request_, MPI_STATUS_IGNORE));
+#endif
+}
+
+void AggregatedSend::AddMember(aggregation::comm_buf_t *pbuf,
+                               const aggregation::channel_ids_t &ids, int max_size) {
+  PARTHENON_REQUIRE(pbuf->IsAggregated(), "Buffer was not built for aggregation.");
+  members_.push_back(pbuf);
+  ids_.push_back(ids);
+  max_message_size_ += max_size;
+  // Storage is (re)allocated lazily once all members are known
+  message_ = BufArray1D<Real>{};
+}
+
+bool AggregatedSend::IsAvailableForWrite() {
+#ifdef MPI_PARALLEL
+  if (request_ == MPI_REQUEST_NULL) return true;
+  int flag;
+  PARTHENON_MPI_CHECK(MPI_Test(&request_, &flag, MPI_STATUS_IGNORE));
+  return flag;
+#else
+  PARTHENON_FAIL("Should not have an aggregated send when MPI is not enabled.");
+  return false;
+#endif
+}
+
+void AggregatedSend::Send() {
+#ifdef MPI_PARALLEL
+  using namespace aggregation;
+  const int nmembers = members_.size();
+  const int header_size = HeaderSize(nmembers);
+  if (!message_.is_allocated()) {
+    message_ = BufArray1D<Real>("aggregated message", header_size + max_message_size_);
+    header_h_.resize(header_size);
+    header_.resize(1 + (nchannel_ids + 1) * nmembers);
+    header_[0] = nmembers;
+    for (int m = 0; m < nmembers; ++m) {
+      std::copy(ids_[m].begin(), ids_[m].end(), &header_[1 + nchannel_ids * m]);
+    }
+    EnsureSliceCapacity(&slices_, &slices_h_, nmembers);
+  }
+  // Wait for the previous message to finish, this could be blocking but
+  // SendBoundBufs checks IsAvailableForWrite before packing buffers
+  PARTHENON_MPI_CHECK(MPI_Wait(&request_, MPI_STATUS_IGNORE));
+
+  int offset = header_size;
+  int nslices = 0;
+  for (int m = 0; m < nmembers; ++m) {
+    auto *pbuf = members_[m];
+    const BufferState state = pbuf->GetState();
+    PARTHENON_DEBUG_REQUIRE(state == BufferState::sending ||
+                                state == BufferState::sending_null,
+                            "Member of aggregated message has not been sent.");
+    const int size = (state == BufferState::sending) ? pbuf->buffer().size() : 0;
+    header_[1 + nchannel_ids * nmembers + m] = size;
+    if (size > 0) {
+      slices_h_(nslices++) = Slice{pbuf->buffer(), offset, size};
+      offset += size;
+    }
+  }
+  std::memcpy(header_h_.data(), header_.data(), header_.size() * sizeof(int));
+  Kokkos::deep_copy(Kokkos::subview(message_, std::make_pair(0, header_size)),
+                    HostHeader_t(header_h_.data(), header_size));
+  Kokkos::deep_copy(slices_, slices_h_);
+  CopySlices<true>(message_, slices_, nslices);
+  Kokkos::fence();
+
+  PARTHENON_MPI_CHECK(MPI_Isend(message_.data(), offset, MPITypeMap<Real>::type(),
+                                dest_rank_, message_tag, comm_, &request_));
+#else
+  PARTHENON_FAIL("Should not have an aggregated send when MPI is not enabled.");
+#endif
+}
+
+AggregatedReceiveMailbox::~AggregatedReceiveMailbox() {
+#ifdef MPI_PARALLEL
+  for (auto &[rank, queue] : in_flight_) {
+    for (auto &msg : queue) {
+      if (msg.received) continue;
+      PARTHENON_MPI_CHECK(MPI_Cancel(&msg.request));
+      PARTHENON_MPI_CHECK(MPI_Wait(&msg.request, MPI_STATUS_IGNORE));
+    }
+  }
+#endif
+}
+
+bool AggregatedReceiveMailbox::IsEmpty() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &[rank, queue] : in_flight_) {
+    if (queue.size() > 0) return false;
+  }
+  return true;
+}
+
+void AggregatedReceiveMailbox::ClearChannelCache() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  channel_cache_.clear();
+}
+
+BufArray1D<Real> AggregatedReceiveMailbox::GetStorage(int size) {
+  auto it = std::find_if(free_storage_.begin(), free_storage_.end(),
+                         [size](const auto &buf) { return buf.extent_int(0) >= size; });
+  if (it == free_storage_.end()) return BufArray1D<Real>("aggregated message", size);
+  auto out = *it;
+  free_storage_.erase(it);
+  return out;
+}
+
+const std::vector<aggregation::comm_buf_t *> &
+AggregatedReceiveMailbox::GetMembers(const std::vector<int> &header) {
+  using namespace aggregation;
+  const int nmembers = header[0];
+  std::vector<int> ids(header.begin() + 1, header.begin() + 1 + nchannel_ids * nmembers);
+  auto it = channel_cache_.find(ids);
+  if (it != channel_cache_.end()) return it->second;
+
+  std::vector<comm_buf_t *> members(nmembers);
+  for (int m = 0; m < nmembers; ++m) {
+    const int *id = &ids[nchannel_ids * m];
+    Mesh::channel_key_t key{id[0], id[1], pmesh_->GetCommLabel(id[2]), id[3], id[4]};
+    auto buf_it = pmesh_->boundary_comm_map.find(key);
+    PARTHENON_REQUIRE(buf_it != pmesh_->boundary_comm_map.end(),
+                      "Received aggregated data for a channel that does not exist "
+                      "(sender: " +
+                          std::to_string(id[0]) + ", receiver: " + std::to_string(id[1]) +
+                          ", var: " + std::get<2>(key) + ")");
+    members[m] = &(buf_it->second);
+  }
+  return channel_cache_.emplace(std::move(ids), std::move(members)).first->second;
+}
+
+bool AggregatedReceiveMailbox::TryUnpack(
+    Message &msg, std::unordered_set<aggregation::comm_buf_t *> *blocked) {
+  using namespace aggregation;
+  const int nmembers = msg.header[0];
+  const int *sizes = &msg.header[1 + nchannel_ids * nmembers];
+  const auto &members = GetMembers(msg.header);
+
+  // Data from a previous message for any of the members may not have been used yet, in
+  // which case this message and all later messages containing these members have to wait
+  bool ready = true;
+  for (auto *pbuf : members) {
+    ready = ready && (pbuf->GetState() == BufferState::stale) && !blocked->count(pbuf);
+  }
+  if (!ready) {
+    blocked->insert(members.begin(), members.end());
+    return false;
+  }
+
+  EnsureSliceCapacity(&slices_, &slices_h_, nmembers);
+  int offset = HeaderSize(nmembers);
+  int nslices = 0;
+  for (int m = 0; m < nmembers; ++m) {
+    members[m]->PrepareAggregatedReceive(sizes[m] == 0);
+    if (sizes[m] > 0) {
+      PARTHENON_REQUIRE(members[m]->buffer().size() >= static_cast<std::size_t>(sizes[m]),
+                        "Aggregated data does not fit into receive buffer.");
+      slices_h_(nslices++) = Slice{members[m]->buffer(), offset, sizes[m]};
+      offset += sizes[m];
+    }
+  }
+  PARTHENON_REQUIRE(offset == msg.size, "Aggregated message has unexpected size.");
+  Kokkos::deep_copy(slices_, slices_h_);
+  CopySlices<false>(msg.data, slices_, nslices);
+  // The message storage is recycled below, so the copies have to be finished
+  Kokkos::fence();
+
+  for (int m = 0; m < nmembers; ++m) {
+    members[m]->FinishAggregatedReceive(sizes[m] == 0);
+  }
+  free_storage_.push_back(msg.data);
+  return true;
+}
+
+void AggregatedReceiveMailbox::Progress() {
+#ifdef MPI_PARALLEL
+  using namespace aggregation;
+  std::lock_guard<std::mutex> lock(mutex_);
+  mpi_comm_t comm = pmesh_->GetBoundaryAggregationComm();
+
+  // Post receives for all messages that have arrived
+  int flag = true;
+  while (flag) {
+    MPI_Status status;
+    PARTHENON_MPI_CHECK(MPI_Iprobe(MPI_ANY_SOURCE, message_tag, comm, &flag, &status));
+    if (flag) {
+      Message msg;
+      PARTHENON_MPI_CHECK(MPI_Get_count(&status, MPITypeMap<Real>::type(), &msg.size));
+      msg.data = GetStorage(msg.size);
+      PARTHENON_MPI_CHECK(MPI_Irecv(msg.data.data(), msg.size, MPITypeMap<Real>::type(),
+                                    status.MPI_SOURCE, message_tag, comm, &msg.request));
+      in_flight_[status.MPI_SOURCE].push_back(std::move(msg));
+    }
+  }
+
+  // Unpack finished messages. Messages from one rank can be unpacked out of order as
+  // long as they do not share members with earlier messages. This is required since
+  // the sending rank may have partitions that are a full stage ahead of other
+  // partitions. We stop at the first message that has not finished since its members
+  // are not known yet.
+  for (auto &[rank, queue] : in_flight_) {
+    std::unordered_set<comm_buf_t *> blocked;
+    for (auto it = queue.begin(); it != queue.end();) {
+      auto &msg = *it;
+      if (!msg.received) {
+        int done;
+        PARTHENON_MPI_CHECK(MPI_Test(&msg.request, &done, MPI_STATUS_IGNORE));
+        if (!done) break;
+        msg.received = true;
+        // Copy the header to host
+        const int nheader_max = std::min(msg.size, HeaderSize(0));
+        std::vector<Real> header_h(nheader_max);
+        Kokkos::deep_copy(HostHeader_t(header_h.data(), nheader_max),
+                          Kokkos::subview(msg.data, std::make_pair(0, nheader_max)));
+        int nmembers;
+        std::memcpy(&nmembers, header_h.data(), sizeof(int));
+        const int header_size = HeaderSize(nmembers);
+        header_h.resize(header_size);
+        Kokkos::deep_copy(HostHeader_t(header_h.data(), header_size),
+                          Kokkos::subview(msg.data, std::make_pair(0, header_size)));
+        msg.header.resize(1 + (nchannel_ids + 1) * nmembers);
+        std::memcpy(msg.header.data(), header_h.data(), msg.header.size() * sizeof(int));
+      }
+      if (TryUnpack(msg, &blocked)) {
+        it = queue.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+#endif
+}
+
+} // namespace parthenon
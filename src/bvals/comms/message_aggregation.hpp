@@ -0,0 +1,159 @@
+//========================================================================================
+// Parthenon performance portable AMR framework
+// Copyright(C) 2024 The Parthenon collaboration
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#ifndef BVALS_COMMS_MESSAGE_AGGREGATION_HPP_
+#define BVALS_COMMS_MESSAGE_AGGREGATION_HPP_
+
+#include <array>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "basic_types.hpp"
+#include "kokkos_abstraction.hpp"
+#include "utils/communication_buffer.hpp"
+#include "utils/mpi_types.hpp"
+#include "utils/object_pool.hpp"
+
+namespace parthenon {
+
+class Mesh;
+
+// Aggregated boundary messages
+//
+// When <parthenon/mesh>/aggregate_boundary_messages is true, every non-local boundary
+// buffer that a MeshData partition sends to a given rank during a single call to
+// SendBoundBufs is gathered into one contiguous message instead of being sent with its
+// own MPI_Isend. Messages are self-describing: they start with a header containing, for
+// each member buffer, the integers identifying its communication channel (sender gid,
+// receiver gid, variable id, location index, other) and the number of values it carries
+// (zero for a buffer that was sent null), followed by the data of all non-null members.
+// This means the receiving rank does not need to know how the sending rank partitioned
+// its blocks. On the receiving side a single mailbox per rank probes for incoming
+// aggregated messages and scatters their contents into the individual receive buffers,
+// which are then consumed by ReceiveBoundBufs and SetBounds as usual.
+namespace aggregation {
+using comm_buf_t = CommBuffer<buf_pool_t<Real>::owner_t>;
+// Number of integers used to identify the channel of a member buffer
+constexpr int nchannel_ids = 5;
+using channel_ids_t = std::array<int, nchannel_ids>;
+// All aggregated messages are sent with the same tag on a dedicated communicator, so
+// that MPI message ordering guarantees they are received in the order they were sent
+constexpr int message_tag = 0;
+
+// Number of Reals required to store the header of a message with nmembers members
+int HeaderSize(int nmembers);
+
+// A contiguous piece of an aggregated message and the buffer it is copied to/from
+struct Slice {
+  BufArray1D<Real> buf;
+  int offset;
+  int size;
+};
+using SliceArr_t = ParArray1D<Slice>;
+} // namespace aggregation
+
+// Gathers the non-local send buffers of a MeshData partition that are all going to the
+// same rank into a single message
+class AggregatedSend {
+ public:
+  AggregatedSend(int dest_rank, mpi_comm_t comm);
+  ~AggregatedSend();
+  AggregatedSend(const AggregatedSend &) = delete;
+  AggregatedSend &operator=(const AggregatedSend &) = delete;
+
+  void AddMember(aggregation::comm_buf_t *pbuf, const aggregation::channel_ids_t &ids,
+                 int max_size);
+
+  int GetDestinationRank() const { return dest_rank_; }
+  int NumMembers() const { return members_.size(); }
+
+  // True if the previous message has been sent and its storage can be reused
+  bool IsAvailableForWrite();
+
+  // Gathers the data of all members and posts the message. Must be called after Send()
+  // or SendNull() has been called on every member, since the state of each member
+  // determines whether or not its data is included.
+  void Send();
+
+ private:
+  int dest_rank_;
+  mpi_comm_t comm_;
+  mpi_request_t request_;
+
+  std::vector<aggregation::comm_buf_t *> members_;
+  std::vector<aggregation::channel_ids_t> ids_;
+  int max_message_size_;
+
+  BufArray1D<Real> message_;
+  std::vector<int> header_;
+  std::vector<Real> header_h_;
+  aggregation::SliceArr_t slices_;
+  aggregation::SliceArr_t::HostMirror slices_h_;
+};
+
+// Receives aggregated messages from all other ranks and unpacks them into the receive
+// buffers stored in Mesh::boundary_comm_map
+class AggregatedReceiveMailbox {
+ public:
+  explicit AggregatedReceiveMailbox(Mesh *pmesh) : pmesh_(pmesh) {}
+  ~AggregatedReceiveMailbox();
+  AggregatedReceiveMailbox(const AggregatedReceiveMailbox &) = delete;
+  AggregatedReceiveMailbox &operator=(const AggregatedReceiveMailbox &) = delete;
+
+  // Post receives for newly arrived messages and unpack every completed message whose
+  // member buffers have all been consumed (i.e. staled) since the last time they
+  // received data. Data for a given buffer is always unpacked in the order in which
+  // it was sent.
+  void Progress();
+
+  // True if there are no messages in flight or waiting to be unpacked
+  bool IsEmpty() const;
+
+  // Forget cached channel lookups, needs to be called whenever the
+  // communication buffers are rebuilt
+  void ClearChannelCache();
+
+ private:
+  struct Message {
+    BufArray1D<Real> data;
+    mpi_request_t request;
+    int size;
+    bool received = false;
+    std::vector<int> header;
+  };
+
+  bool TryUnpack(Message &msg, std::unordered_set<aggregation::comm_buf_t *> *blocked);
+  const std::vector<aggregation::comm_buf_t *> &
+  GetMembers(const std::vector<int> &header);
+  BufArray1D<Real> GetStorage(int size);
+
+  Mesh *pmesh_;
+  mutable std::mutex mutex_;
+  std::unordered_map<int, std::deque<Message>> in_flight_;
+  std::vector<BufArray1D<Real>> free_storage_;
+  std::map<std::vector<int>, std::vector<aggregation::comm_buf_t *>> channel_cache_;
+  aggregation::SliceArr_t slices_;
+  aggregation::SliceArr_t::HostMirror slices_h_;
+};
+
+} // namespace parthenon
+
+#endif // BVALS_COMMS_MESSAGE_AGGREGATION_HPP_
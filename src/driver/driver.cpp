@@ -27,6 +27,7 @@
 #include "outputs/outputs.hpp"
 #include "parameter_input.hpp"
 #include "parthenon_mpi.hpp"
+#include "utils/error_checking.hpp"
 #include "utils/utils.hpp"
 
 namespace parthenon {
@@ -37,6 +38,25 @@ Kokkos::Timer Driver::timer_main;
 Kokkos::Timer Driver::timer_cycle;
 Kokkos::Timer Driver::timer_LBandAMR;
 
+Driver::Driver(ParameterInput *pin, ApplicationInput *app_in, Mesh *pm)
+    : pinput(pin), app_input(app_in), pmesh(pm), mbcnt_prev(), time_LBandAMR() {
+  const int nthreads = pin->GetOrAddInteger("parthenon/execution", "nthreads", 1);
+  PARTHENON_REQUIRE_THROWS(nthreads > 0,
+                           "parthenon/execution/nthreads must be at least one.");
+#ifdef MPI_PARALLEL
+  // Tasks of different lists communicate concurrently when running on several threads
+  if (nthreads > 1) {
+    int provided;
+    PARTHENON_MPI_CHECK(MPI_Query_thread(&provided));
+    PARTHENON_REQUIRE_THROWS(
+        provided == MPI_THREAD_MULTIPLE,
+        "parthenon/execution/nthreads > 1 requires MPI_THREAD_MULTIPLE. Set the "
+        "environment variable PARTHENON_MPI_THREAD_MULTIPLE=true to request it.");
+  }
+#endif
+  pthread_pool = std::make_unique<ThreadPool>(nthreads);
+}
+
 void Driver::PreExecute() {
   if (Globals::my_rank == 0) {
     std::cout << "# Variables in use:\n" << *(pmesh->resolved_packages) << std::endl;
@@ -189,6 +209,8 @@ void EvolutionDriver::PostExecute(DriverStatus status) {
 }
 
 void EvolutionDriver::InitializeBlockTimeSteps() {
+  // a reduction started during the step covers blocks that may no longer exist
+  pmesh->dt_reduction.Discard();
   // calculate the first time step using Block function
   for (auto &pmb : pmesh->block_list) {
     Update::EstimateTimestep(pmb->meshblock_data.Get().get());
@@ -211,15 +233,24 @@ void EvolutionDriver::SetGlobalTimeStep() {
     tm.dt *= 2.0;
   }
   Real big = std::numeric_limits<Real>::max();
-  for (auto const &pmb : pmesh->block_list) {
-    tm.dt = std::min(tm.dt, pmb->NewDt());
-    pmb->SetAllowedDt(big);
-  }
+  if (pmesh->dt_reduction.InFlight()) {
+    // the step already started the reduction over ranks, see
+    // Update::StartTimestepReduction
+    tm.dt = std::min(tm.dt, pmesh->dt_reduction.Wait());
+    for (auto const &pmb : pmesh->block_list) {
+      pmb->SetAllowedDt(big);
+    }
+  } else {
+    for (auto const &pmb : pmesh->block_list) {
+      tm.dt = std::min(tm.dt, pmb->NewDt());
+      pmb->SetAllowedDt(big);
+    }
 
 #ifdef MPI_PARALLEL
-  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &tm.dt, 1, MPI_PARTHENON_REAL, MPI_MIN,
-                                    MPI_COMM_WORLD));
+    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &tm.dt, 1, MPI_PARTHENON_REAL,
+                                      MPI_MIN, MPI_COMM_WORLD));
 #endif
+  }
 
   if (tm.time < tm.tlim &&
       (tm.tlim - tm.time) < tm.dt) // timestep would take us past desired endpoint
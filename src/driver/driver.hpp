@@ -37,8 +37,7 @@ enum class DriverStatus { complete, timeout, failed };
 
 class Driver {
  public:
-  Driver(ParameterInput *pin, ApplicationInput *app_in, Mesh *pm)
-      : pinput(pin), app_input(app_in), pmesh(pm), mbcnt_prev(), time_LBandAMR() {}
+  Driver(ParameterInput *pin, ApplicationInput *app_in, Mesh *pm);
   virtual DriverStatus Execute() = 0;
   void InitializeOutputs() { pouts = std::make_unique<Outputs>(pmesh, pinput); }
 
@@ -46,6 +45,8 @@ class Driver {
   ApplicationInput *app_input;
   Mesh *pmesh;
   std::unique_ptr<Outputs> pouts;
+  // Threads executing the task collections of this driver, see parthenon/execution
+  std::unique_ptr<ThreadPool> pthread_pool;
   static double elapsed_main() { return timer_main.seconds(); }
   static double elapsed_cycle() { return timer_cycle.seconds(); }
   static double elapsed_LBandAMR() { return timer_LBandAMR.seconds(); }
@@ -105,7 +106,7 @@ TaskListStatus ConstructAndExecuteBlockTasks(T *driver, Args... args) {
   for (auto &pmb : driver->pmesh->block_list) {
     tr[i++] = driver->MakeTaskList(pmb.get(), std::forward<Args>(args)...);
   }
-  TaskListStatus status = tc.Execute();
+  TaskListStatus status = tc.Execute(*driver->pthread_pool);
   return status;
 }
 
@@ -113,7 +114,7 @@ template <typename T, class... Args>
 TaskListStatus ConstructAndExecuteTaskLists(T *driver, Args... args) {
   TaskCollection tc =
       driver->MakeTaskCollection(driver->pmesh->block_list, std::forward<Args>(args)...);
-  TaskListStatus status = tc.Execute();
+  TaskListStatus status = tc.Execute(*driver->pthread_pool);
   return status;
 }
 
@@ -36,6 +36,9 @@ int nranks;  // total number of MPI ranks
 // sparse configuration values that are needed in various places
 SparseConfig sparse_config;
 
+// block arena configuration, see BlockArenaConfig
+BlockArenaConfig block_arena;
+
 // timeout (in seconds) for ReceiveBoundaryBuffers task
 Real receive_boundary_buffer_timeout;
 
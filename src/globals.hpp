@@ -33,11 +33,27 @@ struct SparseConfig {
   Real allocation_threshold = 1.0e-12;
   Real deallocation_threshold = 1.0e-14;
   int deallocation_count = 5;
+  // Recycle the storage of deallocated sparse variables, see Mesh::sparse_storage_pool
+  bool pool_storage = true;
+};
+
+// Block arena mode, in which the data (and coarse buffers) of all dense variables of a
+// MeshBlockData are carved out of a single slab instead of being allocated one by one.
+// Each array starts at a multiple of alignment bytes. With interleave == grouped the
+// data of all variables comes first followed by all coarse buffers, so that the cell
+// data of a block is one contiguous range. With interleave == variable the coarse
+// buffer of each variable directly follows its data.
+struct BlockArenaConfig {
+  enum class Interleave { grouped, variable };
+  bool enabled = false;
+  int alignment = 256;
+  Interleave interleave = Interleave::grouped;
 };
 
 extern int my_rank, nranks, nghost;
 
 extern SparseConfig sparse_config;
+extern BlockArenaConfig block_arena;
 
 extern Real receive_boundary_buffer_timeout;
 extern Real current_task_runtime_sec;
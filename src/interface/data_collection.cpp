@@ -44,21 +44,64 @@ std::string DataCollection<T>::GetKey(const std::string &stage_label,
   return key;
 }
 
+template <typename T>
+int DataCollection<T>::GetStageId(const std::string &label) {
+  auto it = stage_ids_.find(label);
+  if (it != stage_ids_.end()) return it->second;
+  const int id = stage_names_.size();
+  stage_ids_[label] = id;
+  stage_names_.push_back(label);
+  partition_table_.emplace_back();
+  return id;
+}
+
+template <typename T>
+std::shared_ptr<T> *&
+DataCollection<T>::GetPartitionSlot(int stage_id,
+                                    const std::shared_ptr<BlockListPartition> &in) {
+  PARTHENON_DEBUG_REQUIRE(stage_id >= 0 && stage_id < partition_table_.size(),
+                          "Unknown stage id");
+  const int grid_idx =
+      in->grid.type == GridType::two_level_composite ? in->grid.logical_level + 1 : 0;
+  auto &grids = partition_table_[stage_id];
+  if (grids.size() <= grid_idx) grids.resize(grid_idx + 1);
+  auto &slots = grids[grid_idx];
+  if (slots.size() <= in->partition) slots.resize(in->partition + 1);
+  auto &slot = slots[in->partition];
+  // Comparing owners rather than locking the weak pointer is cheaper, and a rebuilt
+  // partition never shares the owner of an expired one
+  if (slot.partition.owner_before(in) || in.owner_before(slot.partition)) {
+    slot.partition = in;
+    slot.container = nullptr;
+  }
+  return slot.container;
+}
+
+template <>
+std::shared_ptr<MeshData<Real>> &
+DataCollection<MeshData<Real>>::GetOrAdd(int stage_id,
+                                         const std::shared_ptr<BlockListPartition> &in) {
+  auto *pc = GetPartitionSlot(stage_id, in);
+  if (pc != nullptr) return *pc;
+  return Add(stage_names_[stage_id], in);
+}
+
 template <>
 std::shared_ptr<MeshData<Real>> &
 DataCollection<MeshData<Real>>::GetOrAdd(const std::string &mbd_label,
                                          const int &partition_id) {
-  return Add(mbd_label,
-             pmy_mesh_->GetDefaultBlockPartitions(GridIdentifier::leaf())[partition_id]);
+  return GetOrAdd(
+      GetStageId(mbd_label),
+      pmy_mesh_->GetDefaultBlockPartitions(GridIdentifier::leaf())[partition_id]);
 }
 
 template <>
 std::shared_ptr<MeshData<Real>> &
 DataCollection<MeshData<Real>>::GetOrAdd(int gmg_level, const std::string &mbd_label,
                                          const int &partition_id) {
-  return Add(mbd_label,
-             pmy_mesh_->GetDefaultBlockPartitions(
-                 GridIdentifier::two_level_composite(gmg_level))[partition_id]);
+  return GetOrAdd(GetStageId(mbd_label),
+                  pmy_mesh_->GetDefaultBlockPartitions(
+                      GridIdentifier::two_level_composite(gmg_level))[partition_id]);
 }
 
 template class DataCollection<MeshData<Real>>;
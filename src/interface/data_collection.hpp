@@ -17,6 +17,8 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include "basic_types.hpp"
@@ -38,6 +40,10 @@ class MeshBlockData;
 /// stages in multi-stage drivers or the corresponding MeshBlockPacks in a
 /// DataCollection of MeshData.
 ///
+/// Containers built from a BlockListPartition are additionally stored in a dense table
+/// indexed by an interned integer stage id, the grid and the partition index, so that
+/// the per-task lookups of a stage and partition do not need to build a string key.
+///
 /// T must implement:
 ///   bool Contains(std::vector<std::string>)
 ///   Initialize(T*, std::vector<std::string>, bool)
@@ -55,6 +61,17 @@ class DataCollection {
   template <class SRC_t, typename ID_t>
   std::shared_ptr<T> &Add(const std::string &name, const std::shared_ptr<SRC_t> &src,
                           const std::vector<ID_t> &fields, const bool shallow) {
+    if constexpr (std::is_same<SRC_t, BlockListPartition>::value) {
+      auto *pc = GetPartitionSlot(GetStageId(name), src);
+      if (pc != nullptr) {
+        if (fields.size() && !(*pc)->Contains(fields)) {
+          PARTHENON_THROW(name +
+                          " already exists in collection but fields do not match.");
+        }
+        return *pc;
+      }
+    }
+
     auto key = GetKey(name, src);
     auto it = containers_.find(key);
     if (it != containers_.end()) {
@@ -68,6 +85,9 @@ class DataCollection {
     c->Initialize(src, fields, shallow);
 
     containers_[key] = c;
+    if constexpr (std::is_same<SRC_t, BlockListPartition>::value) {
+      GetPartitionSlot(GetStageId(name), src) = &containers_[key];
+    }
     return containers_[key];
   }
 
@@ -99,12 +119,22 @@ class DataCollection {
 
   void Set(const std::string &name, std::shared_ptr<T> &d) { containers_[name] = d; }
 
-  // Legacy methods that are specific to MeshData
+  // Returns the interned id of a stage label, which stays valid for the lifetime of the
+  // collection
+  int GetStageId(const std::string &label);
+
+  // Methods that are specific to MeshData. The string versions are thin wrappers
+  // around the integer-keyed one, which only does a table lookup if the container exists
+  std::shared_ptr<T> &GetOrAdd(int stage_id,
+                               const std::shared_ptr<BlockListPartition> &partition);
   std::shared_ptr<T> &GetOrAdd(const std::string &mbd_label, const int &partition_id);
   std::shared_ptr<T> &GetOrAdd(int gmg_level, const std::string &mbd_label,
                                const int &partition_id);
 
   void PurgeNonBase() {
+    for (auto &grids : partition_table_) {
+      grids.clear();
+    }
     auto c = containers_.begin();
     while (c != containers_.end()) {
       if (c->first != "base") {
@@ -125,8 +155,24 @@ class DataCollection {
     return stage_label;
   }
 
+  // Returns a reference to the table entry for a stage and partition, which points to
+  // the container in containers_ (or is null if the container has not been added yet)
+  std::shared_ptr<T> *&GetPartitionSlot(int stage_id,
+                                        const std::shared_ptr<BlockListPartition> &in);
+
+  struct PartitionSlot {
+    // Used to detect entries that belong to a partition that has since been rebuilt
+    std::weak_ptr<BlockListPartition> partition;
+    std::shared_ptr<T> *container = nullptr;
+  };
+
   Mesh *pmy_mesh_;
   std::map<std::string, std::shared_ptr<T>> containers_;
+  std::unordered_map<std::string, int> stage_ids_;
+  std::vector<std::string> stage_names_;
+  // Indexed by stage id, grid (leaf first, then two-level composite grids by level) and
+  // partition index
+  std::vector<std::vector<std::vector<PartitionSlot>>> partition_table_;
 };
 
 } // namespace parthenon
@@ -213,6 +213,14 @@ class MeshData {
     }
   }
 
+  // Device scalar that timestep estimates for these blocks are reduced into before they
+  // are combined with the rest of the mesh (see Update::EstimateTimestepDevice)
+  const ParArray0D<Real> &GetDeviceDt() {
+    if (!dt_device_.KokkosView().is_allocated())
+      dt_device_ = ParArray0D<Real>("MeshData::dt_device");
+    return dt_device_;
+  }
+
   auto &GetBvarsCache() { return bvars_cache_; }
 
   template <class... Ts>
@@ -515,6 +523,8 @@ class MeshData {
   SwarmPackCache<Real> swarm_pack_real_cache_;
   // caches for boundary information
   BvarsCache_t bvars_cache_;
+  // scratch for device timestep estimates
+  ParArray0D<Real> dt_device_;
 };
 
 template <typename T, typename... Args>
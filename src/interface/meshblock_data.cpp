@@ -14,6 +14,7 @@
 #include "interface/meshblock_data.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <memory>
 #include <set>
@@ -40,17 +41,78 @@ namespace parthenon {
 /// @param label the name of the variable
 /// @param metadata the metadata associated with the variable
 /// @param sparse_id the sparse id of the variable
+/// @param arena_vars if not null, dense variables are appended to this list to be
+/// allocated later by AllocateArena when the block arena is enabled
 template <typename T>
 void MeshBlockData<T>::AddField(const std::string &base_name, const Metadata &metadata,
-                                int sparse_id) {
+                                int sparse_id, VariableVector<T> *arena_vars) {
   auto pvar = std::make_shared<Variable<T>>(base_name, metadata, sparse_id, pmy_block);
   Add(pvar);
 
-  if (!Globals::sparse_config.enabled || !pvar->IsSparse()) {
+  if (arena_vars != nullptr && UseArena(*pvar)) {
+    arena_vars->push_back(pvar);
+  } else if (!Globals::sparse_config.enabled || !pvar->IsSparse()) {
     pvar->Allocate(pmy_block);
   }
 }
 
+template <typename T>
+bool MeshBlockData<T>::UseArena(const Variable<T> &var) {
+  // Sparse variables are allocated and deallocated individually at runtime, so they
+  // always get their own storage
+  return Globals::block_arena.enabled && !var.IsSparse();
+}
+
+template <typename T>
+void MeshBlockData<T>::AllocateArena(const VariableVector<T> &vars) {
+  if (vars.empty()) return;
+  // if the block pointer is expired, pmb is nullptr and no coarse buffers are needed
+  MeshBlock *pmb = pmy_block.lock().get();
+
+  const std::size_t align =
+      std::max<std::size_t>(1, Globals::block_arena.alignment / sizeof(T));
+  auto padded = [align](std::size_t n) { return ((n + align - 1) / align) * align; };
+
+  // Variables that were shallow copied keep pointing to the coarse buffer of the source
+  std::vector<std::size_t> data_offset(vars.size());
+  std::vector<std::size_t> coarse_offset(vars.size(), Variable<T>::no_offset);
+  std::size_t size = 0;
+  auto add_coarse = [&](int n) {
+    const std::size_t coarse_size = vars[n]->CoarseSize(pmb);
+    if (coarse_size > 0 && !vars[n]->coarse_s.IsAllocated()) {
+      coarse_offset[n] = size;
+      size += padded(coarse_size);
+    }
+  };
+  const bool grouped =
+      Globals::block_arena.interleave == Globals::BlockArenaConfig::Interleave::grouped;
+  for (int n = 0; n < vars.size(); ++n) {
+    data_offset[n] = size;
+    size += padded(vars[n]->DataSize());
+    if (!grouped) add_coarse(n);
+  }
+  if (grouped) {
+    for (int n = 0; n < vars.size(); ++n) {
+      add_coarse(n);
+    }
+  }
+
+  // Over-allocate so that the start of the arena can be aligned. Like any other
+  // variable storage the slab is zero initialized.
+  ParArray1D<T> slab("block_arena", size + align - 1);
+  const auto misalignment = reinterpret_cast<std::uintptr_t>(slab.data()) / sizeof(T);
+  const std::size_t shift = (align - misalignment % align) % align;
+  arena_ = ParArray1D<T>(
+      Kokkos::subview(slab.KokkosView(), std::make_pair(shift, shift + size)));
+
+  for (int n = 0; n < vars.size(); ++n) {
+    vars[n]->AllocateFromArena(pmb, arena_, data_offset[n], coarse_offset[n]);
+  }
+  if (pmb != nullptr) {
+    pmb->LogMemUsage(slab.size() * sizeof(T));
+  }
+}
+
 /// Queries related to variable packs
 /// This is a helper function that queries the cache for the given pack.
 /// The strings are the keys and the lists are the values.
@@ -147,9 +147,16 @@ class MeshBlockData {
     coarseVarPackMap_.clear();
     varFluxPackMap_.clear();
 
-    [[maybe_unused]] auto add_var = [=](auto var) {
+    arena_.Reset();
+
+    // dense variables whose data is allocated together from the block arena
+    VariableVector<T> arena_vars;
+    [[maybe_unused]] auto add_var = [&](auto var) {
       if (shallow_copy || var->IsSet(Metadata::OneCopy)) {
         Add(var);
+      } else if (UseArena(*var) && var->IsAllocated()) {
+        arena_vars.push_back(var->AllocateCopy(pmy_block, false));
+        Add(arena_vars.back());
       } else {
         Add(var->AllocateCopy(pmy_block));
       }
@@ -163,7 +170,7 @@ class MeshBlockData {
         }
       } else if constexpr (std::is_same_v<SRC_t, MeshBlock>) {
         for (auto const &q : resolved_packages->AllFields()) {
-          AddField(q.first.base_name, q.second, q.first.sparse_id);
+          AddField(q.first.base_name, q.second, q.first.sparse_id, &arena_vars);
         }
       }
     } else {
@@ -188,6 +195,8 @@ class MeshBlockData {
       }
     }
 
+    AllocateArena(arena_vars);
+
     // TODO(LFR): Not sure why we only do this in the MeshBlock case, but this carries
     // over from the previous iteration.
     if constexpr (std::is_same_v<SRC_t, MeshBlock>) {
@@ -549,9 +558,21 @@ class MeshBlockData {
 
   bool IsShallow() const { return is_shallow_; }
 
+  /// The slab holding the data of all dense variables if the block arena is enabled
+  /// (see Globals::BlockArenaConfig), unallocated otherwise. With grouped interleaving
+  /// the cell data of all these variables is a single contiguous range at its start.
+  const ParArray1D<T> &GetArena() const { return arena_; }
+
  private:
+  // If arena_vars is not null, dense variables are appended to it instead of being
+  // allocated when the block arena is enabled
   void AddField(const std::string &base_name, const Metadata &metadata,
-                int sparse_id = InvalidSparseID);
+                int sparse_id = InvalidSparseID, VariableVector<T> *arena_vars = nullptr);
+
+  static bool UseArena(const Variable<T> &var);
+  // Allocates the data (and the coarse buffers that are not shared with another
+  // variable) of all vars from a single aligned slab
+  void AllocateArena(const VariableVector<T> &vars);
 
   void Add(std::shared_ptr<Variable<T>> var) noexcept {
     if (varUidMap_.count(var->GetUniqueID())) {
@@ -599,6 +620,7 @@ class MeshBlockData {
       std::int64_t bytes = var->Deallocate();
       auto pmb = GetBlockPointer();
       pmb->LogMemUsage(-bytes);
+      pmb->UpdateAllocationEpoch();
     }
   }
 
@@ -606,6 +628,7 @@ class MeshBlockData {
   std::shared_ptr<StateDescriptor> resolved_packages;
   bool is_shallow_ = false;
   const std::string stage_name_;
+  ParArray1D<T> arena_;
 
   VariableVector<T> varVector_; ///< the saved variable array
   std::map<Uid_t, std::shared_ptr<Variable<T>>> varUidMap_;
@@ -63,34 +63,24 @@ SparsePackIdxMap SparsePackBase::GetIdxMap(const impl::PackDescriptor &desc) {
 
 template <class T>
 SparsePackBase::alloc_t
-SparsePackBase::GetAllocStatus(T *pmd, const PackDescriptor &desc,
-                               const std::vector<bool> &include_block) {
+SparsePackBase::GetAllocStatus(T *pmd, const std::vector<bool> &include_block) {
   using mbd_t = MeshBlockData<Real>;
-
-  int nvar = desc.nvar_groups;
-
-  std::vector<int> astat;
+  // Every (de)allocation moves the epoch of the block past that of all other blocks, so
+  // the largest epoch changes whenever the allocation status of any block does
+  alloc_t astat{0, 0};
   ForEachBlock(pmd, include_block, [&](int b, mbd_t *pmbd) {
-    const auto &uid_map = pmbd->GetUidMap();
-    for (int i = 0; i < nvar; ++i) {
-      for (const auto &[var_name, uid] : desc.var_groups[i]) {
-        if (uid_map.count(uid) > 0) {
-          const auto pv = uid_map.at(uid);
-          astat.push_back(pv->GetAllocationStatus());
-        } else {
-          astat.push_back(-1);
-        }
-      }
-    }
+    astat.first++;
+    astat.second = std::max(astat.second, pmbd->GetBlockPointer()->GetAllocationEpoch());
   });
   return astat;
 }
 
 // Specialize for the only two types this should work for
-template SparsePackBase::alloc_t SparsePackBase::GetAllocStatus<MeshBlockData<Real>>(
-    MeshBlockData<Real> *, const PackDescriptor &, const std::vector<bool> &);
 template SparsePackBase::alloc_t
-SparsePackBase::GetAllocStatus<MeshData<Real>>(MeshData<Real> *, const PackDescriptor &,
+SparsePackBase::GetAllocStatus<MeshBlockData<Real>>(MeshBlockData<Real> *,
+                                                    const std::vector<bool> &);
+template SparsePackBase::alloc_t
+SparsePackBase::GetAllocStatus<MeshData<Real>>(MeshData<Real> *,
                                                const std::vector<bool> &);
 
 template <class T>
@@ -294,31 +284,26 @@ template SparsePackBase SparsePackBase::Build<MeshData<Real>>(MeshData<Real> *,
                                                               const PackDescriptor &,
                                                               const std::vector<bool> &);
 
+SparsePackCache::map_t::iterator SparsePackCache::Find(const PackDescriptor &desc) {
+  auto [first, last] = pack_map.equal_range(desc.key);
+  for (auto it = first; it != last; ++it) {
+    if (it->second.identifier == desc.identifier) return it;
+  }
+  return pack_map.end();
+}
+
 template <class T>
 SparsePackBase &SparsePackCache::Get(T *pmd, const PackDescriptor &desc,
                                      const std::vector<bool> &include_block) {
-  if (pack_map.count(desc.identifier) > 0) {
-    auto &cache_tuple = pack_map[desc.identifier];
-    auto &pack = std::get<0>(cache_tuple);
-    auto alloc_status_in = SparsePackBase::GetAllocStatus(pmd, desc, include_block);
-    auto &alloc_status = std::get<1>(cache_tuple);
-    if (alloc_status.size() != alloc_status_in.size())
-      return BuildAndAdd(pmd, desc, include_block);
-    for (int i = 0; i < alloc_status_in.size(); ++i) {
-      if (alloc_status[i] != alloc_status_in[i])
-        return BuildAndAdd(pmd, desc, include_block);
-    }
-    auto &include_status = std::get<2>(cache_tuple);
-    if (include_status.size() != include_block.size())
-      return BuildAndAdd(pmd, desc, include_block);
-    for (int i = 0; i < include_block.size(); ++i) {
-      if (include_status[i] != include_block[i])
-        return BuildAndAdd(pmd, desc, include_block);
-    }
-    // Cached version is not stale, so just return a reference to it
-    return std::get<0>(cache_tuple);
+  auto it = Find(desc);
+  if (it == pack_map.end()) return BuildAndAdd(pmd, desc, include_block, it);
+  auto &entry = it->second;
+  if (entry.alloc_status != SparsePackBase::GetAllocStatus(pmd, include_block) ||
+      entry.include_block != include_block) {
+    return BuildAndAdd(pmd, desc, include_block, it);
   }
-  return BuildAndAdd(pmd, desc, include_block);
+  // Cached version is not stale, so just return a reference to it
+  return entry.pack;
 }
 template SparsePackBase &SparsePackCache::Get<MeshData<Real>>(MeshData<Real> *,
                                                               const PackDescriptor &,
@@ -327,19 +312,24 @@ template SparsePackBase &
 SparsePackCache::Get<MeshBlockData<Real>>(MeshBlockData<Real> *, const PackDescriptor &,
                                           const std::vector<bool> &);
 
+// Replaces the entry it points to, or adds a new one if it is pack_map.end()
 template <class T>
 SparsePackBase &SparsePackCache::BuildAndAdd(T *pmd, const PackDescriptor &desc,
-                                             const std::vector<bool> &include_block) {
-  if (pack_map.count(desc.identifier) > 0) pack_map.erase(desc.identifier);
-  pack_map[desc.identifier] = {SparsePackBase::Build(pmd, desc, include_block),
-                               SparsePackBase::GetAllocStatus(pmd, desc, include_block),
-                               include_block};
-  return std::get<0>(pack_map[desc.identifier]);
+                                             const std::vector<bool> &include_block,
+                                             map_t::iterator it) {
+  if (it == pack_map.end()) it = pack_map.emplace(desc.key, Entry());
+  auto &entry = it->second;
+  entry = {SparsePackBase::Build(pmd, desc, include_block),
+           SparsePackBase::GetAllocStatus(pmd, include_block), include_block,
+           desc.identifier};
+  return entry.pack;
 }
 template SparsePackBase &
 SparsePackCache::BuildAndAdd<MeshData<Real>>(MeshData<Real> *, const PackDescriptor &,
-                                             const std::vector<bool> &);
+                                             const std::vector<bool> &,
+                                             map_t::iterator);
 template SparsePackBase &SparsePackCache::BuildAndAdd<MeshBlockData<Real>>(
-    MeshBlockData<Real> *, const PackDescriptor &, const std::vector<bool> &);
+    MeshBlockData<Real> *, const PackDescriptor &, const std::vector<bool> &,
+    map_t::iterator);
 
 } // namespace parthenon
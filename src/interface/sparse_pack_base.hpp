@@ -14,6 +14,7 @@
 #define INTERFACE_SPARSE_PACK_BASE_HPP_
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <limits>
 #include <map>
@@ -30,6 +31,7 @@
 #include "interface/state_descriptor.hpp"
 #include "interface/variable.hpp"
 #include "interface/variable_state.hpp"
+#include "utils/hash.hpp"
 #include "utils/utils.hpp"
 
 namespace parthenon {
@@ -53,7 +55,8 @@ class SparsePackBase {
  protected:
   friend class SparsePackCache;
 
-  using alloc_t = std::vector<int>;
+  // Number of blocks in the pack and the largest of their allocation epochs
+  using alloc_t = std::pair<int, std::uint64_t>;
   using include_t = std::vector<bool>;
   using pack_t = ParArray3D<ParArray3D<Real, VariableState>>;
   using pack_h_t = typename pack_t::HostMirror;
@@ -73,11 +76,10 @@ class SparsePackBase {
   // Return a map from variable names to pack variable indices
   static SparsePackIdxMap GetIdxMap(const impl::PackDescriptor &desc);
 
-  // Get a list of booleans of the allocation status of every variable in pmd matching the
-  // PackDescriptor desc
+  // Get the allocation status of the blocks in pmd selected by include_block, which
+  // changes whenever a variable on one of them is allocated or deallocated
   template <class T>
-  static alloc_t GetAllocStatus(T *pmd, const impl::PackDescriptor &desc,
-                                const std::vector<bool> &include_block);
+  static alloc_t GetAllocStatus(T *pmd, const std::vector<bool> &include_block);
 
   // Actually build a `SparsePackBase` (i.e. create a view of views, fill on host, and
   // deep copy the view of views to device) from the variables specified in desc contained
@@ -104,7 +106,8 @@ class SparsePackBase {
 // Object for cacheing sparse packs in MeshData and MeshBlockData objects. This
 // handles checking for a pre-existing pack and creating a new SparsePackBase if
 // a cached pack is unavailable. Essentially, this operates as a map from
-// `PackDescriptor` to `SparsePackBase`
+// `PackDescriptor` to `SparsePackBase`, keyed by the hash `PackDescriptor::key`.
+// Descriptors whose hashes collide are told apart by their identifier.
 class SparsePackCache {
  public:
   std::size_t size() const { return pack_map.size(); }
@@ -116,13 +119,23 @@ class SparsePackCache {
   SparsePackBase &Get(T *pmd, const impl::PackDescriptor &desc,
                       const std::vector<bool> &include_block);
 
+  struct Entry {
+    SparsePackBase pack;
+    SparsePackBase::alloc_t alloc_status;
+    SparsePackBase::include_t include_block;
+    std::string identifier;
+  };
+  using map_t = std::unordered_multimap<std::size_t, Entry>;
+
+  // Entry for desc among those with the same key, or pack_map.end() if there is none
+  map_t::iterator Find(const impl::PackDescriptor &desc);
+
   template <class T>
   SparsePackBase &BuildAndAdd(T *pmd, const impl::PackDescriptor &desc,
-                              const std::vector<bool> &include_block);
+                              const std::vector<bool> &include_block,
+                              map_t::iterator it);
 
-  std::unordered_map<std::string, std::tuple<SparsePackBase, SparsePackBase::alloc_t,
-                                             SparsePackBase::include_t>>
-      pack_map;
+  map_t pack_map;
 
   friend class SparsePackBase;
 };
@@ -138,7 +151,7 @@ struct PackDescriptor {
   // default constructor needed for certain use cases
   PackDescriptor()
       : nvar_groups(0), var_group_names({}), var_groups({}), with_fluxes(false),
-        coarse(false), flat(false), identifier("") {}
+        coarse(false), flat(false), identifier(""), key(0) {}
 
   template <class GROUP_t, class SELECTOR_t>
   PackDescriptor(StateDescriptor *psd, const std::vector<GROUP_t> &var_groups_in,
@@ -147,7 +160,7 @@ struct PackDescriptor {
         var_groups(BuildUids(var_groups_in.size(), psd, selector)),
         with_fluxes(options.count(PDOpt::WithFluxes)),
         coarse(options.count(PDOpt::Coarse)), flat(options.count(PDOpt::Flatten)),
-        identifier(GetIdentifier()) {
+        identifier(GetIdentifier()), key(GetKey()) {
     PARTHENON_REQUIRE(!(with_fluxes && coarse),
                       "Probably shouldn't be making a coarse pack with fine fluxes.");
   }
@@ -159,6 +172,8 @@ struct PackDescriptor {
   const bool coarse;
   const bool flat;
   const std::string identifier;
+  // Hash of the contents of identifier, used for fast lookups
+  const std::size_t key;
 
  private:
   std::string GetIdentifier() {
@@ -174,6 +189,18 @@ struct PackDescriptor {
     ident += std::to_string(flat);
     return ident;
   }
+  std::size_t GetKey() const {
+    std::size_t key = 0;
+    for (const auto &vgroup : var_groups) {
+      key = hash_combine(key, vgroup.size());
+      for (const auto &[vid, uid] : vgroup) {
+        key = hash_combine(key, uid);
+      }
+    }
+    key = hash_combine(key, with_fluxes);
+    key = hash_combine(key, coarse);
+    return hash_combine(key, flat);
+  }
   template <class FUNC_t>
   std::vector<PackDescriptor::VariableGroup_t>
   BuildUids(int nvgs, const StateDescriptor *const psd, const FUNC_t &selector) {
@@ -404,13 +404,26 @@ class StateDescriptor {
   }
   Real EstimateTimestep(MeshData<Real> *rc) const {
     if (EstimateTimestepMesh != nullptr) return EstimateTimestepMesh(rc);
+    if (EstimateTimestepMeshDevice != nullptr) {
+      ParArray0D<Real> dt("EstimateTimestep::dt");
+      EstimateTimestepMeshDevice(rc, dt);
+      Real dt_host;
+      Kokkos::deep_copy(dt_host, dt.KokkosView());
+      return dt_host;
+    }
     return std::numeric_limits<Real>::max();
   }
+  void EstimateTimestep(MeshData<Real> *rc, ParArray0D<Real> &dt) const {
+    if (EstimateTimestepMeshDevice != nullptr) return EstimateTimestepMeshDevice(rc, dt);
+  }
 
   AmrTag CheckRefinement(MeshBlockData<Real> *rc) const {
     if (CheckRefinementBlock != nullptr) return CheckRefinementBlock(rc);
     return AmrTag::derefine;
   }
+  void CheckRefinement(MeshData<Real> *rc, ParArray1D<AmrTag> &delta_levels) const {
+    if (CheckRefinementMesh != nullptr) return CheckRefinementMesh(rc, delta_levels);
+  }
 
   void InitNewlyAllocatedVars(MeshData<Real> *rc) const {
     if (InitNewlyAllocatedVarsMesh != nullptr) return InitNewlyAllocatedVarsMesh(rc);
@@ -459,8 +472,17 @@ class StateDescriptor {
 
   std::function<Real(MeshBlockData<Real> *rc)> EstimateTimestepBlock = nullptr;
   std::function<Real(MeshData<Real> *rc)> EstimateTimestepMesh = nullptr;
+  // Sets dt() to the timestep allowed on rc without copying it to the host, e.g. by
+  // reducing into dt with Kokkos::Min<Real, DevMemSpace>. Only used when
+  // EstimateTimestepMesh is not set.
+  std::function<void(MeshData<Real> *rc, ParArray0D<Real> &dt)>
+      EstimateTimestepMeshDevice = nullptr;
 
   std::function<AmrTag(MeshBlockData<Real> *rc)> CheckRefinementBlock = nullptr;
+  // Raises delta_levels(b) to the tag recommended for block b of rc. Takes precedence
+  // over CheckRefinementBlock when tagging a MeshData.
+  std::function<void(MeshData<Real> *rc, ParArray1D<AmrTag> &delta_levels)>
+      CheckRefinementMesh = nullptr;
 
   std::function<void(MeshData<Real> *rc)> InitNewlyAllocatedVarsMesh = nullptr;
   std::function<void(MeshBlockData<Real> *rc)> InitNewlyAllocatedVarsBlock = nullptr;
@@ -21,7 +21,6 @@
 #include "swarm.hpp"
 #include "swarm_default_names.hpp"
 #include "utils/error_checking.hpp"
-#include "utils/sort.hpp"
 
 namespace parthenon {
 
@@ -72,6 +71,7 @@ Swarm::Swarm(const std::string &label, const Metadata &metadata, const int nmax_
       recv_neighbor_index_("recv_neighbor_index_", nmax_pool_),
       recv_buffer_index_("recv_buffer_index_", nmax_pool_),
       num_particles_to_send_("num_particles_to_send_", NMAX_NEIGHBORS),
+      send_offsets_("send_offsets_", NMAX_NEIGHBORS + 1),
       cell_sorted_("cell_sorted_", nmax_pool_), mpiStatus(true) {
   PARTHENON_REQUIRE_THROWS(typeid(Coordinates_t) == typeid(UniformCartesian),
                            "SwarmDeviceContext only supports a uniform Cartesian mesh!");
@@ -84,19 +84,7 @@ Swarm::Swarm(const std::string &label, const Metadata &metadata, const int nmax_
   num_active_ = 0;
   max_active_index_ = inactive_max_active_index;
 
-  // TODO(BRR) Do this in a device kernel?
-  auto mask_h = Kokkos::create_mirror_view(HostMemSpace(), mask_);
-  auto marked_for_removal_h =
-      Kokkos::create_mirror_view(HostMemSpace(), marked_for_removal_);
-
-  for (int n = 0; n < nmax_pool_; n++) {
-    mask_h(n) = false;
-    marked_for_removal_h(n) = false;
-    free_indices_.push_back(n);
-  }
-
-  Kokkos::deep_copy(mask_, mask_h);
-  Kokkos::deep_copy(marked_for_removal_, marked_for_removal_h);
+  // Kokkos initializes mask_ and marked_for_removal_ to false, so all slots are free
 }
 
 void Swarm::Add(const std::vector<std::string> &label_array, const Metadata &metadata) {
@@ -198,16 +186,11 @@ void Swarm::Remove(const std::string &label) {
 
 void Swarm::setPoolMax(const std::int64_t nmax_pool) {
   PARTHENON_REQUIRE(nmax_pool > nmax_pool_, "Must request larger pool size!");
-  std::int64_t n_new_begin = nmax_pool_;
   std::int64_t n_new = nmax_pool - nmax_pool_;
 
   auto pmb = GetBlockPointer();
   auto pm = pmb->pmy_mesh;
 
-  for (std::int64_t n = 0; n < n_new; n++) {
-    free_indices_.push_back(n + n_new_begin);
-  }
-
   // Rely on Kokkos setting the newly added values to false for these arrays
   Kokkos::resize(mask_, nmax_pool);
   Kokkos::resize(marked_for_removal_, nmax_pool);
@@ -252,35 +235,41 @@ NewParticlesContext Swarm::AddEmptyParticles(const int num_to_add) {
   PARTHENON_DEBUG_REQUIRE(num_to_add >= 0, "Cannot add negative numbers of particles!");
 
   if (num_to_add > 0) {
-    while (free_indices_.size() < num_to_add) {
+    while (nmax_pool_ - num_active_ < num_to_add) {
       increasePoolMax();
     }
-
-    // TODO(BRR) Use par_scan on device rather than do this on host
-    auto mask_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), mask_);
-
-    auto block_index_h = block_index_.GetHostMirrorAndCopy();
-
-    auto free_index = free_indices_.begin();
-
-    auto new_indices_h = new_indices_.GetHostMirror();
+    auto pmb = GetBlockPointer();
+
+    // The free slots are exactly those that are not active, compact the lowest
+    // num_to_add of them into new_indices_
+    auto mask = mask_;
+    auto block_index = block_index_;
+    auto new_indices = new_indices_;
+    int num_free = 0;
+    pmb->par_scan(
+        PARTHENON_AUTO_LABEL, 0, nmax_pool_ - 1,
+        KOKKOS_LAMBDA(const int n, int &idx, const bool final) {
+          if (!mask(n)) {
+            if (final && idx < num_to_add) new_indices(idx) = n;
+            idx++;
+          }
+        },
+        num_free);
 
     // Don't bother sanitizing the memory
-    for (int n = 0; n < num_to_add; n++) {
-      mask_h(*free_index) = true;
-      block_index_h(*free_index) = this_block_;
-      max_active_index_ = std::max<int>(max_active_index_, *free_index);
-      new_indices_h(n) = *free_index;
-
-      free_index = free_indices_.erase(free_index);
-    }
-
-    new_indices_.DeepCopy(new_indices_h);
-
+    int max_new_index = inactive_max_active_index;
+    pmb->par_reduce(
+        PARTHENON_AUTO_LABEL, 0, num_to_add - 1,
+        KOKKOS_LAMBDA(const int n, int &lmax) {
+          const int idx = new_indices(n);
+          mask(idx) = true;
+          block_index(idx) = this_block_;
+          lmax = (idx > lmax) ? idx : lmax;
+        },
+        Kokkos::Max<int>(max_new_index));
+
+    max_active_index_ = std::max<int>(max_active_index_, max_new_index);
     num_active_ += num_to_add;
-
-    Kokkos::deep_copy(mask_, mask_h);
-    block_index_.DeepCopy(block_index_h);
     new_indices_max_idx_ = num_to_add - 1;
   } else {
     new_indices_max_idx_ = -1;
@@ -293,86 +282,61 @@ NewParticlesContext Swarm::AddEmptyParticles(const int num_to_add) {
 // No particles removed: nmax_active_index unchanged
 // Particles removed: nmax_active_index is new max active index
 void Swarm::RemoveMarkedParticles() {
-  // TODO(BRR) Use par_scan to do this on device rather than host
-  auto mask_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), mask_);
-  auto marked_for_removal_h =
-      Kokkos::create_mirror_view_and_copy(HostMemSpace(), marked_for_removal_);
-
-  // loop backwards to keep free_indices_ updated correctly
-  for (int n = max_active_index_; n >= 0; n--) {
-    if (mask_h(n)) {
-      if (marked_for_removal_h(n)) {
-        mask_h(n) = false;
-        free_indices_.push_front(n);
-        num_active_ -= 1;
-        if (n == max_active_index_) {
-          max_active_index_ -= 1;
+  auto pmb = GetBlockPointer();
+  auto mask = mask_;
+  auto marked_for_removal = marked_for_removal_;
+
+  int num_removed = 0;
+  int max_active_index = inactive_max_active_index;
+  Kokkos::parallel_reduce(
+      PARTHENON_AUTO_LABEL,
+      Kokkos::RangePolicy<>(pmb->exec_space, 0, max_active_index_ + 1),
+      KOKKOS_LAMBDA(const int n, int &lremoved, int &lmax) {
+        if (mask(n)) {
+          if (marked_for_removal(n)) {
+            mask(n) = false;
+            marked_for_removal(n) = false;
+            lremoved++;
+          } else {
+            lmax = (n > lmax) ? n : lmax;
+          }
         }
-        marked_for_removal_h(n) = false;
-      }
-    }
-  }
+      },
+      Kokkos::Sum<int>(num_removed), Kokkos::Max<int>(max_active_index));
 
-  Kokkos::deep_copy(mask_, mask_h);
-  Kokkos::deep_copy(marked_for_removal_, marked_for_removal_h);
+  num_active_ -= num_removed;
+  max_active_index_ = std::max<int>(max_active_index, inactive_max_active_index);
 }
 
 void Swarm::Defrag() {
   if (GetNumActive() == 0) {
     return;
   }
-  // TODO(BRR) Could this algorithm be more efficient? Does it matter?
-  // Add 1 to convert max index to max number
-  std::int64_t num_free = (max_active_index_ + 1) - num_active_;
   auto pmb = GetBlockPointer();
+  const int num_active = num_active_;
 
-  auto from_to_indices_h = from_to_indices_.GetHostMirror();
-
-  auto mask_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), mask_);
-
-  for (int n = 0; n <= max_active_index_; n++) {
-    from_to_indices_h(n) = unset_index_;
-  }
-
-  std::list<int> new_free_indices;
-
-  free_indices_.sort();
-
-  int index = max_active_index_;
-  int num_to_move = std::min<int>(num_free, num_active_);
-  for (int n = 0; n < num_to_move; n++) {
-    while (mask_h(index) == false) {
-      index--;
-    }
-    int index_to_move_from = index;
-    index--;
-
-    // Below this number "moved" particles should actually stay in place
-    if (index_to_move_from < num_active_) {
-      break;
-    }
-    int index_to_move_to = free_indices_.front();
-    free_indices_.pop_front();
-    new_free_indices.push_back(index_to_move_from);
-    from_to_indices_h(index_to_move_from) = index_to_move_to;
-  }
-
-  // TODO(BRR) Not all these sorts may be necessary
-  new_free_indices.sort();
-  free_indices_.merge(new_free_indices);
-
-  from_to_indices_.DeepCopy(from_to_indices_h);
-
+  // Stream compaction: the holes below num_active and the active particles at or above
+  // it are compacted (in that order) into from_to_indices_. There are as many of one as
+  // of the other, the highest particle is moved to the lowest hole and so on.
+  auto mask = mask_;
   auto from_to_indices = from_to_indices_;
-
-  auto &mask = mask_;
-  pmb->par_for(
-      PARTHENON_AUTO_LABEL, 0, max_active_index_, KOKKOS_LAMBDA(const int n) {
-        if (from_to_indices(n) >= 0) {
-          mask(from_to_indices(n)) = mask(n);
-          mask(n) = false;
+  int num_compacted = 0;
+  pmb->par_scan(
+      PARTHENON_AUTO_LABEL, 0, max_active_index_,
+      KOKKOS_LAMBDA(const int n, int &idx, const bool final) {
+        if ((n < num_active) != mask(n)) {
+          if (final) from_to_indices(idx) = n;
+          idx++;
         }
-      });
+      },
+      num_compacted);
+  const int num_to_move = num_compacted / 2;
+  PARTHENON_DEBUG_REQUIRE(2 * num_to_move == num_compacted,
+                          "Number of holes and particles to move differ!");
+
+  // Update max_active_index_
+  max_active_index_ = num_active_ - 1;
+  if (num_to_move == 0) return;
 
   auto &int_vector = std::get<getType<int>()>(vectors_);
   auto &real_vector = std::get<getType<Real>()>(vectors_);
@@ -380,27 +344,22 @@ void Swarm::Defrag() {
   PackIndexMap int_imap;
   auto vreal = PackAllVariables_<Real>(real_imap);
   auto vint = PackAllVariables_<int>(int_imap);
-  int real_vars_size = real_vector.size();
-  int int_vars_size = int_vector.size();
-  auto real_map = real_imap.Map();
-  auto int_map = int_imap.Map();
   const int realPackDim = vreal.GetDim(2);
   const int intPackDim = vint.GetDim(2);
 
   pmb->par_for(
-      PARTHENON_AUTO_LABEL, 0, max_active_index_, KOKKOS_LAMBDA(const int n) {
-        if (from_to_indices(n) >= 0) {
-          for (int vidx = 0; vidx < realPackDim; vidx++) {
-            vreal(vidx, from_to_indices(n)) = vreal(vidx, n);
-          }
-          for (int vidx = 0; vidx < intPackDim; vidx++) {
-            vint(vidx, from_to_indices(n)) = vint(vidx, n);
-          }
+      PARTHENON_AUTO_LABEL, 0, num_to_move - 1, KOKKOS_LAMBDA(const int n) {
+        const int to = from_to_indices(n);
+        const int from = from_to_indices(2 * num_to_move - 1 - n);
+        for (int vidx = 0; vidx < realPackDim; vidx++) {
+          vreal(vidx, to) = vreal(vidx, from);
         }
+        for (int vidx = 0; vidx < intPackDim; vidx++) {
+          vint(vidx, to) = vint(vidx, from);
+        }
+        mask(to) = true;
+        mask(from) = false;
       });
-
-  // Update max_active_index_
-  max_active_index_ = num_active_ - 1;
 }
 
 ///
@@ -423,9 +382,7 @@ void Swarm::SortParticlesByCell() {
                     "Too many cells for an int32 to store cell_idx_1d below!");
 
   auto cell_sorted = cell_sorted_;
-  int ncells = pmb->cellbounds.GetTotal(IndexDomain::entire);
-  int num_active = num_active_;
-  int max_active_index = max_active_index_;
+  const int ncells = pmb->cellbounds.GetTotal(IndexDomain::entire);
 
   // Allocate data if necessary
   if (cell_sorted_begin_.GetDim(1) == 0) {
@@ -435,85 +392,56 @@ void Swarm::SortParticlesByCell() {
   auto cell_sorted_begin = cell_sorted_begin_;
   auto cell_sorted_number = cell_sorted_number_;
   auto swarm_d = GetDeviceContext();
+  // Position of each particle within its cell, -1 for particles that are not sorted
+  auto cell_offset = from_to_indices_;
 
-  // Write an unsorted list
-  pmb->par_for(
-      PARTHENON_AUTO_LABEL, 0, max_active_index_, KOKKOS_LAMBDA(const int n) {
-        int i, j, k;
-        swarm_d.Xtoijk(x(n), y(n), z(n), i, j, k);
-        const int64_t cell_idx_1d = i + nx1 * (j + nx2 * k);
-        cell_sorted(n) = SwarmKey(static_cast<int>(cell_idx_1d), n);
-      });
-
-  sort(cell_sorted, SwarmKeyComparator(), 0, max_active_index);
-
-  // Update per-cell arrays for easier accessing later
+  // Counting sort, cell indices are bounded so there is no need for a comparison sort.
+  // The order of particles within a cell is unspecified.
   const IndexRange &ib = pmb->cellbounds.GetBoundsI(IndexDomain::entire);
   const IndexRange &jb = pmb->cellbounds.GetBoundsJ(IndexDomain::entire);
   const IndexRange &kb = pmb->cellbounds.GetBoundsK(IndexDomain::entire);
   pmb->par_for(
       PARTHENON_AUTO_LABEL, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
       KOKKOS_LAMBDA(const int k, const int j, const int i) {
-        int cell_idx_1d = i + nx1 * (j + nx2 * k);
-        // Find starting index, first by guessing
-        int start_index =
-            static_cast<int>((cell_idx_1d * static_cast<Real>(num_active) / ncells));
-        int n = 0;
-        while (true) {
-          n++;
-          // Check if we left the list
-          if (start_index < 0 || start_index > max_active_index) {
-            start_index = -1;
-            break;
-          }
+        cell_sorted_number(k, j, i) = 0;
+      });
 
-          if (cell_sorted(start_index).cell_idx_1d_ == cell_idx_1d) {
-            if (start_index == 0) {
-              break;
-            } else if (cell_sorted(start_index - 1).cell_idx_1d_ != cell_idx_1d) {
-              break;
-            } else {
-              start_index--;
-              continue;
-            }
-          }
-          if (cell_sorted(start_index).cell_idx_1d_ >= cell_idx_1d) {
-            start_index--;
-            if (start_index < 0) {
-              start_index = -1;
-              break;
-            }
-            if (cell_sorted(start_index).cell_idx_1d_ < cell_idx_1d) {
-              start_index = -1;
-              break;
-            }
-            continue;
-          }
-          if (cell_sorted(start_index).cell_idx_1d_ < cell_idx_1d) {
-            start_index++;
-            if (start_index > max_active_index) {
-              start_index = -1;
-              break;
-            }
-            if (cell_sorted(start_index).cell_idx_1d_ > cell_idx_1d) {
-              start_index = -1;
-              break;
-            }
-            continue;
+  // Histogram of active particles over cells
+  pmb->par_for(
+      PARTHENON_AUTO_LABEL, 0, max_active_index_, KOKKOS_LAMBDA(const int n) {
+        cell_offset(n) = -1;
+        if (swarm_d.IsActive(n)) {
+          int i, j, k;
+          swarm_d.Xtoijk(x(n), y(n), z(n), i, j, k);
+          if (i >= 0 && i < nx1 && j >= 0 && j < nx2 && k >= 0 && k < nx3) {
+            cell_offset(n) = Kokkos::atomic_fetch_add(&cell_sorted_number(k, j, i), 1);
           }
         }
-        cell_sorted_begin(k, j, i) = start_index;
-        if (start_index == -1) {
-          cell_sorted_number(k, j, i) = 0;
-        } else {
-          int number = 0;
-          int current_index = start_index;
-          while (current_index <= max_active_index &&
-                 cell_sorted(current_index).cell_idx_1d_ == cell_idx_1d) {
-            current_index++;
-            number++;
-            cell_sorted_number(k, j, i) = number;
-          }
+      });
+
+  // Exclusive scan of the histogram gives the first index of each cell
+  int num_sorted = 0;
+  pmb->par_scan(
+      PARTHENON_AUTO_LABEL, 0, ncells - 1,
+      KOKKOS_LAMBDA(const int cell_idx_1d, int &idx, const bool final) {
+        const int i = cell_idx_1d % nx1;
+        const int j = (cell_idx_1d / nx1) % nx2;
+        const int k = cell_idx_1d / (nx1 * nx2);
+        const int number = cell_sorted_number(k, j, i);
+        if (final) cell_sorted_begin(k, j, i) = (number > 0) ? idx : -1;
+        idx += number;
+      },
+      num_sorted);
+
+  // Scatter the particles into their cells
+  pmb->par_for(
+      PARTHENON_AUTO_LABEL, 0, max_active_index_, KOKKOS_LAMBDA(const int n) {
+        if (cell_offset(n) >= 0) {
+          int i, j, k;
+          swarm_d.Xtoijk(x(n), y(n), z(n), i, j, k);
+          const int cell_idx_1d = i + nx1 * (j + nx2 * k);
+          cell_sorted(cell_sorted_begin(k, j, i) + cell_offset(n)) =
+              SwarmKey(cell_idx_1d, n);
         }
       });
 }
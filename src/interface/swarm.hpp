@@ -19,7 +19,6 @@
 
 #include <array>
 #include <cstdint>
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
@@ -231,10 +230,11 @@ class Swarm {
   int num_particles_sent_;
   bool finished_transport;
 
-  void LoadBuffers_(const int max_indices_size);
+  void LoadBuffers_(const int nsend);
   void UnloadBuffers_();
 
-  int CountParticlesToSend_(); // Must be public for launching kernel
+  // Returns the total number of particles to send, must be public for launching kernel
+  int CountParticlesToSend_();
 
   template <typename T>
   const auto &GetVariableVector() const {
@@ -273,7 +273,6 @@ class Swarm {
 
   std::tuple<MapToParticle<int>, MapToParticle<Real>> maps_;
 
-  std::list<int> free_indices_;
   ParArray1D<bool> mask_;
   ParArray1D<bool> marked_for_removal_;
   ParArrayND<int> block_index_; // Neighbor index for each particle. -1 for current block.
@@ -282,8 +281,8 @@ class Swarm {
   ParArray1D<int> new_indices_;     // Persistent array that provides the new indices when
                                     // AddEmptyParticles is called. Always defragmented.
   int new_indices_max_idx_;         // Maximum valid index of new_indices_ array.
-  ParArray1D<int> from_to_indices_; // Array used for sorting particles during defragment
-                                    // step (size nmax_pool + 1).
+  ParArray1D<int> from_to_indices_; // Scratch space for the defragment step and for
+                                    // sorting by cell (size nmax_pool + 1).
   ParArray1D<int> recv_neighbor_index_; // Neighbor indices for received particles
   ParArray1D<int> recv_buffer_index_;   // Buffer indices for received particles
 
@@ -292,7 +291,9 @@ class Swarm {
   constexpr static int unset_index_ = -1;
 
   ParArray1D<int> num_particles_to_send_;
-  ParArrayND<int> particle_indices_to_send_;
+  ParArray1D<int> send_offsets_; // Start of each neighbor in particle_indices_to_send_
+  ParArray1D<int> particle_indices_to_send_; // Ordered by neighbor, then index
+  ParArray1D<int> send_candidates_;          // Indices of all particles leaving the block
 
   std::vector<int> neighbor_received_particles_;
   int total_received_particles_;
@@ -303,7 +304,8 @@ class Swarm {
       cell_sorted_; // 1D per-cell sorted array of key-value swarm memory indices
 
   ParArrayND<int>
-      cell_sorted_begin_; // Per-cell array of starting indices in cell_sorted_
+      cell_sorted_begin_; // Per-cell array of starting indices in cell_sorted_, -1
+                          // for empty cells
 
   ParArrayND<int>
       cell_sorted_number_; // Per-cell array of number of particles in each cell
@@ -189,91 +189,92 @@ void Swarm::SetupPersistentMPI() {
 }
 
 int Swarm::CountParticlesToSend_() {
-  auto mask_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), mask_);
   auto swarm_d = GetDeviceContext();
   auto pmb = GetBlockPointer();
-  const int nbmax = vbswarm->bd_var_.nbmax;
-
-  // Fence to make sure particles aren't currently being transported locally
-  // TODO(BRR) do this operation on device.
-  pmb->exec_space.fence();
-  auto num_particles_to_send_h = num_particles_to_send_.GetHostMirror();
-  for (int n = 0; n < pmb->neighbors.size(); n++) {
-    num_particles_to_send_h(n) = 0;
-  }
+  const int nneighbor = pmb->neighbors.size();
   const int particle_size = GetParticleDataSize();
   vbswarm->particle_size = particle_size;
 
-  // TODO(BRR) This kernel launch should be folded into the subsequent logic once we
-  // convert that to kernel-based reductions
+  // Persistent storage for the indices of all particles leaving the block
+  if (send_candidates_.extent_int(0) < nmax_pool_) {
+    send_candidates_ = ParArray1D<int>("send_candidates_", nmax_pool_);
+  }
+
+  // Find the neighbor each active particle lives on and compact the indices of the
+  // particles that are on a neighbor in order of their index. The block index is a
+  // pure function of the particle position, so it is fine that the scan may evaluate
+  // it more than once per particle.
   auto &x = Get<Real>(swarm_position::x::name()).Get();
   auto &y = Get<Real>(swarm_position::y::name()).Get();
   auto &z = Get<Real>(swarm_position::z::name()).Get();
-  const int max_active_index = GetMaxActiveIndex();
-  pmb->par_for(
-      PARTHENON_AUTO_LABEL, 0, max_active_index, KOKKOS_LAMBDA(const int n) {
+  auto block_index = block_index_;
+  auto send_candidates = send_candidates_;
+  int nsend = 0;
+  pmb->par_scan(
+      PARTHENON_AUTO_LABEL, 0, max_active_index_,
+      KOKKOS_LAMBDA(const int n, int &idx, const bool final) {
         if (swarm_d.IsActive(n)) {
           bool on_current_mesh_block = true;
-          swarm_d.GetNeighborBlockIndex(n, x(n), y(n), z(n), on_current_mesh_block);
+          if (swarm_d.GetNeighborBlockIndex(n, x(n), y(n), z(n),
+                                            on_current_mesh_block) >= 0) {
+            if (final) send_candidates(idx) = n;
+            idx++;
+          }
         }
-      });
+      },
+      nsend);
 
-  int max_indices_size = 0;
-  int total_noblock_particles = 0;
-  auto block_index_h = block_index_.GetHostMirrorAndCopy();
-  for (int n = 0; n <= max_active_index_; n++) {
-    if (mask_h(n)) {
-      // This particle should be sent
-      if (block_index_h(n) >= 0) {
-        num_particles_to_send_h(block_index_h(n))++;
-        if (max_indices_size < num_particles_to_send_h(block_index_h(n))) {
-          max_indices_size = num_particles_to_send_h(block_index_h(n));
-        }
-      }
-      if (block_index_h(n) == no_block_) {
-        total_noblock_particles++;
-      }
-    }
-  }
-  // Size-0 arrays not permitted but we don't want to short-circuit subsequent logic
-  // that indicates completed communications
-  max_indices_size = std::max<int>(1, max_indices_size);
-
-  // Not a ragged-right array, just for convenience
-  if (total_noblock_particles > 0) {
-    auto noblock_indices =
-        ParArray1D<int>("Particles with no block", total_noblock_particles);
-    auto noblock_indices_h = noblock_indices.GetHostMirror();
-    int counter = 0;
-    for (int n = 0; n <= max_active_index_; n++) {
-      if (mask_h(n)) {
-        if (block_index_h(n) == no_block_) {
-          noblock_indices_h(counter) = n;
-          counter++;
-        }
-      }
-    }
-    noblock_indices.DeepCopy(noblock_indices_h);
+  if (particle_indices_to_send_.extent_int(0) < nsend) {
+    particle_indices_to_send_ = ParArray1D<int>("Particle indices to send", nsend);
   }
 
-  // TODO(BRR) don't allocate dynamically
-  particle_indices_to_send_ =
-      ParArrayND<int>("Particle indices to send", nbmax, max_indices_size);
-  auto particle_indices_to_send_h = particle_indices_to_send_.GetHostMirror();
-  std::vector<int> counter(nbmax, 0);
-  for (int n = 0; n <= max_active_index_; n++) {
-    if (mask_h(n)) {
-      if (block_index_h(n) >= 0) {
-        particle_indices_to_send_h(block_index_h(n), counter[block_index_h(n)]) = n;
-        counter[block_index_h(n)]++;
-      }
-    }
+  // Counting sort of the compacted indices by neighbor, one team per neighbor. Every
+  // team counts its particles, and after the offsets of all neighbors are known, it
+  // scans the compacted list again to place them. Particles sent to the same neighbor
+  // stay ordered by index, so the contents of the buffers are deterministic.
+  auto num_particles_to_send = num_particles_to_send_;
+  pmb->par_for_outer(
+      PARTHENON_AUTO_LABEL, 0, 0, 0, nneighbor - 1,
+      KOKKOS_LAMBDA(team_mbr_t member, const int m) {
+        int count = 0;
+        Kokkos::parallel_reduce(
+            Kokkos::TeamThreadRange(member, nsend),
+            [&](const int i, int &lcount) {
+              lcount += (block_index(send_candidates(i)) == m);
+            },
+            count);
+        Kokkos::single(Kokkos::PerTeam(member),
+                       [&]() { num_particles_to_send(m) = count; });
+      });
+
+  // The counts are needed on host to size the buffers, this is the only (small) copy
+  auto num_particles_to_send_h =
+      Kokkos::create_mirror_view_and_copy(HostMemSpace(), num_particles_to_send_);
+  auto send_offsets_h = send_offsets_.GetHostMirror();
+  send_offsets_h(0) = 0;
+  for (int m = 0; m < nneighbor; m++) {
+    send_offsets_h(m + 1) = send_offsets_h(m) + num_particles_to_send_h(m);
   }
-  num_particles_to_send_.DeepCopy(num_particles_to_send_h);
-  particle_indices_to_send_.DeepCopy(particle_indices_to_send_h);
+  send_offsets_.DeepCopy(send_offsets_h);
+
+  auto send_offsets = send_offsets_;
+  auto particle_indices_to_send = particle_indices_to_send_;
+  pmb->par_for_outer(
+      PARTHENON_AUTO_LABEL, 0, 0, 0, nneighbor - 1,
+      KOKKOS_LAMBDA(team_mbr_t member, const int m) {
+        const int offset = send_offsets(m);
+        Kokkos::parallel_scan(Kokkos::TeamThreadRange(member, nsend),
+                              [&](const int i, int &pos, const bool final) {
+                                const int n = send_candidates(i);
+                                if (block_index(n) == m) {
+                                  if (final) particle_indices_to_send(offset + pos) = n;
+                                  pos++;
+                                }
+                              });
+      });
 
   num_particles_sent_ = 0;
-  for (int n = 0; n < pmb->neighbors.size(); n++) {
+  for (int n = 0; n < nneighbor; n++) {
     // Resize buffer if too small
     const int bufid = pmb->neighbors[n].bufid;
     auto sendbuf = vbswarm->bd_var_.send[bufid];
@@ -285,17 +286,14 @@ int Swarm::CountParticlesToSend_() {
     num_particles_sent_ += num_particles_to_send_h(n);
   }
 
-  return max_indices_size;
+  return nsend;
 }
 
-void Swarm::LoadBuffers_(const int max_indices_size) {
+void Swarm::LoadBuffers_(const int nsend) {
   auto swarm_d = GetDeviceContext();
   auto pmb = GetBlockPointer();
   const int particle_size = GetParticleDataSize();
-  const int nneighbor = pmb->neighbors.size();
 
-  auto &int_vector = std::get<getType<int>()>(vectors_);
-  auto &real_vector = std::get<getType<Real>()>(vectors_);
   PackIndexMap real_imap;
   PackIndexMap int_imap;
   auto vreal = PackAllVariables_<Real>(real_imap);
@@ -307,27 +305,24 @@ void Swarm::LoadBuffers_(const int max_indices_size) {
   // [variable start] [swarm idx]
 
   auto &bdvar = vbswarm->bd_var_;
-  auto num_particles_to_send = num_particles_to_send_;
+  auto block_index = block_index_;
+  auto send_offsets = send_offsets_;
   auto particle_indices_to_send = particle_indices_to_send_;
   auto neighbor_buffer_index = neighbor_buffer_index_;
   pmb->par_for(
-      PARTHENON_AUTO_LABEL, 0, max_indices_size - 1,
-      KOKKOS_LAMBDA(const int n) {            // Max index
-        for (int m = 0; m < nneighbor; m++) { // Number of neighbors
-          const int bufid = neighbor_buffer_index(m);
-          if (n < num_particles_to_send(m)) {
-            const int sidx = particle_indices_to_send(m, n);
-            int buffer_index = n * particle_size;
-            swarm_d.MarkParticleForRemoval(sidx);
-            for (int i = 0; i < realPackDim; i++) {
-              bdvar.send[bufid](buffer_index) = vreal(i, sidx);
-              buffer_index++;
-            }
-            for (int i = 0; i < intPackDim; i++) {
-              bdvar.send[bufid](buffer_index) = static_cast<Real>(vint(i, sidx));
-              buffer_index++;
-            }
-          }
+      PARTHENON_AUTO_LABEL, 0, nsend - 1, KOKKOS_LAMBDA(const int n) {
+        const int sidx = particle_indices_to_send(n);
+        const int m = block_index(sidx);
+        const int bufid = neighbor_buffer_index(m);
+        int buffer_index = (n - send_offsets(m)) * particle_size;
+        swarm_d.MarkParticleForRemoval(sidx);
+        for (int i = 0; i < realPackDim; i++) {
+          bdvar.send[bufid](buffer_index) = vreal(i, sidx);
+          buffer_index++;
+        }
+        for (int i = 0; i < intPackDim; i++) {
+          bdvar.send[bufid](buffer_index) = static_cast<Real>(vint(i, sidx));
+          buffer_index++;
         }
       });
 
@@ -373,10 +368,10 @@ void Swarm::Send(BoundaryCommSubset phase) {
     }
   } else {
     // Query particles for those to be sent
-    int max_indices_size = CountParticlesToSend_();
+    const int nsend = CountParticlesToSend_();
 
     // Prepare buffers for send operations
-    LoadBuffers_(max_indices_size);
+    LoadBuffers_(nsend);
 
     // Send buffer data
     vbswarm->Send(phase);
@@ -0,0 +1,83 @@
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#ifndef INTERFACE_TIMESTEP_REDUCTION_HPP_
+#define INTERFACE_TIMESTEP_REDUCTION_HPP_
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+#include "basic_types.hpp"
+#include "kokkos_abstraction.hpp"
+#include "utils/error_checking.hpp"
+#include "utils/reductions.hpp"
+
+namespace parthenon {
+
+// Mesh wide minimum of the allowed timestep. The packs of all partitions lower a single
+// device scalar (see Update::EstimateTimestepDevice), which is copied to the host once
+// all of them are done and then reduced over ranks without blocking (see
+// Update::StartTimestepReduction). The result is picked up by the driver when it sets
+// the timestep of the next cycle.
+class TimestepReduction {
+ public:
+  // Device scalar holding the minimum over all packs estimated so far
+  const ParArray0D<Real> &DeviceMin() {
+    if (!dt_device_.KokkosView().is_allocated()) {
+      dt_device_ = ParArray0D<Real>("TimestepReduction::dt_device");
+      Kokkos::deep_copy(dt_device_.KokkosView(), std::numeric_limits<Real>::max());
+    }
+    return dt_device_;
+  }
+
+  // Brings the device minimum to the host, combines it with dt_host and starts the
+  // reduction over ranks. The device minimum is reset for the next cycle.
+  void Start(Real dt_host) {
+    Real dt_device = std::numeric_limits<Real>::max();
+    if (dt_device_.KokkosView().is_allocated()) {
+      Kokkos::deep_copy(dt_device, dt_device_.KokkosView());
+      Kokkos::deep_copy(dt_device_.KokkosView(), std::numeric_limits<Real>::max());
+    }
+    if (reduction_ == nullptr) reduction_ = std::make_unique<AllReduce<Real>>();
+    PARTHENON_REQUIRE(!in_flight_, "Timestep reduction started twice");
+    reduction_->val = std::min(dt_host, dt_device);
+    reduction_->StartReduce(MPI_MIN);
+    in_flight_ = true;
+  }
+
+  bool InFlight() const { return in_flight_; }
+
+  // Waits for the reduction over ranks and returns the global minimum
+  Real Wait() {
+    PARTHENON_REQUIRE(in_flight_, "No timestep reduction in flight");
+    while (reduction_->CheckReduce() == TaskStatus::incomplete) {
+    }
+    in_flight_ = false;
+    return reduction_->val;
+  }
+
+  // Completes a reduction in flight without using its result, e.g. because the blocks
+  // it was computed for have changed
+  void Discard() {
+    if (in_flight_) Wait();
+  }
+
+ private:
+  ParArray0D<Real> dt_device_;
+  std::unique_ptr<AllReduce<Real>> reduction_;
+  bool in_flight_ = false;
+};
+
+} // namespace parthenon
+
+#endif // INTERFACE_TIMESTEP_REDUCTION_HPP_
@@ -13,6 +13,8 @@
 
 #include "interface/update.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 
 #include "config.hpp"
@@ -214,6 +216,38 @@ TaskStatus SparseDealloc(MeshData<Real> *md) {
   return TaskStatus::complete;
 }
 
+TaskStatus EstimateTimestepDevice(MeshData<Real> *md) {
+  PARTHENON_INSTRUMENT
+  auto pm = md->GetParentPointer();
+  Real dt_host = std::numeric_limits<Real>::max();
+  for (const auto &pkg : pm->packages.AllPackages()) {
+    const auto &desc = pkg.second;
+    if (desc->EstimateTimestepMesh == nullptr &&
+        desc->EstimateTimestepMeshDevice != nullptr) {
+      auto dt = md->GetDeviceDt();
+      desc->EstimateTimestep(md, dt);
+      auto dt_min = pm->dt_reduction.DeviceMin();
+      par_for(
+          DEFAULT_LOOP_PATTERN, PARTHENON_AUTO_LABEL, DevExecSpace(), 0, 0,
+          KOKKOS_LAMBDA(const int) { Kokkos::atomic_min(&dt_min(), dt()); });
+    } else {
+      dt_host = std::min(dt_host, desc->EstimateTimestep(md));
+    }
+  }
+  md->SetAllowedDt(dt_host);
+  return TaskStatus::complete;
+}
+
+TaskStatus StartTimestepReduction(Mesh *pmesh) {
+  PARTHENON_INSTRUMENT
+  Real dt_host = std::numeric_limits<Real>::max();
+  for (const auto &pmb : pmesh->block_list) {
+    dt_host = std::min(dt_host, pmb->NewDt());
+  }
+  pmesh->dt_reduction.Start(dt_host);
+  return TaskStatus::complete;
+}
+
 } // namespace Update
 
 } // namespace parthenon
@@ -277,6 +277,15 @@ TaskStatus EstimateTimestep(T *rc) {
   return TaskStatus::complete;
 }
 
+// Like EstimateTimestep, but the estimates of packages that provide
+// EstimateTimestepMeshDevice stay on device and are folded into the mesh wide minimum
+// held by Mesh::dt_reduction
+TaskStatus EstimateTimestepDevice(MeshData<Real> *md);
+// Starts the reduction over ranks of the timestep estimated by all blocks on this rank.
+// Must run after the EstimateTimestep* tasks of all partitions have completed. The
+// driver picks up the result in SetGlobalTimeStep.
+TaskStatus StartTimestepReduction(Mesh *pmesh);
+
 template <typename T>
 TaskStatus PreCommFillDerived(T *rc) {
   PARTHENON_INSTRUMENT
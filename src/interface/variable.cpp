@@ -18,6 +18,7 @@
 #include <tuple>
 #include <utility>
 
+#include "globals.hpp"
 #include "interface/metadata.hpp"
 #include "mesh/mesh.hpp"
 #include "mesh/meshblock.hpp"
@@ -76,18 +77,20 @@ void Variable<T>::CopyFluxesAndBdryVar(const Variable<T> *src) {
     // no need to check mesh->multilevel, if false, we're just making a shallow copy of
     // an empty ParArrayND
     coarse_s = src->coarse_s;
+    coarse_arena_ = src->coarse_arena_;
   }
 }
 
 template <typename T>
-std::shared_ptr<Variable<T>> Variable<T>::AllocateCopy(std::weak_ptr<MeshBlock> wpmb) {
+std::shared_ptr<Variable<T>> Variable<T>::AllocateCopy(std::weak_ptr<MeshBlock> wpmb,
+                                                       bool allocate_data) {
   // copy the Metadata
   Metadata m = m_;
 
   // make the new Variable
   auto cv = std::make_shared<Variable<T>>(base_name_, m, sparse_id_, wpmb);
 
-  if (is_allocated_) {
+  if (is_allocated_ && allocate_data) {
     cv->AllocateData(wpmb);
   }
 
@@ -111,6 +114,13 @@ void Variable<T>::AllocateData(MeshBlock *pmb, bool flag_uninitialized) {
   PARTHENON_REQUIRE_THROWS(
       !is_allocated_,
       "Tried to allocate data for variable that's already allocated: " + label());
+  if (auto *pool = StoragePool(pmb)) {
+    pool_ = pool;
+    AllocateFromArena(pmb, pool->Get(label(), DataSize()), 0, no_offset,
+                      flag_uninitialized);
+    pmb->LogMemUsage(data.size() * sizeof(T));
+    return;
+  }
   data = std::make_from_tuple<ParArrayND<T, VariableState>>(std::tuple_cat(
       std::make_tuple(label(), MakeVariableState()), ArrayToReverseTuple(dims_)));
 
@@ -121,6 +131,7 @@ void Variable<T>::AllocateData(MeshBlock *pmb, bool flag_uninitialized) {
 
   if (pmb != nullptr) {
     pmb->LogMemUsage(data.size() * sizeof(T));
+    pmb->UpdateAllocationEpoch();
   }
 }
 template <typename T>
@@ -144,14 +155,91 @@ void Variable<T>::AllocateCoarse(std::weak_ptr<MeshBlock> wpmb) {
     std::shared_ptr<MeshBlock> pmb = wpmb.lock();
 
     if (pmb->pmy_mesh != nullptr && pmb->pmy_mesh->multilevel) {
-      coarse_s = std::make_from_tuple<ParArrayND<T, VariableState>>(
-          std::tuple_cat(std::make_tuple(label() + ".coarse", MakeVariableState()),
-                         ArrayToReverseTuple(coarse_dims_)));
+      if (auto *pool = StoragePool(pmb.get())) {
+        using view_t = typename ParArrayND<T, VariableState>::base_t;
+        pool_ = pool;
+        coarse_arena_ = pool->Get(label() + ".coarse", CoarseSize(pmb.get()));
+        coarse_s = ParArrayND<T, VariableState>(
+            std::make_from_tuple<view_t>(
+                std::tuple_cat(std::make_tuple(coarse_arena_.data()),
+                               ArrayToReverseTuple(coarse_dims_))),
+            MakeVariableState());
+      } else {
+        coarse_s = std::make_from_tuple<ParArrayND<T, VariableState>>(
+            std::tuple_cat(std::make_tuple(label() + ".coarse", MakeVariableState()),
+                           ArrayToReverseTuple(coarse_dims_)));
+      }
       pmb->LogMemUsage(coarse_s.size() * sizeof(T));
     }
   }
 }
 
+template <typename T>
+SizeClassPool<T> *Variable<T>::StoragePool(MeshBlock *pmb) const {
+  if (!IsSparse() || !Globals::sparse_config.pool_storage || pmb == nullptr ||
+      pmb->pmy_mesh == nullptr) {
+    return nullptr;
+  }
+  return &pmb->pmy_mesh->sparse_storage_pool;
+}
+
+template <typename T>
+std::size_t Variable<T>::DataSize() const {
+  std::size_t size = 1;
+  for (const auto d : dims_) {
+    size *= d;
+  }
+  return size;
+}
+
+template <typename T>
+std::size_t Variable<T>::CoarseSize(MeshBlock *pmb) const {
+  if (!(IsSet(Metadata::FillGhost) || IsSet(Metadata::Independent) ||
+        IsSet(Metadata::ForceRemeshComm) || IsSet(Metadata::Flux)) ||
+      pmb == nullptr || pmb->pmy_mesh == nullptr || !pmb->pmy_mesh->multilevel) {
+    return 0;
+  }
+  std::size_t size = 1;
+  for (const auto d : coarse_dims_) {
+    size *= d;
+  }
+  return size;
+}
+
+template <typename T>
+void Variable<T>::AllocateFromArena(MeshBlock *pmb, const ParArray1D<T> &arena,
+                                    std::size_t data_offset, std::size_t coarse_offset,
+                                    bool flag_uninitialized) {
+  PARTHENON_REQUIRE_THROWS(
+      !is_allocated_,
+      "Tried to allocate data for variable that's already allocated: " + label());
+  using view_t = typename ParArrayND<T, VariableState>::base_t;
+  T *base = arena.data();
+
+  PARTHENON_REQUIRE(data_offset + DataSize() <= arena.size(), "Arena is too small");
+  data = ParArrayND<T, VariableState>(
+      std::make_from_tuple<view_t>(std::tuple_cat(std::make_tuple(base + data_offset),
+                                                  ArrayToReverseTuple(dims_))),
+      MakeVariableState());
+  if (coarse_offset != no_offset) {
+    PARTHENON_REQUIRE(coarse_offset + CoarseSize(pmb) <= arena.size(),
+                      "Arena is too small");
+    coarse_s = ParArrayND<T, VariableState>(
+        std::make_from_tuple<view_t>(std::tuple_cat(std::make_tuple(base + coarse_offset),
+                                                    ArrayToReverseTuple(coarse_dims_))),
+        MakeVariableState());
+    coarse_arena_ = arena;
+  }
+  arena_ = arena;
+
+  ++num_alloc_;
+
+  data.initialized = !flag_uninitialized;
+  is_allocated_ = true;
+
+  if (pmb != nullptr) pmb->UpdateAllocationEpoch();
+}
+
 template <typename T>
 std::int64_t Variable<T>::Deallocate() {
   std::int64_t mem_size = 0;
@@ -168,6 +256,15 @@ std::int64_t Variable<T>::Deallocate() {
     mem_size += coarse_s.size() * sizeof(T);
     coarse_s.Reset();
   }
+  if (pool_ != nullptr) {
+    // The pool only takes back arenas no other variable holds on to, a coarse arena
+    // shared with the variable of another stage returns when that one is deallocated
+    pool_->Release(std::exchange(arena_, ParArray1D<T>()));
+    pool_->Release(std::exchange(coarse_arena_, ParArray1D<T>()));
+    pool_ = nullptr;
+  }
+  arena_.Reset();
+  coarse_arena_.Reset();
 
   is_allocated_ = false;
   return mem_size;
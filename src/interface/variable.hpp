@@ -45,6 +45,7 @@
 #include "parthenon_arrays.hpp"
 #include "prolong_restrict/prolong_restrict.hpp"
 #include "utils/error_checking.hpp"
+#include "utils/size_class_pool.hpp"
 #include "utils/unique_id.hpp"
 
 namespace parthenon {
@@ -68,8 +69,10 @@ class Variable {
   // copy fluxes and boundary variable from src Variable (shallow copy)
   void CopyFluxesAndBdryVar(const Variable<T> *src);
 
-  // make a new Variable based on an existing one
-  std::shared_ptr<Variable<T>> AllocateCopy(std::weak_ptr<MeshBlock> wpmb);
+  // make a new Variable based on an existing one, if allocate_data is false the data
+  // of the new variable is left unallocated even if it is allocated in this variable
+  std::shared_ptr<Variable<T>> AllocateCopy(std::weak_ptr<MeshBlock> wpmb,
+                                            bool allocate_data = true);
 
   // accessors
   template <class... Args>
@@ -171,12 +174,35 @@ class Variable {
   /// (Metadata::FillGhost is set)
   void AllocateCoarse(std::weak_ptr<MeshBlock> wpmb);
 
+  // number of elements of the data and of the coarse buffer, the latter is zero if the
+  // variable does not need a coarse buffer on this block
+  std::size_t DataSize() const;
+  std::size_t CoarseSize(MeshBlock *pmb) const;
+
+  // point data (and coarse_s if coarse_offset is valid) into a slab owned by the
+  // MeshBlockData, see MeshBlockData::AllocateArena
+  void AllocateFromArena(MeshBlock *pmb, const ParArray1D<T> &arena,
+                         std::size_t data_offset, std::size_t coarse_offset,
+                         bool flag_uninitialized = false);
+  static constexpr std::size_t no_offset = std::numeric_limits<std::size_t>::max();
+
+  // pool the storage of this variable is taken from, nullptr if it is allocated
+  // directly. Only sparse variables of blocks that belong to a mesh are pooled.
+  SizeClassPool<T> *StoragePool(MeshBlock *pmb) const;
+
   VariableState MakeVariableState() const { return VariableState(m_, sparse_id_, dims_); }
 
   Metadata m_;
   const std::string base_name_;
   const int sparse_id_;
   const std::array<int, MAX_VARIABLE_DIMENSION> dims_, coarse_dims_;
+  // data and coarse_s are unmanaged views if they were allocated from a block arena or
+  // from the sparse storage pool, holding on to the arenas here keeps the memory alive
+  // as long as the variable is. coarse_s may be shared with (and live in the arena of)
+  // another variable.
+  ParArray1D<T> arena_, coarse_arena_;
+  // the arenas are returned here on deallocation if they came from a pool
+  SizeClassPool<T> *pool_ = nullptr;
 
   // Machinery for giving each variable a unique ID that is faster to
   // evaluate than a string. Safe so long as the number of MPI ranks
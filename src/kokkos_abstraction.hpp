@@ -64,6 +64,16 @@ using BufMemSpace = Kokkos::Experimental::HipHostPinnedSpace::memory_space;
 using BufMemSpace = Kokkos::DefaultExecutionSpace::memory_space;
 #endif
 
+// Host memory that the device can copy to and from at full bandwidth, e.g., for staging
+// data that is written to disk
+#if defined(KOKKOS_ENABLE_CUDA)
+using HostPinnedMemSpace = Kokkos::CudaHostPinnedSpace::memory_space;
+#elif defined(KOKKOS_ENABLE_HIP)
+using HostPinnedMemSpace = Kokkos::Experimental::HipHostPinnedSpace::memory_space;
+#else
+using HostPinnedMemSpace = Kokkos::HostSpace;
+#endif
+
 // MPI communication buffers
 template <typename T>
 using BufArray1D = Kokkos::View<T *, LayoutWrapper, BufMemSpace>;
@@ -0,0 +1,97 @@
+//========================================================================================
+// Parthenon performance portable AMR framework
+// Copyright(C) 2024 The Parthenon collaboration
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "interface/mesh_data.hpp"
+#include "interface/meshblock_data.hpp"
+#include "interface/swarm_container.hpp"
+#include "mesh/cost_attribution.hpp"
+#include "mesh/mesh.hpp"
+#include "mesh/meshblock.hpp"
+#include "utils/error_checking.hpp"
+
+namespace parthenon {
+namespace load_balance {
+namespace {
+bool ChargingEnabled(MeshData<Real> *md) {
+  return md != nullptr && md->GetMeshPointer() != nullptr &&
+         md->GetMeshPointer()->AutomaticLoadBalancing();
+}
+
+double BlockWeight(MeshBlock *pmb, CostWeight weight) {
+  switch (weight) {
+  case CostWeight::cells:
+    return pmb->cellbounds.GetTotal(IndexDomain::interior);
+  case CostWeight::particles: {
+    double nparticles = 0.0;
+    const auto &swarm_data = pmb->meshblock_data.Get()->GetSwarmData();
+    for (const auto &swarm : swarm_data->GetSwarmVector()) {
+      nparticles += swarm->GetNumActive();
+    }
+    return nparticles;
+  }
+  default:
+    return 1.0;
+  }
+}
+} // namespace
+
+std::vector<double> BlockWeights(MeshData<Real> *md, CostWeight weight) {
+  const int nblocks = md->NumBlocks();
+  std::vector<double> weights(nblocks);
+  for (int b = 0; b < nblocks; ++b) {
+    weights[b] = BlockWeight(md->GetBlockData(b)->GetBlockPointer(), weight);
+  }
+  if (std::accumulate(weights.begin(), weights.end(), 0.0) <= 0.0) {
+    std::fill(weights.begin(), weights.end(), 1.0);
+  }
+  return weights;
+}
+
+void ChargeCost(MeshData<Real> *md, double cost, CostWeight weight) {
+  if (!ChargingEnabled(md)) return;
+  ChargeCost(md, cost, BlockWeights(md, weight));
+}
+
+void ChargeCost(MeshData<Real> *md, double cost, const std::vector<double> &weights) {
+  if (!ChargingEnabled(md)) return;
+  const int nblocks = md->NumBlocks();
+  PARTHENON_REQUIRE(static_cast<int>(weights.size()) == nblocks,
+                    "Need exactly one weight per block");
+  const double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+  if (total <= 0.0) return;
+  for (int b = 0; b < nblocks; ++b) {
+    md->GetBlockData(b)->GetBlockPointer()->AddCostForLoadBalancing(cost * weights[b] /
+                                                                    total);
+  }
+}
+
+CostTimer::CostTimer(MeshData<Real> *md, CostWeight weight)
+    : md_(md), weight_(weight), running_(ChargingEnabled(md)) {}
+
+void CostTimer::Stop() {
+  if (!running_) return;
+  running_ = false;
+  Kokkos::fence();
+  ChargeCost(md_, timer_.seconds(), weight_);
+}
+} // namespace load_balance
+} // namespace parthenon
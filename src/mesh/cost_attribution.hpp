@@ -0,0 +1,79 @@
+//========================================================================================
+// Parthenon performance portable AMR framework
+// Copyright(C) 2024 The Parthenon collaboration
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#ifndef MESH_COST_ATTRIBUTION_HPP_
+#define MESH_COST_ATTRIBUTION_HPP_
+
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+#include "basic_types.hpp"
+
+namespace parthenon {
+template <typename T>
+class MeshData;
+
+namespace load_balance {
+// Cost attribution for automatic load balancing (<parthenon/loadbalancing>/balancer =
+// automatic)
+//
+// Tasks usually operate on a whole MeshData partition, so timing them per block is not
+// possible. Instead, the work done by a task on a partition, e.g. its measured run time
+// or the number of solver iterations it took, is charged to the partition and split
+// over its blocks in proportion to a per block weight. The costs charged to a block are
+// accumulated between calls to Mesh::UpdateCostList, which folds them into the costlist
+// used to partition the mesh. Charging cost is a no-op unless automatic load balancing
+// is enabled, so tasks can be instrumented unconditionally.
+enum class CostWeight {
+  uniform,  // every block of the partition is charged the same
+  cells,    // in proportion to the number of interior cells of the block
+  particles // in proportion to the number of active particles in all swarms of the block
+};
+
+// Weight of every block of md. Falls back to uniform weights if all weights vanish,
+// e.g. when weighting by particles on a partition without particles.
+std::vector<double> BlockWeights(MeshData<Real> *md, CostWeight weight);
+
+// Splits cost over the blocks of md in proportion to weight
+void ChargeCost(MeshData<Real> *md, double cost, CostWeight weight = CostWeight::cells);
+// Splits cost over the blocks of md in proportion to weights, which must have one entry
+// per block
+void ChargeCost(MeshData<Real> *md, double cost, const std::vector<double> &weights);
+
+// Measures the wall clock time between construction and Stop() (or destruction) and
+// charges it to the blocks of md. Stop() fences the default execution space so that the
+// time of asynchronously launched kernels is included, which is why the timer only
+// runs if automatic load balancing is enabled.
+class CostTimer {
+ public:
+  explicit CostTimer(MeshData<Real> *md, CostWeight weight = CostWeight::cells);
+  ~CostTimer() { Stop(); }
+  CostTimer(const CostTimer &) = delete;
+  CostTimer &operator=(const CostTimer &) = delete;
+
+  void Stop();
+
+ private:
+  MeshData<Real> *md_;
+  CostWeight weight_;
+  bool running_;
+  Kokkos::Timer timer_;
+};
+} // namespace load_balance
+} // namespace parthenon
+
+#endif // MESH_COST_ATTRIBUTION_HPP_
@@ -75,6 +75,16 @@ enum class IndexDomain {
   outer_x3
 };
 
+//! \struct IndexBox
+//  \brief Three dimensional box of indices, e.g. the part of the interior that can be
+//  updated before ghost zones have been received (see IndexShape::GetCoreBox)
+struct IndexBox {
+  IndexRange k, j, i;
+
+  KOKKOS_INLINE_FUNCTION
+  bool empty() const noexcept { return k.e < k.s || j.e < j.s || i.e < i.s; }
+};
+
 //! \class IndexVolume
 //  \brief Defines the dimensions of a shape of indices
 //
@@ -89,6 +99,16 @@ class IndexShape {
     return dim <= interior_dims.size();
   }
 
+  // An empty core starts at r.s, so that the lower shell slab is empty and the upper one
+  // holds all of r
+  KOKKOS_INLINE_FUNCTION
+  static IndexRange Shrink_(const IndexRange &r, const int entire_ncells,
+                            const int width) {
+    if (entire_ncells == 1) return r;
+    if (r.e - r.s + 1 <= 2 * width) return {r.s, r.s - 1};
+    return {r.s + width, r.e - width};
+  }
+
   KOKKOS_INLINE_FUNCTION
   void MakeZeroDimensional_(int const index) {
     x_[index] = IndexRange{0, 0};
@@ -279,6 +299,51 @@ class IndexShape {
     return ke(domain, el) - ks(domain, el) + 1;
   }
 
+  KOKKOS_INLINE_FUNCTION IndexBox GetBox(const IndexDomain &domain,
+                                         TE el = TE::CC) const noexcept {
+    return {GetBoundsK(domain, el), GetBoundsJ(domain, el), GetBoundsI(domain, el)};
+  }
+
+  // Interior indices that are at least width cells away from the ghost zones, so that a
+  // stencil of half width width around them only reads interior data. Dimensions without
+  // ghost zones are not shrunk, and the range is empty (e < s) if the block is too small.
+  KOKKOS_INLINE_FUNCTION const IndexRange GetCoreBoundsI(const int width,
+                                                         TE el = TE::CC) const noexcept {
+    return Shrink_(GetBoundsI(IndexDomain::interior, el), entire_ncells_[0], width);
+  }
+
+  KOKKOS_INLINE_FUNCTION const IndexRange GetCoreBoundsJ(const int width,
+                                                         TE el = TE::CC) const noexcept {
+    return Shrink_(GetBoundsJ(IndexDomain::interior, el), entire_ncells_[1], width);
+  }
+
+  KOKKOS_INLINE_FUNCTION const IndexRange GetCoreBoundsK(const int width,
+                                                         TE el = TE::CC) const noexcept {
+    return Shrink_(GetBoundsK(IndexDomain::interior, el), entire_ncells_[2], width);
+  }
+
+  KOKKOS_INLINE_FUNCTION IndexBox GetCoreBox(const int width,
+                                             TE el = TE::CC) const noexcept {
+    return {GetCoreBoundsK(width, el), GetCoreBoundsJ(width, el),
+            GetCoreBoundsI(width, el)};
+  }
+
+  // Splits the part of the interior that is not in core, i.e. the boundary shell that
+  // has to wait for ghost zones, into six disjoint slabs: the lower and upper slab in k
+  // spanning the whole interior, in j spanning the core in k, and in i spanning the core
+  // in k and j. core must be contained in the interior, e.g. come from GetCoreBox or be
+  // built from GetCoreBounds* and the interior bounds. Slabs can be empty.
+  KOKKOS_INLINE_FUNCTION std::array<IndexBox, 6>
+  GetShellBoxes(const IndexBox &core, TE el = TE::CC) const noexcept {
+    const IndexBox in = GetBox(IndexDomain::interior, el);
+    return {IndexBox{{in.k.s, core.k.s - 1}, in.j, in.i},
+            IndexBox{{core.k.e + 1, in.k.e}, in.j, in.i},
+            IndexBox{core.k, {in.j.s, core.j.s - 1}, in.i},
+            IndexBox{core.k, {core.j.e + 1, in.j.e}, in.i},
+            IndexBox{core.k, core.j, {in.i.s, core.i.s - 1}},
+            IndexBox{core.k, core.j, {core.i.e + 1, in.i.e}}};
+  }
+
   // Kept basic for kokkos
   KOKKOS_INLINE_FUNCTION
   int GetTotal(const IndexDomain &domain, TE el = TE::CC) const noexcept {
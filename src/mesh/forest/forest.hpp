@@ -194,6 +194,16 @@ class Forest {
 
   std::size_t CountTrees() const { return trees.size(); }
 
+  // Internal nodes of all trees in the order of their gids
+  std::vector<LogicalLocation> GetSortedInternalNodeList() const {
+    std::vector<LogicalLocation> out;
+    for (auto &[id, tree] : trees) {
+      auto tree_int_locs = tree->GetSortedInternalNodeList();
+      out.insert(out.end(), tree_int_locs.begin(), tree_int_locs.end());
+    }
+    return out;
+  }
+
   std::int64_t GetGid(const LogicalLocation &loc) const {
     PARTHENON_REQUIRE(gids_resolved, "Asking for GID in invalid state.");
     return trees.at(loc.tree())->GetGid(loc);
@@ -0,0 +1,280 @@
+//========================================================================================
+// Parthenon performance portable AMR framework
+// Copyright(C) 2024 The Parthenon collaboration
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mesh/load_balance.hpp"
+#include "utils/error_checking.hpp"
+
+namespace parthenon {
+namespace load_balance {
+namespace {
+// Prefix sums of the cost list, the cost of blocks [a, b) is prefix[b] - prefix[a].
+// All chunk costs are computed as such a difference so that comparisons between
+// different chunks are consistent, which is what makes the search below exact.
+class ChunkCosts {
+ public:
+  explicit ChunkCosts(const std::vector<double> &costlist)
+      : prefix_(costlist.size() + 1, 0.0) {
+    std::partial_sum(costlist.begin(), costlist.end(), prefix_.begin() + 1);
+  }
+
+  int NumBlocks() const { return prefix_.size() - 1; }
+  double operator()(int a, int b) const { return prefix_[b] - prefix_[a]; }
+
+  // Largest b in [a, n] such that the chunk [a, b) costs at most bound
+  int LastEnd(int a, double bound) const {
+    int lo = a, hi = NumBlocks();
+    while (lo < hi) {
+      const int mid = hi - (hi - lo) / 2;
+      if ((*this)(a, mid) <= bound) {
+        lo = mid;
+      } else {
+        hi = mid - 1;
+      }
+    }
+    return lo;
+  }
+
+  // Smallest a in [lower, b] such that the chunk [a, b) costs at most bound
+  int FirstStart(int lower, int b, double bound) const {
+    int lo = lower, hi = b;
+    while (lo < hi) {
+      const int mid = lo + (hi - lo) / 2;
+      if ((*this)(mid, b) <= bound) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    return lo;
+  }
+
+  // Tries to cover all blocks with at most nranks chunks each costing at most bound by
+  // making every chunk as large as possible. On success, bottleneck is set to the cost
+  // of the most expensive chunk, which is a feasible bound no larger than bound.
+  bool Probe(double bound, int nranks, double &bottleneck) const {
+    const int n = NumBlocks();
+    bottleneck = 0.0;
+    int start = 0;
+    for (int r = 0; r < nranks && start < n; ++r) {
+      const int end = LastEnd(start, bound);
+      if (end == start) return false;
+      bottleneck = std::max(bottleneck, (*this)(start, end));
+      start = end;
+    }
+    return start == n;
+  }
+
+ private:
+  std::vector<double> prefix_;
+};
+
+// Assigns one block per rank to the highest ranks when there are fewer blocks than
+// ranks, which matches what the greedy partitioner does in that case
+void OneBlockPerRank(int nblocks, int nranks, std::vector<int> &ranklist) {
+  ranklist.resize(nblocks);
+  for (int b = 0; b < nblocks; ++b) {
+    ranklist[b] = b + nranks - nblocks;
+  }
+}
+
+// Fills ranklist from the positions of the first block of each rank
+void CutsToRanks(const std::vector<int> &cuts, std::vector<int> &ranklist) {
+  const int nranks = cuts.size() - 1;
+  ranklist.resize(cuts.back());
+  for (int r = 0; r < nranks; ++r) {
+    std::fill(ranklist.begin() + cuts[r], ranklist.begin() + cuts[r + 1], r);
+  }
+}
+
+double Bottleneck(const ChunkCosts &cost, int nranks) {
+  const int n = cost.NumBlocks();
+  double bottleneck;
+  // A zero bound is only feasible if all costs vanish
+  if (n == 0 || cost.Probe(0.0, nranks, bottleneck)) return 0.0;
+  double lo = 0.0;
+  double hi = cost(0, n);
+  // Bisect on the bound, snapping the upper end to the cost of an actual chunk after
+  // every successful probe. Since feasibility is monotonic in the bound, the loop ends
+  // with lo infeasible and hi the smallest feasible chunk cost.
+  while (true) {
+    const double mid = lo + 0.5 * (hi - lo);
+    if (mid <= lo || mid >= hi) break;
+    if (cost.Probe(mid, nranks, bottleneck)) {
+      hi = bottleneck;
+    } else {
+      lo = mid;
+    }
+  }
+  return hi;
+}
+
+// Positions of the first block of each rank (plus the number of blocks at the end) of a
+// partition in which every chunk costs at most bound. Chunks are made as large as
+// possible starting from the highest rank, so that rank 0 tends to receive less work,
+// while leaving at least one block for each of the lower ranks.
+std::vector<int> CutsFromEnd(const ChunkCosts &cost, int nranks, double bound) {
+  std::vector<int> cuts(nranks + 1, 0);
+  cuts[nranks] = cost.NumBlocks();
+  for (int r = nranks - 1; r > 0; --r) {
+    const int end = cuts[r + 1];
+    cuts[r] = std::min(cost.FirstStart(r, end, bound), end - 1);
+  }
+  return cuts;
+}
+} // namespace
+
+Partitioner GetPartitioner(const std::string &name) {
+  if (name == "greedy") return Partitioner::greedy;
+  if (name == "chains_on_chains") return Partitioner::chains_on_chains;
+  if (name == "migration_aware") return Partitioner::migration_aware;
+  PARTHENON_FAIL("Unknown load balancing partitioner " + name);
+  return Partitioner::greedy;
+}
+
+void GreedyPartition(const std::vector<double> &costlist, int nranks,
+                     std::vector<int> &ranklist) {
+  ranklist.resize(costlist.size());
+
+  double const total_cost = std::accumulate(costlist.begin(), costlist.end(), 0.0);
+
+  int rank = nranks - 1;
+  double target_cost = total_cost / nranks;
+  double my_cost = 0.0;
+  double remaining_cost = total_cost;
+  // create rank list from the end: the master MPI rank should have less load
+  for (int block_id = costlist.size() - 1; block_id >= 0; block_id--) {
+    if (target_cost == 0.0) {
+      std::stringstream msg;
+      msg << "### FATAL ERROR in CalculateLoadBalance" << std::endl
+          << "There is at least one process which has no MeshBlock" << std::endl
+          << "Decrease the number of processes or use smaller MeshBlocks." << std::endl;
+      PARTHENON_FAIL(msg);
+    }
+    my_cost += costlist[block_id];
+    ranklist[block_id] = rank;
+    if (my_cost >= target_cost && rank > 0) {
+      rank--;
+      remaining_cost -= my_cost;
+      my_cost = 0.0;
+      target_cost = remaining_cost / (rank + 1);
+    }
+  }
+}
+
+double OptimalBottleneck(const std::vector<double> &costlist, int nranks) {
+  return Bottleneck(ChunkCosts(costlist), nranks);
+}
+
+void ChainsOnChainsPartition(const std::vector<double> &costlist, int nranks,
+                             std::vector<int> &ranklist) {
+  const int n = costlist.size();
+  if (n < nranks) {
+    OneBlockPerRank(n, nranks, ranklist);
+    return;
+  }
+  ChunkCosts cost(costlist);
+  CutsToRanks(CutsFromEnd(cost, nranks, Bottleneck(cost, nranks)), ranklist);
+}
+
+void MigrationAwarePartition(const std::vector<double> &costlist,
+                             const std::vector<int> &current_ranks, int nranks,
+                             double tolerance, std::vector<int> &ranklist) {
+  const int n = costlist.size();
+  if (current_ranks.size() != n || n < nranks) {
+    ChainsOnChainsPartition(costlist, nranks, ranklist);
+    return;
+  }
+
+  ChunkCosts cost(costlist);
+  const double bound = (1.0 + tolerance) * Bottleneck(cost, nranks);
+
+  // Current position of the first block of each rank
+  std::vector<int> current(nranks + 1, 0);
+  for (const int rank : current_ranks) {
+    current[std::min(std::max(rank, 0), nranks - 1) + 1]++;
+  }
+  std::partial_sum(current.begin(), current.end(), current.begin());
+
+  // Smallest position of the first block of each rank for which the remaining blocks
+  // still fit on the remaining ranks
+  std::vector<int> lower(nranks + 1, 0);
+  lower[nranks] = n;
+  for (int r = nranks - 1; r > 0; --r) {
+    lower[r] = cost.FirstStart(0, lower[r + 1], bound);
+  }
+
+  // Walk the ranks in order, placing the first block of each as close as possible to
+  // where the current first block of that rank is, subject to the previous chunk not
+  // exceeding the bound, the remaining blocks fitting on the remaining ranks, and every
+  // rank receiving at least one block.
+  std::vector<int> cuts(nranks + 1, 0);
+  cuts[nranks] = n;
+  for (int r = 1; r < nranks; ++r) {
+    const int lo = std::max(lower[r], cuts[r - 1] + 1);
+    const int hi = std::min(cost.LastEnd(cuts[r - 1], bound), n - (nranks - r));
+    cuts[r] = std::max(std::min(current[r], hi), std::min(lo, hi));
+  }
+  CutsToRanks(cuts, ranklist);
+}
+
+PartitionFn_t MakePartitionFn(Partitioner partitioner, double migration_tolerance) {
+  switch (partitioner) {
+  case Partitioner::chains_on_chains:
+    return [](const std::vector<double> &costlist, const std::vector<int> &, int nranks,
+              std::vector<int> &ranklist) {
+      ChainsOnChainsPartition(costlist, nranks, ranklist);
+    };
+  case Partitioner::migration_aware:
+    return [migration_tolerance](const std::vector<double> &costlist,
+                                 const std::vector<int> &current_ranks, int nranks,
+                                 std::vector<int> &ranklist) {
+      MigrationAwarePartition(costlist, current_ranks, nranks, migration_tolerance,
+                              ranklist);
+    };
+  default:
+    return [](const std::vector<double> &costlist, const std::vector<int> &, int nranks,
+              std::vector<int> &ranklist) {
+      GreedyPartition(costlist, nranks, ranklist);
+    };
+  }
+}
+
+std::vector<int> AgglomerateGMGLevel(const std::vector<int> &default_ranks, int nranks,
+                                     int blocks_per_rank, int single_rank_blocks) {
+  const int nblocks = default_ranks.size();
+  int chunk_size = 1;
+  if (single_rank_blocks > 0 && nblocks <= single_rank_blocks) {
+    chunk_size = nblocks;
+  } else if (blocks_per_rank > 0 && nblocks < blocks_per_rank * nranks) {
+    chunk_size = blocks_per_rank;
+  }
+  if (chunk_size <= 1) return default_ranks;
+  // Consecutive chunks of blocks move to the default owner of their first block, so the
+  // set of active ranks shrinks with the level while neighboring blocks stay together
+  std::vector<int> ranks(nblocks);
+  for (int b = 0; b < nblocks; ++b)
+    ranks[b] = default_ranks[(b / chunk_size) * chunk_size];
+  return ranks;
+}
+} // namespace load_balance
+} // namespace parthenon
@@ -0,0 +1,75 @@
+//========================================================================================
+// Parthenon performance portable AMR framework
+// Copyright(C) 2024 The Parthenon collaboration
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#ifndef MESH_LOAD_BALANCE_HPP_
+#define MESH_LOAD_BALANCE_HPP_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace parthenon {
+namespace load_balance {
+// Partitioners split the list of blocks, ordered by global id (i.e. along the space
+// filling curve), into nranks contiguous chunks. On output ranklist[gid] holds the rank
+// the block is assigned to, which must be non-decreasing in gid. current_ranks holds
+// the rank each block currently lives on (for blocks created by refinement this is the
+// rank of their parent) and is empty if the blocks have not been distributed yet.
+using PartitionFn_t =
+    std::function<void(const std::vector<double> &costlist,
+                       const std::vector<int> &current_ranks, int nranks,
+                       std::vector<int> &ranklist)>;
+
+enum class Partitioner { greedy, chains_on_chains, migration_aware };
+Partitioner GetPartitioner(const std::string &name);
+
+// Cuts the cost list from the end whenever the running cost of a rank reaches the
+// average of the remaining cost. This is the historical default.
+void GreedyPartition(const std::vector<double> &costlist, int nranks,
+                     std::vector<int> &ranklist);
+
+// Smallest possible maximum cost over ranks of any partition of costlist into at most
+// nranks contiguous chunks.
+double OptimalBottleneck(const std::vector<double> &costlist, int nranks);
+
+// Partition whose maximum cost over ranks is exactly OptimalBottleneck. Every rank
+// receives at least one block if there are at least as many blocks as ranks.
+void ChainsOnChainsPartition(const std::vector<double> &costlist, int nranks,
+                             std::vector<int> &ranklist);
+
+// Partition whose maximum cost over ranks is at most (1 + tolerance) times the optimal
+// bottleneck, and which otherwise moves the boundary between consecutive ranks as little
+// as possible from where it currently is, reducing the number of blocks that have to
+// be migrated. Reduces to ChainsOnChainsPartition if current_ranks is empty.
+void MigrationAwarePartition(const std::vector<double> &costlist,
+                             const std::vector<int> &current_ranks, int nranks,
+                             double tolerance, std::vector<int> &ranklist);
+
+// Returns the partitioner function corresponding to the enum
+PartitionFn_t MakePartitionFn(Partitioner partitioner, double migration_tolerance);
+
+// Ranks of the blocks of a sparse GMG level, ordered by gid, once the level is gathered
+// onto fewer ranks. default_ranks holds the rank each block lives on otherwise. A level
+// with at most single_rank_blocks blocks moves to a single rank; a level with fewer than
+// blocks_per_rank * nranks blocks is split into chunks of blocks_per_rank consecutive
+// blocks. Each chunk moves to the default rank of its first block. Values <= 0 disable
+// the respective rule, levels to which neither applies keep their default ranks.
+std::vector<int> AgglomerateGMGLevel(const std::vector<int> &default_ranks, int nranks,
+                                     int blocks_per_rank, int single_rank_blocks);
+} // namespace load_balance
+} // namespace parthenon
+
+#endif // MESH_LOAD_BALANCE_HPP_
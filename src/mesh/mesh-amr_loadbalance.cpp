@@ -350,56 +350,17 @@ void Mesh::LoadBalancingAndAdaptiveMeshRefinement(ParameterInput *pin,
 
 // Private routines
 namespace {
-/**
- * @brief This routine assigns blocks to ranks by attempting to place index-contiguous
- * blocks of equal total cost on each rank.
- *
- * @param costlist (Input) A map of global block ID to a relative weight.
- * @param ranklist (Output) A map of global block ID to ranks.
- */
-void AssignBlocks(std::vector<double> const &costlist, std::vector<int> &ranklist) {
-  ranklist.resize(costlist.size());
-
-  double const total_cost = std::accumulate(costlist.begin(), costlist.end(), 0.0);
-
-  int rank = (Globals::nranks)-1;
-  double target_cost = total_cost / Globals::nranks;
-  double my_cost = 0.0;
-  double remaining_cost = total_cost;
-  // create rank list from the end: the master MPI rank should have less load
-  for (int block_id = costlist.size() - 1; block_id >= 0; block_id--) {
-    if (target_cost == 0.0) {
-      std::stringstream msg;
-      msg << "### FATAL ERROR in CalculateLoadBalance" << std::endl
-          << "There is at least one process which has no MeshBlock" << std::endl
-          << "Decrease the number of processes or use smaller MeshBlocks." << std::endl;
-      PARTHENON_FAIL(msg);
-    }
-    my_cost += costlist[block_id];
-    ranklist[block_id] = rank;
-    if (my_cost >= target_cost && rank > 0) {
-      rank--;
-      remaining_cost -= my_cost;
-      my_cost = 0.0;
-      target_cost = remaining_cost / (rank + 1);
-    }
-  }
-}
-
 void UpdateBlockList(std::vector<int> const &ranklist, std::vector<int> &nslist,
                      std::vector<int> &nblist) {
-  nslist.resize(Globals::nranks);
-  nblist.resize(Globals::nranks);
-
-  nslist[0] = 0;
-  int rank = 0;
-  for (int block_id = 1; block_id < ranklist.size(); block_id++) {
-    if (ranklist[block_id] != ranklist[block_id - 1]) {
-      nblist[rank] = block_id - nslist[rank];
-      nslist[++rank] = block_id;
-    }
+  nslist.assign(Globals::nranks, 0);
+  nblist.assign(Globals::nranks, 0);
+
+  for (int block_id = 0; block_id < ranklist.size(); block_id++) {
+    nblist[ranklist[block_id]]++;
+  }
+  for (int rank = 1; rank < Globals::nranks; rank++) {
+    nslist[rank] = nslist[rank - 1] + nblist[rank - 1];
   }
-  nblist[rank] = ranklist.size() - nslist[rank];
 }
 } // namespace
 
@@ -407,7 +368,8 @@ void UpdateBlockList(std::vector<int> const &ranklist, std::vector<int> &nslist,
 // \brief Calculate distribution of MeshBlocks based on the cost list
 void Mesh::CalculateLoadBalance(std::vector<double> const &costlist,
                                 std::vector<int> &ranklist, std::vector<int> &nslist,
-                                std::vector<int> &nblist) {
+                                std::vector<int> &nblist,
+                                std::vector<int> const &current_ranks) {
   PARTHENON_INSTRUMENT
   auto const total_blocks = costlist.size();
 
@@ -417,8 +379,15 @@ void Mesh::CalculateLoadBalance(std::vector<double> const &costlist,
   double const mincost = min_max.first == costlist.begin() ? 0.0 : *min_max.first;
   double const maxcost = min_max.second == costlist.begin() ? 0.0 : *min_max.second;
 
-  // Assigns blocks to ranks on a rougly cost-equal basis.
-  AssignBlocks(costlist, ranklist);
+  // Assigns contiguous chunks of blocks to ranks on a roughly cost-equal basis.
+  PartitionBlocks(costlist, current_ranks, Globals::nranks, ranklist);
+  PARTHENON_REQUIRE(ranklist.size() == total_blocks,
+                    "Partitioner must assign a rank to every block");
+  for (int block_id = 0; block_id < total_blocks; block_id++) {
+    PARTHENON_REQUIRE(ranklist[block_id] >= 0 && ranklist[block_id] < Globals::nranks &&
+                          (block_id == 0 || ranklist[block_id] >= ranklist[block_id - 1]),
+                      "Partitioner must assign blocks to ranks in gid order");
+  }
 
   // Updates nslist with the ID of the starting block on each rank and the count of blocks
   // on each rank.
@@ -478,9 +447,12 @@ void Mesh::ResetLoadBalanceVariables() {
 
 void Mesh::UpdateCostList() {
   if (lb_automatic_) {
+    // Exponentially weighted sum of the cost charged to each block since the last call,
+    // which (for a constant cost) converges to lb_interval_ times the cost per call
     double w = static_cast<double>(lb_interval_ - 1) / static_cast<double>(lb_interval_);
     for (auto &pmb : block_list) {
       costlist[pmb->gid] = costlist[pmb->gid] * w + pmb->cost_;
+      pmb->ResetTimeMeasurement();
     }
   } else if (lb_flag_) {
     for (auto &pmb : block_list) {
@@ -728,8 +700,13 @@ void Mesh::RedistributeAndRefineMeshBlocks(ParameterInput *pin, ApplicationInput
     }
   } // Construct new list region
 
-  // Calculate new load balance
-  CalculateLoadBalance(newcost, newrank, nslist, nblist);
+  // Calculate new load balance, telling the partitioner where the blocks currently
+  // live. Blocks created by refinement count as living with their parent.
+  std::vector<int> currentrank(ntot);
+  for (int n = 0; n < ntot; n++) {
+    currentrank[n] = ranklist[newtoold[n]];
+  }
+  CalculateLoadBalance(newcost, newrank, nslist, nblist, currentrank);
 
   int nbs = nslist[Globals::my_rank];
   int nbe = nbs + nblist[Globals::my_rank] - 1;
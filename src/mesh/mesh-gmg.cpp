@@ -20,11 +20,13 @@
 #include <algorithm>
 #include <cstdint>
 #include <iostream>
+#include <map>
 #include <numeric>
 #include <sstream>
 #include <string>
 #include <tuple>
 #include <unordered_set>
+#include <vector>
 
 #include "parthenon_mpi.hpp"
 
@@ -70,9 +72,11 @@ void Mesh::SetMeshBlockNeighbors(
       auto fn = nloc.origin_loc.GetAthenaXXFaceOffsets(loc, -offsets[0], -offsets[1],
                                                        -offsets[2]);
       int tid = buffer_id.GetID(-offsets[0], -offsets[1], -offsets[2], fn[0], fn[1]);
-      int lgid = forest.GetLeafGid(nloc.global_loc);
-      all_neighbors.emplace_back(pmb->pmy_mesh, nloc.global_loc, nloc.origin_loc,
-                                 ranklist[lgid], gid, offsets, bid, tid, f[0], f[1]);
+      int nrank = grid_id.type == GridType::leaf
+                      ? ranklist[forest.GetLeafGid(nloc.global_loc)]
+                      : GetGMGBlockRank(nloc.global_loc);
+      all_neighbors.emplace_back(pmb->pmy_mesh, nloc.global_loc, nloc.origin_loc, nrank,
+                                 gid, offsets, bid, tid, f[0], f[1]);
 
       // Set neighbor block ownership
       auto &nb = all_neighbors.back();
@@ -118,7 +122,7 @@ void Mesh::BuildGMGBlockLists(ParameterInput *pin, ApplicationInput *app_in) {
     gmg_block_lists[level] = BlockList_t();
   }
 
-  // Fill/create gmg block lists based on this ranks block list
+  // Add the leaf blocks of this rank to the gmg block lists
   for (auto &pmb : block_list) {
     const int level = pmb->loc.level();
     // Add the leaf block to its level
@@ -128,20 +132,23 @@ void Mesh::BuildGMGBlockLists(ParameterInput *pin, ApplicationInput *app_in) {
     if (level < current_level) {
       gmg_block_lists[level + 1].push_back(pmb);
     }
+  }
 
-    // Create internal blocks that share a Morton number with this block
-    // and add them to gmg two-level composite grid block lists. This
-    // determines which process internal blocks live on
-    auto loc = pmb->loc.GetParent();
-    while (loc.level() >= gmg_min_level && loc.morton() == pmb->loc.morton()) {
-      RegionSize block_size = GetDefaultBlockSize();
-      BoundaryFlag block_bcs[6];
-      SetBlockSizeAndBoundaries(loc, block_size, block_bcs);
-      gmg_block_lists[loc.level()].push_back(
-          MeshBlock::Make(forest.GetGid(loc), -1, loc, block_size, block_bcs, this, pin,
-                          app_in, packages, resolved_packages, gflag));
-      loc = loc.GetParent();
-    }
+  // Create the internal blocks owned by this rank and add them to gmg two-level
+  // composite grid block lists. By default, internal blocks live on the process that
+  // owns the leaf block with the same Morton number, sparse coarse levels may be
+  // gathered onto fewer processes below
+  auto internal_locs = forest.GetSortedInternalNodeList();
+  AgglomerateGMGLevels(internal_locs);
+  for (auto &loc : internal_locs) {
+    if (loc.level() < gmg_min_level || GetGMGBlockRank(loc) != Globals::my_rank)
+      continue;
+    RegionSize block_size = GetDefaultBlockSize();
+    BoundaryFlag block_bcs[6];
+    SetBlockSizeAndBoundaries(loc, block_size, block_bcs);
+    gmg_block_lists[loc.level()].push_back(
+        MeshBlock::Make(forest.GetGid(loc), -1, loc, block_size, block_bcs, this, pin,
+                        app_in, packages, resolved_packages, gflag));
   }
 
   // Sort the gmg block lists by gid
@@ -151,6 +158,35 @@ void Mesh::BuildGMGBlockLists(ParameterInput *pin, ApplicationInput *app_in) {
   }
 }
 
+void Mesh::AgglomerateGMGLevels(const std::vector<LogicalLocation> &internal_locs) {
+  gmg_agglomerated_ranks_.clear();
+  if (gmg_agglomeration_blocks_per_rank_ <= 0 && gmg_single_rank_blocks_ <= 0) return;
+
+  // Bucket the internal nodes by level, keeping them in gid order within a level
+  std::map<int, std::vector<LogicalLocation>> level_locs;
+  for (auto &loc : internal_locs) {
+    if (loc.level() >= GetGMGMinLevel()) level_locs[loc.level()].push_back(loc);
+  }
+
+  for (auto &[level, locs] : level_locs) {
+    std::vector<int> default_ranks(locs.size());
+    for (int b = 0; b < locs.size(); ++b)
+      default_ranks[b] = ranklist[forest.GetLeafGid(locs[b])];
+    auto ranks = load_balance::AgglomerateGMGLevel(default_ranks, Globals::nranks,
+                                                   gmg_agglomeration_blocks_per_rank_,
+                                                   gmg_single_rank_blocks_);
+    for (int b = 0; b < locs.size(); ++b) {
+      if (ranks[b] != default_ranks[b]) gmg_agglomerated_ranks_[locs[b]] = ranks[b];
+    }
+  }
+}
+
+int Mesh::GetGMGBlockRank(const LogicalLocation &loc) const {
+  auto it = gmg_agglomerated_ranks_.find(loc);
+  if (it != gmg_agglomerated_ranks_.end()) return it->second;
+  return ranklist[forest.GetLeafGid(loc)];
+}
+
 void Mesh::SetGMGNeighbors() {
   if (!multigrid) return;
   const int gmg_min_level = GetGMGMinLevel();
@@ -163,9 +199,8 @@ void Mesh::SetGMGNeighbors() {
         auto ploc = pmb->loc.GetParent();
         int gid = forest.GetGid(ploc);
         if (gid >= 0) {
-          int leaf_gid = forest.GetLeafGid(ploc);
           pmb->gmg_coarser_neighbors.emplace_back(
-              pmb->pmy_mesh, ploc, ploc, ranklist[leaf_gid], gid,
+              pmb->pmy_mesh, ploc, ploc, GetGMGBlockRank(ploc), gid,
               std::array<int, 3>{0, 0, 0}, 0, 0, 0, 0);
         }
       }
@@ -178,8 +213,7 @@ void Mesh::SetGMGNeighbors() {
         for (auto &d : dlocs) {
           int gid = forest.GetGid(d);
           if (gid >= 0) {
-            int leaf_gid = forest.GetLeafGid(d);
-            pmb->gmg_finer_neighbors.emplace_back(pmb->pmy_mesh, d, d, ranklist[leaf_gid],
+            pmb->gmg_finer_neighbors.emplace_back(pmb->pmy_mesh, d, d, GetGMGBlockRank(d),
                                                   gid, std::array<int, 3>{0, 0, 0}, 0, 0,
                                                   0, 0);
           }
@@ -75,6 +75,16 @@ Mesh::Mesh(ParameterInput *pin, ApplicationInput *app_in, Packages_t &packages,
       nbnew(), nbdel(), step_since_lb(), gflag(), packages(packages),
       resolved_packages(ResolvePackages(packages)),
       default_pack_size_(pin->GetOrAddInteger("parthenon/mesh", "pack_size", -1)),
+      aggregate_boundary_messages_(
+          pin->GetOrAddBoolean("parthenon/mesh", "aggregate_boundary_messages", false)),
+      persistent_boundary_requests_(
+          pin->GetOrAddBoolean("parthenon/mesh", "persistent_boundary_requests", false)),
+      fused_physical_boundaries_(
+          pin->GetOrAddBoolean("parthenon/mesh", "fused_physical_boundaries", true)),
+      gmg_agglomeration_blocks_per_rank_(pin->GetOrAddInteger(
+          "parthenon/mesh", "gmg_agglomeration_blocks_per_rank", 0)),
+      gmg_single_rank_blocks_(
+          pin->GetOrAddInteger("parthenon/mesh", "gmg_single_rank_blocks", 0)),
       // private members:
       num_mesh_threads_(pin->GetOrAddInteger("parthenon/mesh", "num_threads", 1)),
       use_uniform_meshgen_fn_{true, true, true, true}, lb_flag_(true), lb_automatic_(),
@@ -113,6 +123,9 @@ Mesh::Mesh(ParameterInput *pin, ApplicationInput *app_in, Packages_t &packages,
   if (app_in->UserWorkAfterLoop != nullptr) {
     UserWorkAfterLoop = app_in->UserWorkAfterLoop;
   }
+  if (app_in->PartitionMeshBlocks != nullptr) {
+    PartitionBlocks = app_in->PartitionMeshBlocks;
+  }
 
   // Default root level, may be overwritten by another constructor
   root_level = 0;
@@ -383,11 +396,16 @@ void Mesh::BuildBlockList(ParameterInput *pin, ApplicationInput *app_in,
 
 Mesh::~Mesh() {
 #ifdef MPI_PARALLEL
+  // Pending aggregated receives need to be cancelled before their communicator is freed
+  boundary_mailbox.reset();
   // Cleanup MPI comms
   for (auto &pair : mpi_comm_map_) {
     PARTHENON_MPI_CHECK(MPI_Comm_free(&(pair.second)));
   }
   mpi_comm_map_.clear();
+  if (boundary_aggregation_comm_ != MPI_COMM_NULL) {
+    PARTHENON_MPI_CHECK(MPI_Comm_free(&boundary_aggregation_comm_));
+  }
 #endif
 }
 
@@ -612,6 +630,9 @@ void Mesh::BuildTagMapAndBoundaryBuffers() {
     pmb->meshblock_data.Get()->GetSwarmData()->SetupPersistentMPI();
   }
 
+  if (aggregate_boundary_messages_ && boundary_mailbox == nullptr)
+    boundary_mailbox = std::make_shared<AggregatedReceiveMailbox>(this);
+
   // Wait for boundary buffers to be no longer in use
   bool can_delete;
   std::int64_t test_iters = 0;
@@ -621,6 +642,7 @@ void Mesh::BuildTagMapAndBoundaryBuffers() {
     for (auto &[k, comm] : boundary_comm_map) {
       can_delete = comm.IsSafeToDelete() && can_delete;
     }
+    if (boundary_mailbox) can_delete = boundary_mailbox->IsEmpty() && can_delete;
     test_iters++;
   } while (!can_delete && test_iters < max_it);
   PARTHENON_REQUIRE(
@@ -629,6 +651,7 @@ void Mesh::BuildTagMapAndBoundaryBuffers() {
 
   // Clear boundary communication buffers
   boundary_comm_map.clear();
+  if (boundary_mailbox) boundary_mailbox->ClearChannelCache();
 
   // Build the boundary buffers for the current mesh
   for (auto &partition : GetDefaultBlockPartitions()) {
@@ -906,11 +929,8 @@ void Mesh::RegisterLoadBalancing_(ParameterInput *pin) {
       pin->GetOrAddString("parthenon/loadbalancing", "balancer", "default",
                           std::vector<std::string>{"default", "automatic", "manual"});
   if (balancer == "automatic") {
-    // JMM: I am disabling timing based load balancing, as it's not
-    // threaded through the infrastructure. I think some thought needs
-    // to go into doing this right with loops over meshdata rather
-    // than loops over data on a single meshblock.
-    PARTHENON_FAIL("Timing based load balancing is currently unavailable.");
+    // Costs are charged to the blocks by instrumented tasks, see
+    // mesh/cost_attribution.hpp
     lb_automatic_ = true;
   } else if (balancer == "manual") {
     lb_manual_ = true;
@@ -918,6 +938,14 @@ void Mesh::RegisterLoadBalancing_(ParameterInput *pin) {
   lb_tolerance_ = pin->GetOrAddReal("parthenon/loadbalancing", "tolerance", 0.5);
   lb_interval_ = pin->GetOrAddInteger("parthenon/loadbalancing", "interval", 10);
 #endif // MPI_PARALLEL
+  const auto partitioner = load_balance::GetPartitioner(pin->GetOrAddString(
+      "parthenon/loadbalancing", "partitioner", "greedy",
+      std::vector<std::string>{"greedy", "chains_on_chains", "migration_aware"}));
+  const Real migration_tolerance =
+      pin->GetOrAddReal("parthenon/loadbalancing", "migration_tolerance", 0.1);
+  if (PartitionBlocks == nullptr) {
+    PartitionBlocks = load_balance::MakePartitionFn(partitioner, migration_tolerance);
+  }
 }
 
 // Create separate communicators for all variables. Needs to be done at the mesh
@@ -946,6 +974,22 @@ void Mesh::SetupMPIComms() {
     const auto ret = mpi_comm_map_.insert({pair.first, mpi_comm});
     PARTHENON_REQUIRE_THROWS(ret.second, "Communicator with same name already in map");
   }
+
+  // Aggregated boundary messages identify variables by the position of their label in
+  // the sorted list of labels, which is the same on all ranks
+  comm_labels_.clear();
+  comm_label_ids_.clear();
+  for (auto &pair : mpi_comm_map_) {
+    comm_labels_.push_back(pair.first);
+  }
+  std::sort(comm_labels_.begin(), comm_labels_.end());
+  for (int i = 0; i < comm_labels_.size(); ++i) {
+    comm_label_ids_[comm_labels_[i]] = i;
+  }
+  // All ranks read the same input, so they agree on whether to make this collective call
+  if (aggregate_boundary_messages_ && boundary_aggregation_comm_ == MPI_COMM_NULL) {
+    PARTHENON_MPI_CHECK(MPI_Comm_dup(MPI_COMM_WORLD, &boundary_aggregation_comm_));
+  }
   // TODO(everying during a sync) we should discuss what to do with face vars as they
   // are currently not handled in pmb->meshblock_data.Get()->SetupPersistentMPI(); nor
   // inserted into pmb->pbval->bvars.
@@ -36,6 +36,7 @@
 
 #include "application_input.hpp"
 #include "bvals/boundary_conditions.hpp"
+#include "bvals/comms/message_aggregation.hpp"
 #include "bvals/comms/tag_map.hpp"
 #include "config.hpp"
 #include "coordinates/coordinates.hpp"
@@ -44,9 +45,11 @@
 #include "interface/data_collection.hpp"
 #include "interface/mesh_data.hpp"
 #include "interface/state_descriptor.hpp"
+#include "interface/timestep_reduction.hpp"
 #include "kokkos_abstraction.hpp"
 #include "mesh/forest/forest.hpp"
 #include "mesh/forest/forest_topology.hpp"
+#include "mesh/load_balance.hpp"
 #include "mesh/meshblock_pack.hpp"
 #include "outputs/io_wrapper.hpp"
 #include "parameter_input.hpp"
@@ -55,6 +58,7 @@
 #include "utils/hash.hpp"
 #include "utils/object_pool.hpp"
 #include "utils/partition_stl_containers.hpp"
+#include "utils/size_class_pool.hpp"
 
 namespace parthenon {
 
@@ -99,6 +103,7 @@ class Mesh {
     return nblist[my_rank];
   }
   int GetNumMeshThreads() const { return num_mesh_threads_; }
+  bool AutomaticLoadBalancing() const { return lb_automatic_; }
   std::int64_t GetTotalCells();
   // TODO(JMM): Move block_size into mesh.
   int GetNumberOfMeshBlockCells() const;
@@ -223,10 +228,21 @@ class Mesh {
       std::unordered_map<channel_key_t, comm_buf_t, tuple_hash<channel_key_t>>;
   comm_buf_map_t boundary_comm_map;
   TagMap tag_map;
+  // Receiving end of aggregated boundary messages, only used if
+  // <parthenon/mesh>/aggregate_boundary_messages = true
+  std::shared_ptr<AggregatedReceiveMailbox> boundary_mailbox;
+
+  bool AggregateBoundaryMessages() const { return aggregate_boundary_messages_; }
+  bool PersistentBoundaryRequests() const { return persistent_boundary_requests_; }
+  bool FusedPhysicalBoundaries() const { return fused_physical_boundaries_; }
 
 #ifdef MPI_PARALLEL
   MPI_Comm GetMPIComm(const std::string &label) const { return mpi_comm_map_.at(label); }
+  MPI_Comm GetBoundaryAggregationComm() const { return boundary_aggregation_comm_; }
 #endif
+  // Integer ids of the communicator labels, identical on all ranks
+  int GetCommLabelId(const std::string &label) const { return comm_label_ids_.at(label); }
+  const std::string &GetCommLabel(int id) const { return comm_labels_.at(id); }
 
   void SetAllVariablesToInitialized() {
     for (auto &sp_mb : block_list) {
@@ -245,6 +261,20 @@ class Mesh {
     return buffer_memory;
   }
 
+  // Storage of deallocated sparse variables kept for reuse, only used if
+  // <parthenon/sparse>/pool_storage = true
+  SizeClassPool<Real> sparse_storage_pool;
+  uint64_t GetSparseStoragePoolSizeInBytes() const {
+    return sparse_storage_pool.SizeInBytes();
+  }
+  auto GetSparseStoragePoolStatistics() const {
+    return sparse_storage_pool.GetStatistics();
+  }
+
+  // Mesh wide timestep estimate that is reduced over ranks while the driver finishes the
+  // cycle, see Update::EstimateTimestepDevice
+  TimestepReduction dt_reduction;
+
   // expose a mesh-level call to get lists of variables from resolved_packages
   template <typename... Args>
   std::vector<std::string> GetVariableNames(Args &&...args) {
@@ -288,12 +318,30 @@ class Mesh {
   // size of default MeshBlockPacks
   int default_pack_size_;
 
+  // combine all non-local boundary buffers sent to a rank into a single message
+  bool aggregate_boundary_messages_;
+  // use persistent MPI requests for boundary buffers
+  bool persistent_boundary_requests_;
+  // apply built-in physical boundary conditions of a MeshData in fused kernels
+  bool fused_physical_boundaries_;
+
   int gmg_min_logical_level_ = 0;
+  // GMG levels with fewer internal blocks than this times the number of ranks are
+  // gathered onto chunks of this many blocks per rank (0 disables agglomeration)
+  int gmg_agglomeration_blocks_per_rank_;
+  // GMG levels with at most this many internal blocks are gathered onto a single rank
+  int gmg_single_rank_blocks_;
+  // Owners of the internal GMG blocks that have been moved by agglomeration
+  std::unordered_map<LogicalLocation, int> gmg_agglomerated_ranks_;
 
 #ifdef MPI_PARALLEL
   // Global map of MPI comms for separate variables
   std::unordered_map<std::string, MPI_Comm> mpi_comm_map_;
+  // Only duplicated if boundary messages are aggregated
+  MPI_Comm boundary_aggregation_comm_ = MPI_COMM_NULL;
 #endif
+  std::vector<std::string> comm_labels_;
+  std::unordered_map<std::string, int> comm_label_ids_;
 
   // functions
   void CheckMeshValidity() const;
@@ -303,7 +351,8 @@ class Mesh {
   void DoStaticRefinement(ParameterInput *pin);
   void CalculateLoadBalance(std::vector<double> const &costlist,
                             std::vector<int> &ranklist, std::vector<int> &nslist,
-                            std::vector<int> &nblist);
+                            std::vector<int> &nblist,
+                            std::vector<int> const &current_ranks = {});
   void ResetLoadBalanceVariables();
 
   // Mesh::LoadBalancingAndAdaptiveMeshRefinement() helper functions:
@@ -313,6 +362,8 @@ class Mesh {
   void RedistributeAndRefineMeshBlocks(ParameterInput *pin, ApplicationInput *app_in,
                                        int ntot);
   void BuildGMGBlockLists(ParameterInput *pin, ApplicationInput *app_in);
+  void AgglomerateGMGLevels(const std::vector<LogicalLocation> &internal_locs);
+  int GetGMGBlockRank(const LogicalLocation &loc) const;
   void SetGMGNeighbors();
   void
   SetMeshBlockNeighbors(GridIdentifier grid_id, BlockList_t &block_list,
@@ -321,6 +372,7 @@ class Mesh {
 
   // Optionally defined in the problem file
   std::function<void(Mesh *, ParameterInput *)> InitUserMeshData = nullptr;
+  load_balance::PartitionFn_t PartitionBlocks = nullptr;
 
   // Re-used functionality in constructor
   void RegisterLoadBalancing_(ParameterInput *pin);
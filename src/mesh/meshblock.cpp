@@ -18,6 +18,7 @@
 //  \brief implementation of functions in MeshBlock class
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
@@ -46,6 +47,15 @@
 
 namespace parthenon {
 
+namespace {
+// std::atomic<double>::fetch_add is only available from C++20 on
+void AtomicAdd(std::atomic<double> &a, const double x) {
+  double old = a.load(std::memory_order_relaxed);
+  while (!a.compare_exchange_weak(old, old + x, std::memory_order_relaxed)) {
+  }
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 // MeshBlock constructor: constructs coordinate, boundary condition, field
 //                        and mesh refinement objects.
@@ -237,11 +247,19 @@ void MeshBlock::InitializeIndexShapes(const int nx1, const int nx2, const int nx
 
 void MeshBlock::SetCostForLoadBalancing(double cost) {
   if (pmy_mesh->lb_manual_) {
-    cost_ = std::min(cost, TINY_NUMBER);
+    cost_ = std::max(cost, TINY_NUMBER);
     pmy_mesh->lb_flag_ = true;
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBlock::AddCostForLoadBalancing(double cost)
+//  \brief accumulate cost charged to this MeshBlock for automatic load balancing
+
+void MeshBlock::AddCostForLoadBalancing(double cost) {
+  if (pmy_mesh->lb_automatic_) AtomicAdd(cost_, cost);
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void MeshBlock::ResetTimeMeasurement()
 //  \brief reset the MeshBlock cost for automatic load balancing
@@ -266,10 +284,15 @@ void MeshBlock::StartTimeMeasurement() {
 
 void MeshBlock::StopTimeMeasurement() {
   if (pmy_mesh->lb_automatic_) {
-    cost_ += lb_timer.seconds();
+    AtomicAdd(cost_, lb_timer.seconds());
   }
 }
 
+std::uint64_t MeshBlock::NextAllocationEpoch() {
+  static std::atomic<std::uint64_t> epoch{0};
+  return ++epoch;
+}
+
 void MeshBlock::AllocateSparse(std::string const &label, bool only_control,
                                bool flag_uninitialized) {
   auto &mbd = meshblock_data;
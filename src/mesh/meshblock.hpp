@@ -17,6 +17,7 @@
 #ifndef MESH_MESHBLOCK_HPP_
 #define MESH_MESHBLOCK_HPP_
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -186,6 +187,9 @@ class MeshBlock : public std::enable_shared_from_this<MeshBlock> {
   // functions
   // Load balancing
   void SetCostForLoadBalancing(double cost);
+  // Adds to the cost of the block when using automatic load balancing, see
+  // mesh/cost_attribution.hpp for charging cost from tasks operating on MeshData
+  void AddCostForLoadBalancing(double cost);
 
   // Memory usage
   // TODO(JMM): Currently swarm send/receive boundaries are not counted.
@@ -193,6 +197,12 @@ class MeshBlock : public std::enable_shared_from_this<MeshBlock> {
 
   std::uint64_t ReportMemUsage() { return mem_usage_; }
 
+  // Allocation epoch, updated whenever a variable on the block is allocated or
+  // deallocated. Epochs are drawn from a counter shared by all blocks, so a block that
+  // changed (or was created) after some epoch was observed always has a larger epoch.
+  std::uint64_t GetAllocationEpoch() const { return alloc_epoch_; }
+  void UpdateAllocationEpoch() { alloc_epoch_ = NextAllocationEpoch(); }
+
   //----------------------------------------------------------------------------------------
   //! \fn void MeshBlock::DeepCopy(const DstType& dst, const SrcType& src)
   //  \brief Deep copy between views using the exec space of the MeshBlock
@@ -448,7 +458,8 @@ class MeshBlock : public std::enable_shared_from_this<MeshBlock> {
 
   // functions and variables for automatic load balancing based on timing
   Kokkos::Timer lb_timer;
-  double cost_;
+  // Atomic since tasks running on different threads may charge the same block
+  std::atomic<double> cost_;
   // JMM: these are private since the timing machinery only works
   // per-meshblock nopt per-meshdata.
   void ResetTimeMeasurement();
@@ -457,6 +468,9 @@ class MeshBlock : public std::enable_shared_from_this<MeshBlock> {
 
   // memory usage on a block
   std::uint64_t mem_usage_;
+
+  static std::uint64_t NextAllocationEpoch();
+  std::uint64_t alloc_epoch_ = NextAllocationEpoch();
 };
 
 using BlockList_t = std::vector<std::shared_ptr<MeshBlock>>;
@@ -464,6 +464,8 @@ void HistogramOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin, SimTime *tm
   Kokkos::Profiling::popRegion(); // Calculate all histograms
 
   Kokkos::Profiling::pushRegion("Dump histograms");
+  // HDF5 must not be used while an asynchronous output is being written
+  HDF5::WaitForAsyncWrites();
   // Given the expect size of histograms, we'll use serial HDF
   if (Globals::my_rank == 0) {
     using namespace HDF5;
@@ -51,12 +51,14 @@ struct OutputParameters {
   int hdf5_compression_level;
   bool write_xdmf;
   bool write_swarm_xdmf;
+  bool async_write;
   // TODO(felker): some of the parameters in this class are not initialized in constructor
   OutputParameters()
       : block_number(0), next_time(0.0), dt(-1.0), file_number(0),
         include_ghost_zones(false), cartesian_vector(false),
         single_precision_output(false), sparse_seed_nans(false),
-        hdf5_compression_level(5), write_xdmf(false), write_swarm_xdmf(false) {}
+        hdf5_compression_level(5), write_xdmf(false), write_swarm_xdmf(false),
+        async_write(false) {}
 };
 
 } // namespace parthenon
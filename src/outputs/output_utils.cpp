@@ -65,6 +65,16 @@ Triple_t<IndexRange> VarInfo::GetPaddedBoundsKJI(const IndexDomain domain) const
   return std::make_tuple(kb, jb, ib);
 }
 
+Triple_t<IndexRange> VarInfo::GetOutputBoundsKJI(const IndexDomain domain) const {
+  if (where == MetadataFlag({Metadata::None})) {
+    const auto shape = GetPaddedShapeReversed(domain);
+    IndexRange kb{0, shape[VNDIM - 3] - 1}, jb{0, shape[VNDIM - 2] - 1},
+        ib{0, shape[VNDIM - 1] - 1};
+    return std::make_tuple(kb, jb, ib);
+  }
+  return GetPaddedBoundsKJI(domain);
+}
+
 int VarInfo::Size() const {
   return std::accumulate(nx_.begin(), nx_.end(), 1, std::multiplies<int>());
 }
@@ -138,6 +148,24 @@ std::vector<VarInfo> VarInfo::GetAll(const VariableVector<Real> &vars,
   return out;
 }
 
+BlockVarIndexer::BlockVarIndexer(const VarInfo &info, bool do_ghosts) {
+  const IndexDomain domain = (do_ghosts ? IndexDomain::entire : IndexDomain::interior);
+  const auto shape = info.GetPaddedShapeReversed(domain);
+  const auto [kb, jb, ib] = info.GetOutputBoundsKJI(domain);
+  nt = shape[1];
+  nu = shape[2];
+  nv = shape[3];
+  nk = kb.e - kb.s + 1;
+  nj = jb.e - jb.s + 1;
+  ni = ib.e - ib.s + 1;
+  ks = kb.s;
+  js = jb.s;
+  is = ib.s;
+  fill_size = info.FillSize(domain);
+  PARTHENON_REQUIRE(fill_size == shape[0] * nt * nu * nv * nk * nj * ni,
+                    "I/O shape of " + info.label + " does not match its fill size");
+}
+
 void SwarmInfo::AddOffsets(const SP_Swarm &swarm) {
   std::size_t count = swarm->GetNumActive();
   std::size_t offset = (offsets.size() > 0) ? offsets.back() : 0;
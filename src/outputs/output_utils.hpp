@@ -68,6 +68,9 @@ struct VarInfo {
 
   Triple_t<int> GetNumKJI(const IndexDomain domain) const;
   Triple_t<IndexRange> GetPaddedBoundsKJI(const IndexDomain domain) const;
+  // Bounds of the k, j, i loops over the data as written to/read from I/O. For variables
+  // without a topological location these cover the trailing padded shape from 0.
+  Triple_t<IndexRange> GetOutputBoundsKJI(const IndexDomain domain) const;
 
   int Size() const;
   // Includes topological element shape
@@ -305,16 +308,7 @@ void PackOrUnpackVar(const VarInfo &info, bool do_ghosts, idx_t &idx, Function_t
   // format is
   // topological_elems x tensor_elems x block_elems
   const auto shape = info.GetPaddedShapeReversed(domain);
-  // TODO(JMM): Should I hide this inside VarInfo?
-  auto [kb, jb, ib] = info.GetPaddedBoundsKJI(domain);
-  if (info.where == MetadataFlag({Metadata::None})) {
-    kb.s = 0;
-    kb.e = shape[4];
-    jb.s = 0;
-    jb.e = shape[5];
-    ib.s = 0;
-    ib.e = shape[6];
-  }
+  const auto [kb, jb, ib] = info.GetOutputBoundsKJI(domain);
   for (int topo = 0; topo < shape[0]; ++topo) {
     for (int t = 0; t < shape[1]; ++t) {
       for (int u = 0; u < shape[2]; ++u) {
@@ -333,6 +327,41 @@ void PackOrUnpackVar(const VarInfo &info, bool do_ghosts, idx_t &idx, Function_t
   }
 }
 
+// Device data of one variable on one block. An array of these lets a single kernel pack
+// or unpack a variable on all blocks of a rank.
+struct BlockVarData {
+  ParArrayND<Real, VariableState> data;
+  bool allocated = false;
+};
+using BlockVarDataArr_t = ParArray1D<BlockVarData>;
+
+// Maps the position of an element within the I/O data of a variable on one block to
+// the indices of the variable array, following the loop order of PackOrUnpackVar
+struct BlockVarIndexer {
+  BlockVarIndexer(const VarInfo &info, bool do_ghosts);
+
+  KOKKOS_INLINE_FUNCTION
+  void GetIndices(int n, int &topo, int &t, int &u, int &v, int &k, int &j,
+                  int &i) const {
+    i = is + n % ni;
+    n /= ni;
+    j = js + n % nj;
+    n /= nj;
+    k = ks + n % nk;
+    n /= nk;
+    v = n % nv;
+    n /= nv;
+    u = n % nu;
+    n /= nu;
+    t = n % nt;
+    topo = n / nt;
+  }
+
+  int fill_size; // number of elements per block
+  int nt, nu, nv, nk, nj, ni;
+  int ks, js, is;
+};
+
 void ComputeCoords(Mesh *pm, bool face, const IndexRange &ib, const IndexRange &jb,
                    const IndexRange &kb, std::vector<Real> &x, std::vector<Real> &y,
                    std::vector<Real> &z);
@@ -74,6 +74,7 @@
 #include "interface/swarm_default_names.hpp"
 #include "mesh/mesh.hpp"
 #include "mesh/meshblock.hpp"
+#include "outputs/parthenon_hdf5.hpp"
 #include "parameter_input.hpp"
 #include "parthenon_arrays.hpp"
 #include "utils/error_checking.hpp"
@@ -283,6 +284,15 @@ Outputs::Outputs(Mesh *pm, ParameterInput *pin, SimTime *tm) {
         op.write_swarm_xdmf =
             (restart) ? false
                       : pin->GetOrAddBoolean(op.block_name, "write_swarm_xdmf", false);
+        op.async_write = pin->GetOrAddBoolean(op.block_name, "async_write", false);
+        if (op.async_write && !HDF5::AsyncWritesSupported()) {
+          msg << "### FATAL ERROR in Outputs constructor" << std::endl
+              << "Asynchronous writes requested in output block '" << op.block_name
+              << "', but MPI does not provide MPI_THREAD_MULTIPLE. Set the "
+              << "environment variable PARTHENON_MPI_THREAD_MULTIPLE=true to request "
+              << "it, or disable async_write." << std::endl;
+          PARTHENON_FAIL(msg);
+        }
         pnew_type = new PHDF5Output(op, restart);
 #else
         msg << "### FATAL ERROR in Outputs constructor" << std::endl
@@ -353,6 +363,10 @@ Outputs::Outputs(Mesh *pm, ParameterInput *pin, SimTime *tm) {
 // destructor - iterates through singly linked list of OutputTypes and deletes nodes
 
 Outputs::~Outputs() {
+#ifdef ENABLE_HDF5
+  // Make sure the last asynchronous output made it to disk
+  HDF5::WaitForAsyncWrites();
+#endif
   OutputType *ptype = pfirst_type_;
   while (ptype != nullptr) {
     OutputType *ptype_old = ptype;
@@ -203,6 +203,10 @@ class PHDF5Output : public OutputType {
                         hid_t file, const HDF5::H5P &pl, size_t offset,
                         hsize_t max_blocks_global) const;
   const bool restart_; // true if we write a restart file, false for regular output files
+  // Variable data of all local blocks is packed into dev_staging_ and copied to
+  // host_staging_ with a single transfer. Both are kept across dumps and only grown.
+  Kokkos::View<char *, LayoutWrapper, DevMemSpace> dev_staging_;
+  Kokkos::View<char *, LayoutWrapper, HostPinnedMemSpace> host_staging_;
 };
 
 //----------------------------------------------------------------------------------------
@@ -24,13 +24,18 @@
 #ifdef ENABLE_HDF5
 
 #include <algorithm>
+#include <array>
+#include <future>
 #include <limits>
 #include <memory>
 #include <numeric>
 #include <set>
+#include <string>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "driver/driver.hpp"
 #include "interface/metadata.hpp"
@@ -46,9 +51,91 @@
 
 namespace parthenon {
 
+namespace {
+using DevStaging_t = Kokkos::View<char *, LayoutWrapper, DevMemSpace>;
+using HostStaging_t = Kokkos::View<char *, LayoutWrapper, HostPinnedMemSpace>;
+
+// Unmanaged view of the first n elements of a persistent staging buffer, which is grown
+// if it is too small. Previous contents are not preserved.
+template <typename T, typename Staging_t>
+auto StagingView(Staging_t &buffer, size_t n) {
+  using space_t = typename Staging_t::memory_space;
+  if (buffer.extent(0) < n * sizeof(T)) {
+    buffer = Staging_t(); // free the old buffer first to limit the peak footprint
+    buffer = Staging_t(Kokkos::view_alloc(Kokkos::WithoutInitializing, "output staging"),
+                       n * sizeof(T));
+  }
+  return Kokkos::View<T *, LayoutWrapper, space_t, MemUnmanaged>(
+      reinterpret_cast<T *>(buffer.data()), n);
+}
+
+// Host copy of the data of one output variable on all local blocks, together with
+// everything needed to write it to the file without access to the mesh
+template <typename OutT>
+struct StagedVariable {
+  std::string name;
+  MetadataFlag where = Metadata::None;
+  int ndim;
+  std::array<hsize_t, HDF5::H5_NDIM> local_offset, local_count, global_count;
+  const OutT *data = nullptr; // points into the host staging buffer
+
+  void Write(hid_t file, hid_t pl_xfer, hid_t pl_dcreate, int compression_level) const {
+    using namespace HDF5;
+#ifndef PARTHENON_DISABLE_HDF5_COMPRESSION
+    // we need chunks to enable compression. Do not run the pipeline
+    // if compression is soft disabled.  By default data would still
+    // be passed, which may result in slower output.
+    if (compression_level > 0) {
+      std::array<hsize_t, H5_NDIM> chunk_size;
+      std::fill(chunk_size.begin(), chunk_size.end(), 1);
+      for (int i = 1; i < ndim; ++i) {
+        chunk_size[i] = local_count[i];
+      }
+      if (where != MetadataFlag(Metadata::None)) {
+        std::fill(&(chunk_size[0]), &(chunk_size[0]) + ndim - 3, 1);
+      }
+      PARTHENON_HDF5_CHECK(H5Pset_chunk(pl_dcreate, ndim, chunk_size.data()));
+      PARTHENON_HDF5_CHECK(H5Pset_deflate(pl_dcreate, std::min(9, compression_level)));
+    }
+#endif
+    HDF5WriteND(file, name, data, ndim, local_offset.data(), local_count.data(),
+                global_count.data(), pl_xfer, pl_dcreate);
+    H5D dset = H5D::FromHIDCheck(H5Dopen2(file, name.c_str(), H5P_DEFAULT));
+    HDF5WriteAttribute("TopologicalLocation", Metadata::LocationToString(where), dset);
+  }
+};
+
+// Everything an asynchronous write needs, owned by the background thread
+template <typename OutT>
+struct AsyncWrite {
+  HDF5::H5F file;
+  HDF5::H5P pl_xfer, pl_dcreate;
+  int compression_level;
+  std::vector<StagedVariable<OutT>> vars;
+  // Keeps the host staging buffer the variables point into alive
+  HostStaging_t staging;
+
+  void operator()() {
+    for (const auto &v : vars) {
+      v.Write(file, pl_xfer, pl_dcreate, compression_level);
+    }
+    // Drop the staging buffer and close the file here rather than wherever the last
+    // reference happens to be dropped
+    vars.clear();
+    staging = HostStaging_t();
+    pl_dcreate.Reset();
+    pl_xfer.Reset();
+    file.Reset();
+  }
+};
+} // namespace
+
 void PHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin, SimTime *tm,
                                   const SignalHandler::OutputSignal signal) {
   using namespace HDF5;
+  // A previous asynchronous output may still be writing, and HDF5 must not be called
+  // from two threads at once
+  WaitForAsyncWrites();
   if (output_params.single_precision_output) {
     this->template WriteOutputFileImpl<true>(pm, pin, tm, signal);
   } else {
@@ -91,6 +178,10 @@ void PHDF5Output::WriteOutputFileImpl(Mesh *pm, ParameterInput *pin, SimTime *tm
   auto const nx2 = cellbounds.ncellsj(theDomain);
   auto const nx3 = cellbounds.ncellsk(theDomain);
 
+  // Whether variable data is written by the background thread. All ranks agree on this
+  // since they share the input, and the Outputs constructor checked the MPI thread level.
+  const bool async = output_params.async_write;
+
   const int rootLevel = pm->GetLegacyTreeRootLevel();
   const int max_level = pm->GetCurrentLevel() - pm->GetRootLevel();
   const auto &nblist = pm->GetNbList();
@@ -133,7 +224,7 @@ void PHDF5Output::WriteOutputFileImpl(Mesh *pm, ParameterInput *pin, SimTime *tm
   }                                 // Input section
 
   // we'll need this again at the end
-  const H5G info_group = MakeGroup(file, "/Info");
+  H5G info_group = MakeGroup(file, "/Info");
   {
     Kokkos::Profiling::pushRegion("write Info");
     HDF5WriteAttribute("OutputFormatVersion", OUTPUT_VERSION_FORMAT, info_group);
@@ -218,8 +309,8 @@ void PHDF5Output::WriteOutputFileImpl(Mesh *pm, ParameterInput *pin, SimTime *tm
     my_offset += nblist[i];
   }
 
-  H5P const pl_xfer = H5P::FromHIDCheck(H5Pcreate(H5P_DATASET_XFER));
-  H5P const pl_dcreate = H5P::FromHIDCheck(H5Pcreate(H5P_DATASET_CREATE));
+  H5P pl_xfer = H5P::FromHIDCheck(H5Pcreate(H5P_DATASET_XFER));
+  H5P pl_dcreate = H5P::FromHIDCheck(H5Pcreate(H5P_DATASET_CREATE));
 
   // Never write fill values to the dataset
   PARTHENON_HDF5_CHECK(H5Pset_fill_time(pl_dcreate, H5D_FILL_TIME_NEVER));
@@ -300,115 +391,119 @@ void PHDF5Output::WriteOutputFileImpl(Mesh *pm, ParameterInput *pin, SimTime *tm
   std::unique_ptr<hbool_t[]> sparse_allocated(new hbool_t[num_blocks_local * num_sparse]);
   std::vector<int> sparse_dealloc_count(num_blocks_local * num_sparse);
 
-  // allocate space for largest size variable
-  size_t varSize_max = 0;
-  for (auto &vinfo : all_vars_info) {
-    const size_t varSize = vinfo.Size();
-    varSize_max = std::max(varSize_max, varSize);
+  using OutT = typename std::conditional<WRITE_SINGLE_PRECISION, float, Real>::type;
+  // Data of each variable on all local blocks is packed on the device and copied to the
+  // host with a single transfer. Synchronous outputs write one variable at a time and
+  // reuse the same part of the host buffer, asynchronous ones stage all variables so
+  // they can be written after returning. Without a separate device memory space the
+  // data is packed straight into the host buffer.
+  constexpr bool pack_on_host = std::is_same<DevMemSpace, HostPinnedMemSpace>::value;
+  std::vector<size_t> host_offset(all_vars_info.size(), 0);
+  size_t dev_size = 0, host_size = 0;
+  for (size_t var_idx = 0; var_idx < all_vars_info.size(); ++var_idx) {
+    const size_t var_size = all_vars_info[var_idx].FillSize(theDomain) * num_blocks_local;
+    if (!pack_on_host) dev_size = std::max(dev_size, var_size);
+    if (async) {
+      host_offset[var_idx] = host_size;
+      host_size += var_size;
+    } else {
+      host_size = std::max(host_size, var_size);
+    }
   }
+  auto staging_d = StagingView<OutT>(dev_staging_, dev_size);
+  auto staging_h = StagingView<OutT>(host_staging_, host_size);
 
-  using OutT = typename std::conditional<WRITE_SINGLE_PRECISION, float, Real>::type;
-  std::vector<OutT> tmpData(varSize_max * num_blocks_local);
+  BlockVarDataArr_t block_vars("PHDF5::block_vars", num_blocks_local);
+  auto block_vars_h = Kokkos::create_mirror_view(block_vars);
+
+  std::vector<StagedVariable<OutT>> staged(async ? all_vars_info.size() : 1);
 
   // for each variable we write
-  for (auto &vinfo : all_vars_info) {
+  for (size_t var_idx = 0; var_idx < all_vars_info.size(); ++var_idx) {
     Kokkos::Profiling::pushRegion("write variable loop");
-    // not really necessary, but doesn't hurt
-    memset(tmpData.data(), 0, tmpData.size() * sizeof(OutT));
+    const auto &vinfo = all_vars_info[var_idx];
+    auto &svar = staged[async ? var_idx : 0];
 
     const std::string var_name = vinfo.label;
+    svar.name = var_name;
+    svar.where = vinfo.where;
 
-    hsize_t local_offset[H5_NDIM];
-    std::fill(local_offset + 1, local_offset + H5_NDIM, 0);
+    auto &local_offset = svar.local_offset;
+    std::fill(local_offset.begin() + 1, local_offset.end(), 0);
     local_offset[0] = my_offset;
 
-    hsize_t local_count[H5_NDIM];
+    auto &local_count = svar.local_count;
     local_count[0] = static_cast<hsize_t>(num_blocks_local);
 
-    hsize_t global_count[H5_NDIM];
+    auto &global_count = svar.global_count;
     global_count[0] = static_cast<hsize_t>(max_blocks_global);
 
     // block index + variable on block dimensions
-    int ndim = 1 + vinfo.FillShape(theDomain, &(local_count[1]), &(global_count[1]));
-
-#ifndef PARTHENON_DISABLE_HDF5_COMPRESSION
-    // we need chunks to enable compression. Do not run the pipeline
-    // if compression is soft disabled.  By default data would still
-    // be passed, which may result in slower output.
-    if (output_params.hdf5_compression_level > 0) {
-      std::array<hsize_t, H5_NDIM> chunk_size;
-      std::fill(chunk_size.begin(), chunk_size.end(), 1);
-      for (int i = 1; i < ndim; ++i) {
-        chunk_size[i] = local_count[i];
-      }
-      if (vinfo.where != MetadataFlag(Metadata::None)) {
-        std::fill(&(chunk_size[0]), &(chunk_size[0]) + ndim - 3, 1);
-      }
-      PARTHENON_HDF5_CHECK(H5Pset_chunk(pl_dcreate, ndim, chunk_size.data()));
-      PARTHENON_HDF5_CHECK(
-          H5Pset_deflate(pl_dcreate, std::min(9, output_params.hdf5_compression_level)));
-    }
-#endif
-
-    // load up data
-    hsize_t index = 0;
+    svar.ndim = 1 + vinfo.FillShape(theDomain, &(local_count[1]), &(global_count[1]));
 
     Kokkos::Profiling::pushRegion("fill host output buffer");
     // for each local mesh block
     for (size_t b_idx = 0; b_idx < num_blocks_local; ++b_idx) {
       const auto &pmb = pm->block_list[b_idx];
-      bool is_allocated = false;
-      int dealloc_count = 0;
-      // for each variable that this local meshblock actually has
-      const auto vars = get_vars(pmb);
-      for (auto &v : vars) {
-        // For reference, if we update the logic here, there's also
-        // a similar block in parthenon_manager.cpp
-        if (v->IsAllocated() && (var_name == v->label())) {
-          auto v_h = v->data.GetHostMirrorAndCopy();
-          OutputUtils::PackOrUnpackVar(
-              vinfo, output_params.include_ghost_zones, index,
-              [&](auto index, int topo, int t, int u, int v, int k, int j, int i) {
-                tmpData[index] = static_cast<OutT>(v_h(topo, t, u, v, k, j, i));
-              });
-          is_allocated = true;
-          dealloc_count = v->dealloc_count;
-          break;
-        }
-      }
+      const auto &mbd = pmb->meshblock_data.Get();
+      // For reference, if we update the logic here, there's also
+      // a similar block in parthenon_manager.cpp
+      std::shared_ptr<Variable<Real>> v;
+      if (mbd->HasVariable(var_name)) v = mbd->GetVarPtr(var_name);
+      const bool is_allocated = (v != nullptr) && v->IsAllocated();
+      block_vars_h(b_idx).allocated = is_allocated;
+      block_vars_h(b_idx).data =
+          is_allocated ? v->data : ParArrayND<Real, VariableState>();
 
       if (vinfo.is_sparse) {
         size_t sparse_idx = sparse_field_idx.at(vinfo.label);
         sparse_allocated[b_idx * num_sparse + sparse_idx] = is_allocated;
-        sparse_dealloc_count[b_idx * num_sparse + sparse_idx] = dealloc_count;
-      }
-
-      if (!is_allocated) {
-        if (vinfo.is_sparse) {
-          hsize_t varSize = vinfo.FillSize(theDomain);
-          auto fill_val =
-              output_params.sparse_seed_nans ? std::numeric_limits<OutT>::quiet_NaN() : 0;
-          std::fill(tmpData.data() + index, tmpData.data() + index + varSize, fill_val);
-          index += varSize;
-        } else {
-          std::stringstream msg;
-          msg << "### ERROR: Unable to find dense variable " << var_name << std::endl;
-          PARTHENON_FAIL(msg);
-        }
+        sparse_dealloc_count[b_idx * num_sparse + sparse_idx] =
+            is_allocated ? v->dealloc_count : 0;
+      } else if (!is_allocated) {
+        std::stringstream msg;
+        msg << "### ERROR: Unable to find dense variable " << var_name << std::endl;
+        PARTHENON_FAIL(msg);
       }
     }
+    Kokkos::deep_copy(block_vars, block_vars_h);
+
+    // The blocks are stored one after the other
+    const BlockVarIndexer idxer(vinfo, output_params.include_ghost_zones);
+    const int fill_size = idxer.fill_size;
+    const OutT fill_val =
+        output_params.sparse_seed_nans ? std::numeric_limits<OutT>::quiet_NaN() : 0;
+    const size_t var_size = static_cast<size_t>(fill_size) * num_blocks_local;
+    const size_t offset = host_offset[var_idx];
+    using packed_t = Kokkos::View<OutT *, LayoutWrapper, DevMemSpace, MemUnmanaged>;
+    packed_t packed(pack_on_host ? staging_h.data() + offset : staging_d.data(),
+                    var_size);
+    parthenon::par_for(
+        loop_pattern_mdrange_tag, "PHDF5::PackVariable", DevExecSpace(), 0,
+        num_blocks_local - 1, 0, fill_size - 1, KOKKOS_LAMBDA(const int b, const int n) {
+          const size_t idx = static_cast<size_t>(b) * fill_size + n;
+          if (!block_vars(b).allocated) {
+            packed(idx) = fill_val;
+            return;
+          }
+          int topo, t, u, v, k, j, i;
+          idxer.GetIndices(n, topo, t, u, v, k, j, i);
+          packed(idx) = static_cast<OutT>(block_vars(b).data(topo, t, u, v, k, j, i));
+        });
+    if constexpr (pack_on_host) {
+      Kokkos::fence("PHDF5::PackVariable");
+    } else {
+      Kokkos::deep_copy(
+          Kokkos::subview(staging_h, std::make_pair(offset, offset + var_size)), packed);
+    }
+    svar.data = staging_h.data() + offset;
     Kokkos::Profiling::popRegion(); // fill host output buffer
 
-    Kokkos::Profiling::pushRegion("write variable data");
-    // write data to file
-    { // scope so the dataset gets closed
-      HDF5WriteND(file, var_name, tmpData.data(), ndim, &local_offset[0], &local_count[0],
-                  &global_count[0], pl_xfer, pl_dcreate);
-      H5D dset = H5D::FromHIDCheck(H5Dopen2(file, var_name.c_str(), H5P_DEFAULT));
-      HDF5WriteAttribute("TopologicalLocation", Metadata::LocationToString(vinfo.where),
-                         dset);
+    if (!async) {
+      Kokkos::Profiling::pushRegion("write variable data");
+      svar.Write(file, pl_xfer, pl_dcreate, output_params.hdf5_compression_level);
+      Kokkos::Profiling::popRegion(); // write variable data
     }
-    Kokkos::Profiling::popRegion(); // write variable data
     Kokkos::Profiling::popRegion(); // write variable loop
   }
   Kokkos::Profiling::popRegion(); // write all variable data
@@ -560,6 +655,20 @@ void PHDF5Output::WriteOutputFileImpl(Mesh *pm, ParameterInput *pin, SimTime *tm
     Kokkos::Profiling::popRegion(); // genXDMF
   }
 
+  if (async) {
+    // Everything but the variable data is in the file. Hand the file over to the
+    // background thread, which must be the only one holding open HDF5 objects.
+    info_group.Reset();
+    auto write = std::make_shared<AsyncWrite<OutT>>();
+    write->file = std::move(file);
+    write->pl_xfer = std::move(pl_xfer);
+    write->pl_dcreate = std::move(pl_dcreate);
+    write->compression_level = output_params.hdf5_compression_level;
+    write->vars = std::move(staged);
+    write->staging = host_staging_;
+    LaunchAsyncWrite([write]() { (*write)(); });
+  }
+
   Kokkos::Profiling::popRegion(); // WriteOutputFile???Prec
 }
 // explicit template instantiation
@@ -741,6 +850,34 @@ void PHDF5Output::WriteSparseInfo_(Mesh *pm, hbool_t *sparse_allocated,
 
 // Utility functions implemented
 namespace HDF5 {
+namespace {
+// The write currently in flight, only ever touched by the main thread
+std::future<void> async_write;
+} // namespace
+
+bool AsyncWritesSupported() {
+#ifdef MPI_PARALLEL
+  int provided;
+  PARTHENON_MPI_CHECK(MPI_Query_thread(&provided));
+  return provided == MPI_THREAD_MULTIPLE;
+#else
+  return true;
+#endif
+}
+
+void LaunchAsyncWrite(std::function<void()> write) {
+  WaitForAsyncWrites();
+  async_write = std::async(std::launch::async, std::move(write));
+}
+
+void WaitForAsyncWrites() {
+  if (async_write.valid()) {
+    Kokkos::Profiling::pushRegion("PHDF5::WaitForAsyncWrites");
+    async_write.get();
+    Kokkos::Profiling::popRegion(); // PHDF5::WaitForAsyncWrites
+  }
+}
+
 hid_t GenerateFileAccessProps() {
 #ifdef MPI_PARALLEL
   /* set the file access template for parallel IO access */
@@ -53,6 +53,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -69,6 +70,19 @@ namespace HDF5 {
 //  Implemented in CPP file as it's complex
 hid_t GenerateFileAccessProps();
 
+// Asynchronous writes
+//
+// Outputs with async_write enabled hand the writing of their staged variable data to a
+// background thread. Only one such write is in flight at any time. Because HDF5 is in
+// general not thread safe, everything that calls into HDF5 from the main thread has to
+// call WaitForAsyncWrites first. With MPI, the collective calls of the background
+// thread go through the communicator HDF5 duplicates when the file is opened, so they
+// do not interfere with the main thread, but MPI_THREAD_MULTIPLE is required.
+bool AsyncWritesSupported();
+void LaunchAsyncWrite(std::function<void()> write);
+// Blocks until the write in flight (if any) is done, rethrowing any error it raised
+void WaitForAsyncWrites();
+
 inline H5G MakeGroup(hid_t file, const std::string &name) {
   return H5G::FromHIDCheck(
       H5Gcreate(file, name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
@@ -102,11 +102,15 @@ class RestartReader {
   // Return output format version number. Return -1 if not existent.
   [[nodiscard]] virtual int GetOutputFormatVersion() const = 0;
 
+  // Whether the file contains a dataset with the given name
+  [[nodiscard]] virtual bool HasDataset(const std::string &name) const = 0;
+
   // Gets data for all blocks on current rank.
   // Assumes blocks are contiguous
-  // fills internal data for given pointer
+  // fills data, which must hold at least size elements. This is a collective call, all
+  // ranks must read the same variables in the same order.
   virtual void ReadBlocks(const std::string &name, IndexRange range,
-                          const OutputUtils::VarInfo &info, std::vector<Real> &dataVec,
+                          const OutputUtils::VarInfo &info, Real *data, std::size_t size,
                           int file_output_format_version) const = 0;
 
   // Gets the data from a swarm var on current rank. Assumes all
@@ -49,8 +49,14 @@ RestartReaderHDF5::RestartReaderHDF5(const char *filename) : filename_(filename)
       << "is required for restarts" << std::endl;
   PARTHENON_FAIL(msg);
 #else  // HDF5 enabled
-  // Open the HDF file in read only mode
-  fh_ = H5F::FromHIDCheck(H5Fopen(filename, H5F_ACC_RDONLY, H5P_DEFAULT));
+  // Open the HDF file in read only mode. With MPI, the MPI-IO driver is used so that
+  // variable data can be read collectively. Everything else is read independently
+  // since not all of it is read by every rank.
+  const H5P acc_file = H5P::FromHIDCheck(H5Pcreate(H5P_FILE_ACCESS));
+#ifdef MPI_PARALLEL
+  PARTHENON_HDF5_CHECK(H5Pset_fapl_mpio(acc_file, MPI_COMM_WORLD, MPI_INFO_NULL));
+#endif
+  fh_ = H5F::FromHIDCheck(H5Fopen(filename, H5F_ACC_RDONLY, acc_file));
   params_group_ = H5G::FromHIDCheck(H5Oopen(fh_, "Params", H5P_DEFAULT));
 
   has_ghost = GetAttr<int>("Info", "IncludesGhost");
@@ -205,9 +211,17 @@ void RestartReaderHDF5::ReadParams(const std::string &name, Params &p) {
   p.ReadFromRestart(name, params_group_);
 #endif // ENABLE_HDF5
 }
+bool RestartReaderHDF5::HasDataset(const std::string &name) const {
+#ifndef ENABLE_HDF5
+  PARTHENON_FAIL("Restart functionality is not available because HDF5 is disabled");
+#else  // HDF5 enabled
+  return PARTHENON_HDF5_CHECK(H5Lexists(fh_, name.c_str(), H5P_DEFAULT)) > 0;
+#endif // ENABLE_HDF5
+}
+
 void RestartReaderHDF5::ReadBlocks(const std::string &name, IndexRange range,
-                                   const OutputUtils::VarInfo &info,
-                                   std::vector<Real> &dataVec,
+                                   const OutputUtils::VarInfo &info, Real *data,
+                                   std::size_t size,
                                    int file_output_format_version) const {
 #ifndef ENABLE_HDF5
   PARTHENON_FAIL("Restart functionality is not available because HDF5 is disabled");
@@ -241,8 +255,8 @@ void RestartReaderHDF5::ReadBlocks(const std::string &name, IndexRange range,
     total_count *= count[i];
   }
 
-  PARTHENON_REQUIRE_THROWS(dataVec.size() >= total_count,
-                           "Buffer (size " + std::to_string(dataVec.size()) +
+  PARTHENON_REQUIRE_THROWS(size >= total_count,
+                           "Buffer (size " + std::to_string(size) +
                                ") is too small for dataset " + name + " (size " +
                                std::to_string(total_count) + ")");
 
@@ -250,9 +264,15 @@ void RestartReaderHDF5::ReadBlocks(const std::string &name, IndexRange range,
   PARTHENON_HDF5_CHECK(
       H5Sselect_hyperslab(hdl.dataspace, H5S_SELECT_SET, offset, NULL, count, NULL));
 
+  // All ranks read their blocks of the variable at the same time
+  const H5P pl_xfer = H5P::FromHIDCheck(H5Pcreate(H5P_DATASET_XFER));
+#ifdef MPI_PARALLEL
+  PARTHENON_HDF5_CHECK(H5Pset_dxpl_mpio(pl_xfer, H5FD_MPIO_COLLECTIVE));
+#endif
+
   // Read data from file
-  PARTHENON_HDF5_CHECK(H5Dread(hdl.dataset, hdl.type, memspace, hdl.dataspace,
-                               H5P_DEFAULT, dataVec.data()));
+  PARTHENON_HDF5_CHECK(
+      H5Dread(hdl.dataset, hdl.type, memspace, hdl.dataspace, pl_xfer, data));
 #endif // ENABLE_HDF5
 }
 
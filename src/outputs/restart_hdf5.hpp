@@ -60,6 +60,8 @@ class RestartReaderHDF5 : public RestartReader {
 
   [[nodiscard]] int HasGhost() const override { return has_ghost; };
 
+  [[nodiscard]] bool HasDataset(const std::string &name) const override;
+
  private:
 #ifdef ENABLE_HDF5
   struct DatasetHandle {
@@ -114,7 +116,7 @@ class RestartReaderHDF5 : public RestartReader {
   // Assumes blocks are contiguous
   // fills internal data for given pointer
   void ReadBlocks(const std::string &name, IndexRange range,
-                  const OutputUtils::VarInfo &info, std::vector<Real> &dataVec,
+                  const OutputUtils::VarInfo &info, Real *data, std::size_t size,
                   int file_output_format_version) const override;
 
   // Gets the data from a swarm var on current rank. Assumes all
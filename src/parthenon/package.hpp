@@ -28,6 +28,7 @@
 #include <interface/swarm_pack.hpp>
 #include <interface/variable_pack.hpp>
 #include <kokkos_abstraction.hpp>
+#include <mesh/cost_attribution.hpp>
 #include <mesh/mesh.hpp>
 #include <mesh/meshblock.hpp>
 #include <mesh/meshblock_pack.hpp>
@@ -18,8 +18,11 @@
 #include "parthenon_manager.hpp"
 
 #include <algorithm>
+#include <array>
 #include <exception>
+#include <sstream>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -33,8 +36,10 @@
 #include "mesh/domain.hpp"
 #include "mesh/meshblock.hpp"
 #include "outputs/output_utils.hpp"
+#include "outputs/parthenon_hdf5.hpp"
 #include "outputs/restart.hpp"
 #include "outputs/restart_hdf5.hpp"
+#include "utils/communicator_pool.hpp"
 #include "utils/error_checking.hpp"
 #include "utils/utils.hpp"
 
@@ -50,7 +55,18 @@ ParthenonStatus ParthenonManager::ParthenonInitEnv(int argc, char *argv[]) {
 
   // initialize MPI
 #ifdef MPI_PARALLEL
-  if (MPI_SUCCESS != MPI_Init(&argc, &argv)) {
+  // Full thread support is only requested on demand (it is needed, e.g., by asynchronous
+  // outputs) as it may slow down MPI. Features that need it check the level provided.
+  bool exists;
+  int mpi_init_status;
+  if (Env::get<bool>("PARTHENON_MPI_THREAD_MULTIPLE", false, exists)) {
+    int mpi_thread_support;
+    mpi_init_status =
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &mpi_thread_support);
+  } else {
+    mpi_init_status = MPI_Init(&argc, &argv);
+  }
+  if (MPI_SUCCESS != mpi_init_status) {
     std::cout << "### FATAL ERROR in ParthenonInit" << std::endl
               << "MPI Initialization failed." << std::endl;
     return ParthenonStatus::error;
@@ -158,6 +174,27 @@ ParthenonStatus ParthenonManager::ParthenonInitEnv(int argc, char *argv[]) {
                            Globals::sparse_config.deallocation_threshold);
   Globals::sparse_config.deallocation_count = pinput->GetOrAddInteger(
       "parthenon/sparse", "dealloc_count", Globals::sparse_config.deallocation_count);
+  Globals::sparse_config.pool_storage = pinput->GetOrAddBoolean(
+      "parthenon/sparse", "pool_storage", Globals::sparse_config.pool_storage);
+
+  // set block arena config
+  Globals::block_arena.enabled = pinput->GetOrAddBoolean(
+      "parthenon/mesh", "block_arena", Globals::block_arena.enabled);
+  Globals::block_arena.alignment = pinput->GetOrAddInteger(
+      "parthenon/mesh", "block_arena_alignment", Globals::block_arena.alignment);
+  PARTHENON_REQUIRE_THROWS(
+      Globals::block_arena.alignment > 0 &&
+          Globals::block_arena.alignment % sizeof(Real) == 0,
+      "parthenon/mesh/block_arena_alignment must be a positive multiple of sizeof(Real)");
+  const std::string interleave =
+      pinput->GetOrAddString("parthenon/mesh", "block_arena_interleave", "grouped");
+  if (interleave == "grouped") {
+    Globals::block_arena.interleave = Globals::BlockArenaConfig::Interleave::grouped;
+  } else if (interleave == "variable") {
+    Globals::block_arena.interleave = Globals::BlockArenaConfig::Interleave::variable;
+  } else {
+    PARTHENON_THROW("Unknown parthenon/mesh/block_arena_interleave " + interleave);
+  }
 
   // set timeout config
   Globals::receive_boundary_buffer_timeout =
@@ -229,9 +266,14 @@ void ParthenonManager::ParthenonInitPackagesAndMesh(
 }
 
 ParthenonStatus ParthenonManager::ParthenonFinalize() {
+#ifdef ENABLE_HDF5
+  // Asynchronous outputs still need MPI
+  HDF5::WaitForAsyncWrites();
+#endif
   pmesh.reset();
   Kokkos::finalize();
 #ifdef MPI_PARALLEL
+  CommunicatorPool::Get().Clear();
   MPI_Finalize();
 #endif
   return ParthenonStatus::complete;
@@ -315,63 +357,121 @@ void ParthenonManager::RestartPackages(Mesh &rm, RestartReader &resfile) {
       num_sparse == sparse_info.num_sparse,
       "Mismatch between sparse fields in simulation and restart file");
 
-  std::vector<Real> tmp(static_cast<size_t>(nb) * max_fillsize);
+  // Time spent in the different stages of the restart, reported at the end
+  enum RestartStage {
+    stage_read,
+    stage_allocate,
+    stage_copy,
+    stage_unpack,
+    stage_swarms,
+    stage_params,
+    nstages
+  };
+  std::array<double, nstages> stage_time{};
+  Kokkos::Timer stage_timer;
+  auto end_stage = [&](RestartStage stage) {
+    stage_time[stage] += stage_timer.seconds();
+    stage_timer.reset();
+  };
+
+  // Each variable is read for all local blocks at once into a host buffer, copied to the
+  // device with a single transfer, and unpacked into the blocks by a single kernel.
+  // Without a separate device memory space the data is unpacked from the host buffer.
+  constexpr bool unpack_on_host = std::is_same<DevMemSpace, HostPinnedMemSpace>::value;
+  const size_t buffer_size = static_cast<size_t>(nb) * max_fillsize;
+  Kokkos::View<Real *, LayoutWrapper, HostPinnedMemSpace> tmp_h(
+      Kokkos::view_alloc(Kokkos::WithoutInitializing, "restart buffer"), buffer_size);
+  ParArray1D<Real> tmp_d("restart buffer", unpack_on_host ? 0 : buffer_size);
+  OutputUtils::BlockVarDataArr_t block_vars("restart block vars", nb);
+  auto block_vars_h = Kokkos::create_mirror_view(block_vars);
+  end_stage(stage_allocate);
+
   for (const auto &v_info : all_vars_info) {
     const auto vlen = v_info.num_components * v_info.ntop_elems;
-    const auto fill_size = v_info.FillSize(theDomain);
     const auto &label = v_info.label;
 
     if (Globals::my_rank == 0) {
       std::cout << "Var: " << label << ":" << vlen << std::endl;
     }
-    // Read relevant data from the hdf file, this works for dense and sparse variables
+    // ReadBlocks is collective, so all ranks have to agree on skipping a variable
+    // before any of them starts reading it
+    int found = resfile.HasDataset(label) ? 1 : 0;
+#ifdef MPI_PARALLEL
+    PARTHENON_MPI_CHECK(
+        MPI_Allreduce(MPI_IN_PLACE, &found, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD));
+#endif
+    if (!found) {
+      if (Globals::my_rank == 0) {
+        std::cout << "WARNING: Variable " << label
+                  << " not found in restart file, skipping it" << std::endl;
+      }
+      continue;
+    }
+    // Read relevant data from the hdf file, this works for dense and sparse variables.
+    // A rank that fails here can't be skipped without leaving the others hanging in the
+    // collective read, so failures are fatal.
     try {
-      resfile.ReadBlocks(label, myBlocks, v_info, tmp, file_output_format_ver);
+      resfile.ReadBlocks(label, myBlocks, v_info, tmp_h.data(), buffer_size,
+                         file_output_format_ver);
     } catch (std::exception &ex) {
-      std::cout << "[" << Globals::my_rank << "] WARNING: Failed to read variable "
-                << label << " from restart file:" << std::endl
-                << ex.what() << std::endl;
-      continue;
+      std::stringstream msg;
+      msg << "[" << Globals::my_rank << "] Failed to read variable " << label
+          << " from restart file:" << std::endl
+          << ex.what() << std::endl;
+      PARTHENON_FAIL(msg);
     }
+    end_stage(stage_read);
 
-    size_t index = 0;
-    for (auto &pmb : rm.block_list) {
+    for (int b = 0; b < nb; ++b) {
+      auto &pmb = rm.block_list[b];
+      bool is_allocated = true;
       if (v_info.is_sparse) {
         // check if the sparse variable is allocated on this block
-        if (sparse_info.IsAllocated(pmb->gid, sparse_idxs.at(label))) {
+        is_allocated = sparse_info.IsAllocated(pmb->gid, sparse_idxs.at(label));
+        if (is_allocated) {
           pmb->AllocateSparse(label);
           auto dealloc_count = sparse_info.DeallocCount(pmb->gid, sparse_idxs.at(label));
           // Warning: For this to work, it is required that the controlling variable is
           // stored in the restart files.
           pmb->meshblock_data.Get()->GetVarPtr(label)->dealloc_count = dealloc_count;
-        } else {
-          // nothing to read for this block, advance reading index
-          index += fill_size;
-          continue;
         }
       }
-
-      auto v = pmb->meshblock_data.Get()->GetVarPtr(label);
-      auto v_h = v->data.GetHostMirror();
-
-      // Double note that this also needs to be update in case
-      // we update the HDF5 infrastructure!
-      if (file_output_format_ver >= HDF5::OUTPUT_VERSION_FORMAT - 1) {
-        OutputUtils::PackOrUnpackVar(
-            v_info, resfile.HasGhost() != 0, index,
-            [&](auto index, int topo, int t, int u, int v, int k, int j, int i) {
-              v_h(topo, t, u, v, k, j, i) = tmp[index];
-            });
-      } else {
-        std::stringstream msg;
-        msg << "File format version " << file_output_format_ver << " not supported. "
-            << "Current format is " << HDF5::OUTPUT_VERSION_FORMAT << std::endl;
-        PARTHENON_THROW(msg)
-      }
-
-      v->data.DeepCopy(v_h);
+      // nothing to read for blocks on which the variable is not allocated
+      block_vars_h(b).allocated = is_allocated;
+      block_vars_h(b).data = is_allocated
+                                 ? pmb->meshblock_data.Get()->GetVarPtr(label)->data
+                                 : ParArrayND<Real, VariableState>();
+    }
+    Kokkos::deep_copy(block_vars, block_vars_h);
+    end_stage(stage_allocate);
+
+    // Double note that this also needs to be update in case
+    // we update the HDF5 infrastructure!
+    const OutputUtils::BlockVarIndexer idxer(v_info, resfile.HasGhost() != 0);
+    const int fill_size = idxer.fill_size;
+    const size_t var_size = static_cast<size_t>(nb) * fill_size;
+    using unmanaged_t = Kokkos::View<Real *, LayoutWrapper, DevMemSpace, MemUnmanaged>;
+    unmanaged_t tmp(unpack_on_host ? tmp_h.data() : tmp_d.data(), var_size);
+    if constexpr (!unpack_on_host) {
+      Kokkos::deep_copy(
+          tmp, Kokkos::subview(tmp_h, std::make_pair(static_cast<size_t>(0), var_size)));
     }
+    end_stage(stage_copy);
+
+    parthenon::par_for(
+        loop_pattern_mdrange_tag, "RestartPackages::UnpackVariable", DevExecSpace(), 0,
+        nb - 1, 0, fill_size - 1, KOKKOS_LAMBDA(const int b, const int n) {
+          if (!block_vars(b).allocated) return;
+          int topo, t, u, v, k, j, i;
+          idxer.GetIndices(n, topo, t, u, v, k, j, i);
+          block_vars(b).data(topo, t, u, v, k, j, i) =
+              tmp(static_cast<size_t>(b) * fill_size + n);
+        });
+    Kokkos::fence("RestartPackages::UnpackVariable");
+    end_stage(stage_unpack);
   }
+  // Release the references to the variable data held by the mirror
+  block_vars_h = decltype(block_vars_h)();
 
   // Swarm data
   using FC = parthenon::Metadata::FlagCollection;
@@ -401,6 +501,8 @@ void ParthenonManager::RestartPackages(Mesh &rm, RestartReader &resfile) {
     ReadSwarmVars_<Real>(swarm, rm.block_list, count_on_rank, offsets[0]);
   }
 
+  end_stage(stage_swarms);
+
   // Params
   // ============================================================
   // packages and params are owned by shared pointer, so reading from
@@ -409,6 +511,20 @@ void ParthenonManager::RestartPackages(Mesh &rm, RestartReader &resfile) {
     auto &params = pkg->AllParams();
     resfile.ReadParams(name, params);
   }
+  end_stage(stage_params);
+
+  // Report the slowest rank for each stage
+#ifdef MPI_PARALLEL
+  PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, stage_time.data(), nstages, MPI_DOUBLE,
+                                    MPI_MAX, MPI_COMM_WORLD));
+#endif
+  if (Globals::my_rank == 0) {
+    std::cout << "Restart timing breakdown [s]: read " << stage_time[stage_read]
+              << ", allocate " << stage_time[stage_allocate] << ", host to device copy "
+              << stage_time[stage_copy] << ", unpack " << stage_time[stage_unpack]
+              << ", swarms " << stage_time[stage_swarms] << ", params "
+              << stage_time[stage_params] << std::endl;
+  }
 #endif // ifdef ENABLE_HDF5
 }
 
@@ -238,23 +238,22 @@ class BiCGSTABSolver {
     auto get_t = eqs_.template Ax<u, t>(itl, pre_t_comm, md);
 
     // 8. omega <- (t,s) / (t,t)
-    auto get_ts = DotProduct<t, s>(get_t, itl, &ts, md);
-    auto get_tt = DotProduct<t, t>(get_t, itl, &tt, md);
+    auto get_ts_tt = DotProducts<DotPair<t, s>, DotPair<t, t>>(get_t, itl, &ts_tt, md);
 
     // 9. x <- h + omega u
     auto correct_x = itl.AddTask(
-        get_tt | get_ts, "x <- h + omega u",
+        get_ts_tt, "x <- h + omega u",
         [](BiCGSTABSolver *solver, std::shared_ptr<MeshData<Real>> &md) {
-          Real omega = solver->ts.val / solver->tt.val;
+          Real omega = solver->ts_tt.val[0] / solver->ts_tt.val[1];
           return AddFieldsAndStore<h, u, x>(md, 1.0, omega);
         },
         this, md);
 
     // 10. r <- s - omega t
     auto correct_r = itl.AddTask(
-        get_tt | get_ts, "r <- s - omega t",
+        get_ts_tt, "r <- s - omega t",
         [](BiCGSTABSolver *solver, std::shared_ptr<MeshData<Real>> &md) {
-          Real omega = solver->ts.val / solver->tt.val;
+          Real omega = solver->ts_tt.val[0] / solver->ts_tt.val[1];
           return AddFieldsAndStore<s, t, r>(md, 1.0, -omega);
         },
         this, md);
@@ -281,7 +280,7 @@ class BiCGSTABSolver {
         get_rhat0r | get_res2, "p <- r + beta * (p - omega * v)",
         [](BiCGSTABSolver *solver, std::shared_ptr<MeshData<Real>> &md) {
           Real alpha = solver->rhat0r_old / solver->rhat0v.val;
-          Real omega = solver->ts.val / solver->tt.val;
+          Real omega = solver->ts_tt.val[0] / solver->ts_tt.val[1];
           Real beta = solver->rhat0r.val / solver->rhat0r_old * alpha / omega;
           AddFieldsAndStore<p, v, p>(md, 1.0, -omega);
           return AddFieldsAndStore<r, p, p>(md, 1.0, beta);
@@ -325,7 +324,8 @@ class BiCGSTABSolver {
   preconditioner_t preconditioner;
   BiCGSTABParams params_;
   int iter_counter;
-  AllReduce<Real> rtr, pAp, rhat0v, rhat0r, ts, tt, residual, rhs2;
+  AllReduce<Real> rtr, pAp, rhat0v, rhat0r, residual, rhs2;
+  AllReduce<std::vector<Real>> ts_tt;
   Real rhat0r_old;
   equations eqs_;
   Real final_residual;
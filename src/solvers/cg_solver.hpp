@@ -0,0 +1,332 @@
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#ifndef SOLVERS_CG_SOLVER_HPP_
+#define SOLVERS_CG_SOLVER_HPP_
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "interface/mesh_data.hpp"
+#include "interface/meshblock_data.hpp"
+#include "interface/state_descriptor.hpp"
+#include "kokkos_abstraction.hpp"
+#include "solvers/mg_solver.hpp"
+#include "solvers/solver_utils.hpp"
+#include "tasks/tasks.hpp"
+#include "utils/type_list.hpp"
+
+namespace parthenon {
+
+namespace solvers {
+
+struct PipelinedCGParams {
+  MGParams mg_params;
+  int max_iters = 1000;
+  std::shared_ptr<Real> residual_tolerance = std::make_shared<Real>(1.e-12);
+  bool precondition = true;
+  bool print_per_step = false;
+  bool relative_residual = false;
+  PipelinedCGParams() = default;
+  PipelinedCGParams(ParameterInput *pin, const std::string &input_block) {
+    max_iters = pin->GetOrAddInteger(input_block, "max_iterations", max_iters);
+    *residual_tolerance =
+        pin->GetOrAddReal(input_block, "residual_tolerance", *residual_tolerance);
+    precondition = pin->GetOrAddBoolean(input_block, "precondition", precondition);
+    print_per_step = pin->GetOrAddBoolean(input_block, "print_per_step", print_per_step);
+    mg_params = MGParams(pin, input_block);
+    relative_residual =
+        pin->GetOrAddBoolean(input_block, "relative_residual", relative_residual);
+  }
+};
+
+// Preconditioned conjugate gradient solver for symmetric positive (or negative)
+// definite systems in the pipelined formulation of Ghysels & Vanroose (2014). All dot
+// products of an iteration are gathered in a single non-blocking reduction, which is in
+// flight while the preconditioner and the matrix are applied, so that each iteration
+// only contains one global synchronization. The price is four additional vectors and a
+// somewhat larger sensitivity to round off compared to standard CG. The residual that
+// is checked for convergence lags one iteration behind the solution.
+//
+// The equations class must include a template method
+//
+//   template <class x_t, class y_t, class TL_t>
+//   TaskID Ax(TL_t &tl, TaskID depends_on, std::shared_ptr<MeshData<Real>> &md)
+//
+// that takes a field associated with x_t and applies
+// the matrix A to it and stores the result in y_t.
+template <class u, class rhs, class equations>
+class PipelinedCGSolver {
+ public:
+  PARTHENON_INTERNALSOLVERVARIABLE(u, x);  // Solution
+  PARTHENON_INTERNALSOLVERVARIABLE(u, r);  // Residual
+  PARTHENON_INTERNALSOLVERVARIABLE(u, mr); // Preconditioned residual M r
+  PARTHENON_INTERNALSOLVERVARIABLE(u, w);  // A M r
+  PARTHENON_INTERNALSOLVERVARIABLE(u, n);  // A M w
+  PARTHENON_INTERNALSOLVERVARIABLE(u, p);  // Search direction
+  PARTHENON_INTERNALSOLVERVARIABLE(u, s);  // A p
+  PARTHENON_INTERNALSOLVERVARIABLE(u, q);  // M A p
+  PARTHENON_INTERNALSOLVERVARIABLE(u, z);  // A M A p
+
+  using internal_types_tl = TypeList<x, r, mr, w, n, p, s, q, z>;
+  using preconditioner_t = MGSolver<u, rhs, equations>;
+  using all_internal_types_tl =
+      concatenate_type_lists_t<internal_types_tl,
+                               typename preconditioner_t::internal_types_tl>;
+
+  std::vector<std::string> GetInternalVariableNames() const {
+    std::vector<std::string> names;
+    if (params_.precondition) {
+      all_internal_types_tl::IterateTypes(
+          [&names](auto t) { names.push_back(decltype(t)::name()); });
+    } else {
+      internal_types_tl::IterateTypes(
+          [&names](auto t) { names.push_back(decltype(t)::name()); });
+    }
+    return names;
+  }
+
+  PipelinedCGSolver(StateDescriptor *pkg, PipelinedCGParams params_in,
+                    equations eq_in = equations(), std::vector<int> shape = {},
+                    const std::string &container = "base")
+      : preconditioner(pkg, params_in.mg_params, eq_in, shape, container),
+        params_(params_in), iter_counter(0), eqs_(eq_in), container_(container) {
+    auto m_no_ghost =
+        Metadata({Metadata::Cell, Metadata::Derived, Metadata::OneCopy}, shape);
+    internal_types_tl::IterateTypes(
+        [&](auto t) { pkg->AddField(decltype(t)::name(), m_no_ghost); });
+  }
+
+  template <class TL_t>
+  TaskID AddSetupTasks(TL_t &tl, TaskID dependence, int partition, Mesh *pmesh) {
+    return preconditioner.AddSetupTasks(tl, dependence, partition, pmesh);
+  }
+
+  TaskID AddTasks(TaskList &tl, TaskID dependence, Mesh *pmesh, const int partition) {
+    using namespace utils;
+    TaskID none;
+    auto &md = pmesh->mesh_data.GetOrAdd(container_, partition);
+    std::string label = container_ + "pcg_comm_" + std::to_string(partition);
+    auto &md_comm =
+        pmesh->mesh_data.AddShallow(label, md, std::vector<std::string>{u::name()});
+    iter_counter = 0;
+    bool multilevel = pmesh->multilevel;
+
+    // Initialization: x <- 0, r <- rhs, mr <- M r, w <- A mr, p, s, q, z <- 0
+    auto zero_x = tl.AddTask(dependence, TF(SetToZero<x>), md);
+    auto zero_p = tl.AddTask(dependence, TF(SetToZero<p>), md);
+    auto zero_s = tl.AddTask(dependence, TF(SetToZero<s>), md);
+    auto zero_q = tl.AddTask(dependence, TF(SetToZero<q>), md);
+    auto zero_z = tl.AddTask(dependence, TF(SetToZero<z>), md);
+    auto copy_r = tl.AddTask(dependence, TF(CopyData<rhs, r>), md);
+    auto get_rhs2 = copy_r;
+    if (params_.relative_residual)
+      get_rhs2 = DotProduct<rhs, rhs>(dependence, tl, &rhs2, md);
+    auto precon0 =
+        AddPreconditionerTasks<rhs>(tl, copy_r | get_rhs2, partition, pmesh, md);
+    auto copy_mr = tl.AddTask(precon0, TF(CopyData<u, mr>), md);
+    auto comm0 =
+        AddBoundaryExchangeTasks<BoundaryType::any>(precon0, tl, md_comm, multilevel);
+    auto get_w = eqs_.template Ax<u, w>(tl, comm0, md);
+    auto initialize = tl.AddTask(
+        TaskQualifier::once_per_region | TaskQualifier::local_sync,
+        zero_x | zero_p | zero_s | zero_q | zero_z | copy_mr | get_w, "zero factors",
+        [](PipelinedCGSolver *solver) {
+          solver->iter_counter = -1;
+          return TaskStatus::complete;
+        },
+        this);
+    tl.AddTask(
+        TaskQualifier::once_per_region, initialize, "print to screen",
+        [](PipelinedCGSolver *solver, Mesh *pmesh, std::shared_ptr<Real> res_tol,
+           bool relative_residual) {
+          if (Globals::my_rank == 0 && solver->params_.print_per_step) {
+            Real tol =
+                relative_residual
+                    ? *res_tol * std::sqrt(solver->rhs2.val / pmesh->GetTotalCells())
+                    : *res_tol;
+            printf("# [0] iteration\n# [1] rms-residual (tol = %e) \n", tol);
+          }
+          return TaskStatus::complete;
+        },
+        this, pmesh, params_.residual_tolerance, params_.relative_residual);
+
+    // BEGIN ITERATIVE TASKS
+    auto [itl, solver_id] = tl.AddSublist(initialize, {1, params_.max_iters});
+
+    auto sync = itl.AddTask(TaskQualifier::local_sync, none,
+                            []() { return TaskStatus::complete; });
+    auto reset = itl.AddTask(
+        TaskQualifier::once_per_region | TaskQualifier::local_sync, sync,
+        "zero dot products",
+        [](PipelinedCGSolver *solver) {
+          solver->dots.val.assign(ndots, 0.0);
+          solver->iter_counter++;
+          return TaskStatus::complete;
+        },
+        this);
+
+    // 1. gamma <- (r, mr), delta <- (w, mr), rr <- (r, r) in a single sweep over the
+    //    data and a single reduction
+    auto get_dots = itl.AddTask(
+        TaskQualifier::local_sync, reset,
+        TF(DotProductsLocal<DotPair<r, mr>, DotPair<w, mr>, DotPair<r, r>>), md, &dots,
+        0);
+    auto start_dots =
+        itl.AddTask(TaskQualifier::once_per_region, get_dots,
+                    &AllReduce<std::vector<Real>>::StartReduce, &dots, MPI_SUM);
+
+    // 2. m <- M w, n <- A m while the reduction is in flight, m is stored in u
+    auto precon = AddPreconditionerTasks<w>(itl, start_dots, partition, pmesh, md);
+    auto comm =
+        AddBoundaryExchangeTasks<BoundaryType::any>(precon, itl, md_comm, multilevel);
+    auto get_n = eqs_.template Ax<u, n>(itl, comm, md);
+
+    auto finish_dots =
+        itl.AddTask(TaskQualifier::once_per_region | TaskQualifier::local_sync,
+                    start_dots, &AllReduce<std::vector<Real>>::CheckReduce, &dots);
+
+    // 3. beta <- gamma / gamma_old, alpha <- gamma / (delta - beta gamma / alpha_old)
+    auto get_coeffs = itl.AddTask(
+        TaskQualifier::once_per_region | TaskQualifier::local_sync, finish_dots,
+        "alpha, beta",
+        [](PipelinedCGSolver *solver, Mesh *pmesh) {
+          const Real gamma = solver->dots.val[0];
+          const Real delta = solver->dots.val[1];
+          if (solver->iter_counter == 0) {
+            solver->beta = 0.0;
+            solver->alpha = gamma / delta;
+          } else {
+            solver->beta = gamma / solver->gamma_old;
+            solver->alpha = gamma / (delta - solver->beta * gamma / solver->alpha);
+          }
+          solver->gamma_old = gamma;
+          solver->residual = solver->dots.val[2];
+          Real rms_res = std::sqrt(solver->residual / pmesh->GetTotalCells());
+          if (Globals::my_rank == 0 && solver->params_.print_per_step)
+            printf("%i %e\n", solver->iter_counter, rms_res);
+          return TaskStatus::complete;
+        },
+        this, pmesh);
+
+    // 4. z <- n + beta z, q <- m + beta q, s <- w + beta s, p <- mr + beta p,
+    //    x <- x + alpha p, r <- r - alpha s, mr <- mr - alpha q, w <- w - alpha z
+    auto update = itl.AddTask(get_coeffs | get_n,
+                              TF(&PipelinedCGSolver::PipelinedUpdate), this, md);
+
+    auto check = itl.AddTask(
+        TaskQualifier::completion, update, "check residual",
+        [partition](PipelinedCGSolver *solver, Mesh *pmesh, int max_iter,
+                    std::shared_ptr<Real> res_tol, bool relative_residual) {
+          Real rms_res = std::sqrt(solver->residual / pmesh->GetTotalCells());
+          solver->final_residual = rms_res;
+          solver->final_iteration = solver->iter_counter;
+          Real tol = relative_residual
+                         ? *res_tol * std::sqrt(solver->rhs2.val / pmesh->GetTotalCells())
+                         : *res_tol;
+          if (rms_res < tol || solver->iter_counter >= max_iter) {
+            return TaskStatus::complete;
+          }
+          return TaskStatus::iterate;
+        },
+        this, pmesh, params_.max_iters, params_.residual_tolerance,
+        params_.relative_residual);
+
+    return tl.AddTask(solver_id, TF(CopyData<x, u>), md);
+  }
+
+  Real GetSquaredResidualSum() const { return residual; }
+  int GetCurrentIterations() const { return iter_counter; }
+
+  Real GetFinalResidual() const { return final_residual; }
+  int GetFinalIterations() const { return final_iteration; }
+
+  PipelinedCGParams &GetParams() { return params_; }
+
+ protected:
+  static constexpr int ndots = 3;
+  preconditioner_t preconditioner;
+  PipelinedCGParams params_;
+  int iter_counter;
+  AllReduce<std::vector<Real>> dots;
+  AllReduce<Real> rhs2;
+  Real alpha, beta, gamma_old, residual;
+  equations eqs_;
+  Real final_residual;
+  int final_iteration;
+  std::string container_;
+
+  // u <- M in, where M is the multigrid preconditioner or the identity
+  template <class in_t>
+  TaskID AddPreconditionerTasks(TaskList &tl, TaskID dependence, int partition,
+                                Mesh *pmesh, std::shared_ptr<MeshData<Real>> &md) {
+    using namespace utils;
+    if (params_.precondition) {
+      auto set_rhs = dependence;
+      if constexpr (!std::is_same_v<in_t, rhs>)
+        set_rhs = tl.AddTask(dependence, TF(CopyData<in_t, rhs>), md);
+      auto zero_u = tl.AddTask(dependence, TF(SetToZero<u>), md);
+      return preconditioner.AddLinearOperatorTasks(tl, set_rhs | zero_u, partition,
+                                                   pmesh);
+    }
+    return tl.AddTask(dependence, TF(CopyData<in_t, u>), md);
+  }
+
+  // These functions apparently have to be public to compile with cuda since
+  // they contain device side lambdas
+ public:
+  TaskStatus PipelinedUpdate(std::shared_ptr<MeshData<Real>> &md) {
+    using TE = parthenon::TopologicalElement;
+    TE te = TE::CC;
+    IndexRange ib = md->GetBoundsI(IndexDomain::interior, te);
+    IndexRange jb = md->GetBoundsJ(IndexDomain::interior, te);
+    IndexRange kb = md->GetBoundsK(IndexDomain::interior, te);
+
+    static auto desc =
+        parthenon::MakePackDescriptor<u, x, r, mr, w, n, p, s, q, z>(md.get());
+    auto pack = desc.GetPack(md.get());
+    const Real alpha_k = alpha;
+    const Real beta_k = beta;
+    parthenon::par_for(
+        "PipelinedCGUpdate", 0, pack.GetNBlocks() - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+        ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          const int nvars = pack.GetUpperBound(b, u()) - pack.GetLowerBound(b, u()) + 1;
+          for (int c = 0; c < nvars; ++c) {
+            Real &vz = pack(b, te, z(c), k, j, i);
+            Real &vq = pack(b, te, q(c), k, j, i);
+            Real &vs = pack(b, te, s(c), k, j, i);
+            Real &vp = pack(b, te, p(c), k, j, i);
+            Real &vmr = pack(b, te, mr(c), k, j, i);
+            Real &vw = pack(b, te, w(c), k, j, i);
+            vz = pack(b, te, n(c), k, j, i) + beta_k * vz;
+            vq = pack(b, te, u(c), k, j, i) + beta_k * vq;
+            vs = vw + beta_k * vs;
+            vp = vmr + beta_k * vp;
+            pack(b, te, x(c), k, j, i) += alpha_k * vp;
+            pack(b, te, r(c), k, j, i) -= alpha_k * vs;
+            vmr -= alpha_k * vq;
+            vw -= alpha_k * vz;
+          }
+        });
+    return TaskStatus::complete;
+  }
+};
+
+} // namespace solvers
+
+} // namespace parthenon
+
+#endif // SOLVERS_CG_SOLVER_HPP_
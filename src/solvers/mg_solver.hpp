@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -40,6 +41,10 @@ struct MGParams {
   std::string smoother = "SRJ2";
   bool two_by_two_diagonal = false;
   int max_coarsenings = std::numeric_limits<int>::max();
+  int coarsest_sweeps = 1;
+  int chebyshev_degree = 2;
+  int chebyshev_power_iterations = 10;
+  Real chebyshev_eigenvalue_ratio = 30.0;
 
   MGParams() = default;
   MGParams(ParameterInput *pin, const std::string &input_block) {
@@ -52,6 +57,14 @@ struct MGParams {
         pin->GetOrAddBoolean(input_block, "two_by_two_diagonal", two_by_two_diagonal);
     max_coarsenings =
         pin->GetOrAddInteger(input_block, "max_coarsenings", max_coarsenings);
+    coarsest_sweeps =
+        pin->GetOrAddInteger(input_block, "coarsest_sweeps", coarsest_sweeps);
+    chebyshev_degree =
+        pin->GetOrAddInteger(input_block, "chebyshev_degree", chebyshev_degree);
+    chebyshev_power_iterations = pin->GetOrAddInteger(
+        input_block, "chebyshev_power_iterations", chebyshev_power_iterations);
+    chebyshev_eigenvalue_ratio = pin->GetOrAddReal(
+        input_block, "chebyshev_eigenvalue_ratio", chebyshev_eigenvalue_ratio);
   }
 };
 
@@ -69,6 +82,13 @@ struct MGParams {
 //
 // That stores the (possibly approximate) diagonal of matrix A in the field
 // associated with the type diag_t. This is used for Jacobi iteration.
+//
+// The smoother is chosen by MGParams::smoother, either one of the scheduled relaxed
+// Jacobi smoothers "SRJ1", "SRJ2" and "SRJ3", "none", or "Chebyshev". The latter
+// applies a Chebyshev polynomial of degree chebyshev_degree in D^-1 A, which damps
+// the eigenvalues in [lambda_max / chebyshev_eigenvalue_ratio, lambda_max]. The
+// largest eigenvalue of D^-1 A is estimated on each level by power iterations in the
+// setup tasks, so AddSetupTasks must be run before the Chebyshev smoother is used.
 template <class u, class rhs, class equations>
 class MGSolver {
  public:
@@ -192,12 +212,44 @@ class MGSolver {
                              pmesh->GetGMGMinLevel());
     int max_level = pmesh->GetGMGMaxLevel();
 
+    if (params_.smoother == "Chebyshev") {
+      dependence = tl.AddTask(
+          TaskQualifier::once_per_region | TaskQualifier::local_sync, dependence,
+          [](MGSolver *solver, int nlevels) {
+            solver->eig_sums_.val.assign(2 * nlevels, 0.0);
+            return TaskStatus::complete;
+          },
+          this, max_level - min_level + 1);
+    }
+
     auto mg_setup = dependence;
     for (int level = max_level; level >= min_level; --level) {
       mg_setup =
           mg_setup | AddMultiGridSetupPartitionLevel(tl, dependence, partition, level,
                                                      min_level, max_level, pmesh);
     }
+
+    if (params_.smoother == "Chebyshev") {
+      // All levels share a single reduction for their eigenvalue estimates
+      auto start_eig =
+          tl.AddTask(TaskQualifier::once_per_region | TaskQualifier::local_sync,
+                     mg_setup, &AllReduce<std::vector<Real>>::StartReduce, &eig_sums_,
+                     MPI_SUM);
+      auto finish_eig =
+          tl.AddTask(TaskQualifier::once_per_region | TaskQualifier::local_sync,
+                     start_eig, &AllReduce<std::vector<Real>>::CheckReduce, &eig_sums_);
+      mg_setup = tl.AddTask(
+          TaskQualifier::once_per_region | TaskQualifier::local_sync, finish_eig,
+          [](MGSolver *solver, int min_level, int max_level) {
+            for (int level = min_level; level <= max_level; ++level) {
+              const Real xAx = solver->eig_sums_.val[2 * (level - min_level)];
+              const Real xDx = solver->eig_sums_.val[2 * (level - min_level) + 1];
+              solver->lambda_max_[level] = xDx > 0.0 ? xAx / xDx : 1.0;
+            }
+            return TaskStatus::complete;
+          },
+          this, min_level, max_level);
+    }
     return mg_setup;
   }
 
@@ -214,6 +266,10 @@ class MGSolver {
   Real final_residual;
   int final_iteration;
   std::string container_;
+  // Eigenvalue estimates for the Chebyshev smoother, the sums x.Ax and x.Dx of the
+  // last power iteration of every level are reduced together
+  AllReduce<std::vector<Real>> eig_sums_;
+  std::map<int, Real> lambda_max_;
 
   // These functions apparently have to be public to compile with cuda since
   // they contain device side lambdas
@@ -295,6 +351,190 @@ class MGSolver {
     return TaskStatus::complete;
   }
 
+  // Applies step of the Chebyshev smoother on a level, i.e.
+  //   d <- wd * d + wr * D^-1 (rhs - Ax),  x <- x + d
+  // where the weights follow from the three term recurrence of the Chebyshev
+  // polynomials on the interval of eigenvalues that is damped
+  template <class rhs_t, class Ax_t, class D_t, class d_t, class x_t>
+  TaskStatus ChebyshevStep(std::shared_ptr<MeshData<Real>> &md, int level, int step) {
+    using namespace parthenon;
+    using TE = parthenon::TopologicalElement;
+    TE te = TE::CC;
+    IndexRange ib = md->GetBoundsI(IndexDomain::interior, te);
+    IndexRange jb = md->GetBoundsJ(IndexDomain::interior, te);
+    IndexRange kb = md->GetBoundsK(IndexDomain::interior, te);
+
+    PARTHENON_REQUIRE(lambda_max_.count(level) > 0,
+                      "The Chebyshev smoother requires the MG setup tasks to be run.");
+    // Stretch the estimate a bit, since power iterations approach lambda_max from below
+    const Real upper = 1.1 * lambda_max_[level];
+    const Real lower = upper / params_.chebyshev_eigenvalue_ratio;
+    const Real theta = 0.5 * (upper + lower);
+    const Real delta = 0.5 * (upper - lower);
+    const Real sigma = theta / delta;
+    Real rho = 1.0 / sigma;
+    Real wd = 0.0;
+    Real wr = 1.0 / theta;
+    for (int s = 1; s <= step; ++s) {
+      const Real rho_new = 1.0 / (2.0 * sigma - rho);
+      wd = rho_new * rho;
+      wr = 2.0 * rho_new / delta;
+      rho = rho_new;
+    }
+
+    static auto desc =
+        parthenon::MakePackDescriptor<rhs_t, Ax_t, D_t, d_t, x_t>(md.get());
+    auto pack = desc.GetPack(md.get());
+    const bool two_by_two = params_.two_by_two_diagonal;
+    // The direction is not read in the first step, it may hold anything on entry
+    const bool first = (step == 0);
+    parthenon::par_for(
+        "ChebyshevStep", 0, pack.GetNBlocks() - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          if (two_by_two) {
+            const Real D11 = pack(b, te, D_t(0), k, j, i);
+            const Real D22 = pack(b, te, D_t(1), k, j, i);
+            const Real D12 = pack(b, te, D_t(2), k, j, i);
+            const Real D21 = pack(b, te, D_t(3), k, j, i);
+            const Real det = D11 * D22 - D12 * D21;
+            const Real t0 =
+                pack(b, te, rhs_t(0), k, j, i) - pack(b, te, Ax_t(0), k, j, i);
+            const Real t1 =
+                pack(b, te, rhs_t(1), k, j, i) - pack(b, te, Ax_t(1), k, j, i);
+            const Real r0 = (D22 * t0 - D12 * t1) / det;
+            const Real r1 = (-D21 * t0 + D11 * t1) / det;
+            Real &d0 = pack(b, te, d_t(0), k, j, i);
+            Real &d1 = pack(b, te, d_t(1), k, j, i);
+            d0 = (first ? 0.0 : wd * d0) + wr * r0;
+            d1 = (first ? 0.0 : wd * d1) + wr * r1;
+            pack(b, te, x_t(0), k, j, i) += d0;
+            pack(b, te, x_t(1), k, j, i) += d1;
+          } else {
+            const int nvars =
+                pack.GetUpperBound(b, x_t()) - pack.GetLowerBound(b, x_t()) + 1;
+            for (int c = 0; c < nvars; ++c) {
+              const Real r = robust::ratio(
+                  pack(b, te, rhs_t(c), k, j, i) - pack(b, te, Ax_t(c), k, j, i),
+                  pack(b, te, D_t(c), k, j, i));
+              Real &d = pack(b, te, d_t(c), k, j, i);
+              d = (first ? 0.0 : wd * d) + wr * r;
+              pack(b, te, x_t(c), k, j, i) += d;
+            }
+          }
+        });
+    return TaskStatus::complete;
+  }
+
+  // Starting vector of the power iterations. A checkerboard is (close to) the
+  // eigenvector of D^-1 A with the largest eigenvalue for diffusion type operators.
+  template <class x_t>
+  TaskStatus InitializePowerIteration(std::shared_ptr<MeshData<Real>> &md) {
+    using TE = parthenon::TopologicalElement;
+    TE te = TE::CC;
+    IndexRange ib = md->GetBoundsI(IndexDomain::interior, te);
+    IndexRange jb = md->GetBoundsJ(IndexDomain::interior, te);
+    IndexRange kb = md->GetBoundsK(IndexDomain::interior, te);
+
+    static auto desc = parthenon::MakePackDescriptor<x_t>(md.get());
+    auto pack = desc.GetPack(md.get());
+    parthenon::par_for(
+        "InitializePowerIteration", 0, pack.GetNBlocks() - 1, kb.s, kb.e, jb.s, jb.e,
+        ib.s, ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          const int nvars =
+              pack.GetUpperBound(b, x_t()) - pack.GetLowerBound(b, x_t()) + 1;
+          for (int c = 0; c < nvars; ++c)
+            pack(b, te, x_t(c), k, j, i) = (i + j + k) % 2 == 0 ? 1.0 : -1.0;
+        });
+    return TaskStatus::complete;
+  }
+
+  // x <- D^-1 Ax, the iterate is not normalized since only a few iterations are done
+  // and the Rayleigh quotient does not depend on its scale
+  template <class Ax_t, class D_t, class x_t>
+  TaskStatus PowerIterationStep(std::shared_ptr<MeshData<Real>> &md) {
+    using TE = parthenon::TopologicalElement;
+    TE te = TE::CC;
+    IndexRange ib = md->GetBoundsI(IndexDomain::interior, te);
+    IndexRange jb = md->GetBoundsJ(IndexDomain::interior, te);
+    IndexRange kb = md->GetBoundsK(IndexDomain::interior, te);
+
+    static auto desc = parthenon::MakePackDescriptor<Ax_t, D_t, x_t>(md.get());
+    auto pack = desc.GetPack(md.get());
+    const bool two_by_two = params_.two_by_two_diagonal;
+    parthenon::par_for(
+        "PowerIterationStep", 0, pack.GetNBlocks() - 1, kb.s, kb.e, jb.s, jb.e, ib.s,
+        ib.e, KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          if (two_by_two) {
+            const Real D11 = pack(b, te, D_t(0), k, j, i);
+            const Real D22 = pack(b, te, D_t(1), k, j, i);
+            const Real D12 = pack(b, te, D_t(2), k, j, i);
+            const Real D21 = pack(b, te, D_t(3), k, j, i);
+            const Real det = D11 * D22 - D12 * D21;
+            const Real t0 = pack(b, te, Ax_t(0), k, j, i);
+            const Real t1 = pack(b, te, Ax_t(1), k, j, i);
+            pack(b, te, x_t(0), k, j, i) = (D22 * t0 - D12 * t1) / det;
+            pack(b, te, x_t(1), k, j, i) = (-D21 * t0 + D11 * t1) / det;
+          } else {
+            const int nvars =
+                pack.GetUpperBound(b, x_t()) - pack.GetLowerBound(b, x_t()) + 1;
+            for (int c = 0; c < nvars; ++c)
+              pack(b, te, x_t(c), k, j, i) = robust::ratio(pack(b, te, Ax_t(c), k, j, i),
+                                                           pack(b, te, D_t(c), k, j, i));
+          }
+        });
+    return TaskStatus::complete;
+  }
+
+  // Adds the local contributions to x.Ax and x.Dx, whose ratio estimates the largest
+  // eigenvalue of D^-1 A, to the sums of the given level
+  template <class Ax_t, class D_t, class x_t>
+  TaskStatus RayleighQuotientLocal(std::shared_ptr<MeshData<Real>> &md, int idx) {
+    using TE = parthenon::TopologicalElement;
+    TE te = TE::CC;
+    IndexRange ib = md->GetBoundsI(IndexDomain::interior, te);
+    IndexRange jb = md->GetBoundsJ(IndexDomain::interior, te);
+    IndexRange kb = md->GetBoundsK(IndexDomain::interior, te);
+
+    static auto desc = parthenon::MakePackDescriptor<Ax_t, D_t, x_t>(md.get());
+    auto pack = desc.GetPack(md.get());
+    const bool two_by_two = params_.two_by_two_diagonal;
+    Real xAx(0);
+    parthenon::par_reduce(
+        parthenon::loop_pattern_mdrange_tag, "RayleighQuotient::xAx", DevExecSpace(), 0,
+        pack.GetNBlocks() - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lsum) {
+          const int nvars =
+              pack.GetUpperBound(b, x_t()) - pack.GetLowerBound(b, x_t()) + 1;
+          for (int c = 0; c < nvars; ++c)
+            lsum += pack(b, te, x_t(c), k, j, i) * pack(b, te, Ax_t(c), k, j, i);
+        },
+        Kokkos::Sum<Real>(xAx));
+    Real xDx(0);
+    parthenon::par_reduce(
+        parthenon::loop_pattern_mdrange_tag, "RayleighQuotient::xDx", DevExecSpace(), 0,
+        pack.GetNBlocks() - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lsum) {
+          if (two_by_two) {
+            const Real x0 = pack(b, te, x_t(0), k, j, i);
+            const Real x1 = pack(b, te, x_t(1), k, j, i);
+            lsum += x0 * (pack(b, te, D_t(0), k, j, i) * x0 +
+                          pack(b, te, D_t(2), k, j, i) * x1) +
+                    x1 * (pack(b, te, D_t(3), k, j, i) * x0 +
+                          pack(b, te, D_t(1), k, j, i) * x1);
+          } else {
+            const int nvars =
+                pack.GetUpperBound(b, x_t()) - pack.GetLowerBound(b, x_t()) + 1;
+            for (int c = 0; c < nvars; ++c)
+              lsum += pack(b, te, x_t(c), k, j, i) * pack(b, te, D_t(c), k, j, i) *
+                      pack(b, te, x_t(c), k, j, i);
+          }
+        },
+        Kokkos::Sum<Real>(xDx));
+    eig_sums_.val[2 * idx] += xAx;
+    eig_sums_.val[2 * idx + 1] += xDx;
+    return TaskStatus::complete;
+  }
+
   template <parthenon::BoundaryType comm_boundary, class in_t, class out_t, class TL_t>
   TaskID AddJacobiIteration(TL_t &tl, TaskID depends_on, bool multilevel, Real omega,
                             std::shared_ptr<MeshData<Real>> &md,
@@ -343,6 +583,64 @@ class MGSolver {
     return tl.AddTask(jacobi3, TF(CopyData<temp, u, true>), md);
   }
 
+  // The search direction of the Chebyshev smoother is stored in res_err, which is
+  // free while smoothing since its content has been consumed before the pre-smooth
+  // and is overwritten after the post-smooth
+  template <parthenon::BoundaryType comm_boundary, class TL_t>
+  TaskID AddChebyshevIteration(TL_t &tl, TaskID depends_on, int degree, int level,
+                               bool multilevel, std::shared_ptr<MeshData<Real>> &md,
+                               std::shared_ptr<MeshData<Real>> &md_comm) {
+    using namespace utils;
+    auto step = depends_on;
+    for (int s = 0; s < degree; ++s) {
+      auto comm = AddBoundaryExchangeTasks<comm_boundary>(step, tl, md_comm, multilevel);
+      auto mat_mult = eqs_.template Ax<u, temp>(tl, comm, md);
+      step = tl.AddTask(mat_mult,
+                        TF(&MGSolver::ChebyshevStep<rhs, temp, D, res_err, u>), this,
+                        md, level, s);
+    }
+    return step;
+  }
+
+  template <parthenon::BoundaryType comm_boundary, class TL_t>
+  TaskID AddSmootherTasks(TL_t &tl, TaskID depends_on, int stages, int level,
+                          bool multilevel, std::shared_ptr<MeshData<Real>> &md,
+                          std::shared_ptr<MeshData<Real>> &md_comm) {
+    if (params_.smoother == "Chebyshev")
+      return AddChebyshevIteration<comm_boundary>(tl, depends_on, stages, level,
+                                                  multilevel, md, md_comm);
+    return AddSRJIteration<comm_boundary>(tl, depends_on, stages, multilevel, md,
+                                          md_comm);
+  }
+
+  // Estimates the largest eigenvalue of D^-1 A on a level by power iterations. The
+  // solution is used as the iterate and restored afterwards.
+  template <class TL_t>
+  TaskID AddEigenvalueEstimateTasks(TL_t &tl, TaskID dependence, int level,
+                                    int min_level, std::shared_ptr<MeshData<Real>> &md,
+                                    std::shared_ptr<MeshData<Real>> &md_comm) {
+    using namespace utils;
+    const bool multilevel = (level != min_level);
+    auto set_diag =
+        tl.AddTask(dependence, TF(&equations::template SetDiagonal<D>), &eqs_, md);
+    auto save_u = tl.AddTask(dependence, TF(CopyData<u, u0, true>), md);
+    auto x = tl.AddTask(save_u, TF(&MGSolver::InitializePowerIteration<u>), this, md);
+    x = x | set_diag;
+    for (int it = 0; it <= params_.chebyshev_power_iterations; ++it) {
+      auto comm =
+          AddBoundaryExchangeTasks<BoundaryType::gmg_same>(x, tl, md_comm, multilevel);
+      auto mat_mult = eqs_.template Ax<u, temp>(tl, comm, md);
+      if (it == params_.chebyshev_power_iterations) {
+        x = tl.AddTask(mat_mult, TF(&MGSolver::RayleighQuotientLocal<temp, D, u>), this,
+                       md, level - min_level);
+      } else {
+        x = tl.AddTask(mat_mult, TF(&MGSolver::PowerIterationStep<temp, D, u>), this,
+                       md);
+      }
+    }
+    return tl.AddTask(x, TF(CopyData<u0, u, true>), md);
+  }
+
   template <class TL_t>
   TaskID AddMultiGridSetupPartitionLevel(TL_t &tl, TaskID dependence, int partition,
                                          int level, int min_level, int max_level,
@@ -361,6 +659,15 @@ class MGSolver {
       task_out = tl.AddTask(task_out, TF(SetBounds<BoundaryType::gmg_restrict_recv>), md);
     }
 
+    // Estimate the spectrum on this level before passing on to the coarser levels, so
+    // the power iterations of different levels do not overlap
+    if (params_.smoother == "Chebyshev") {
+      auto &md_comm = pmesh->mesh_data.AddShallow(
+          "mg_comm", md, std::vector<std::string>{u::name(), res_err::name()});
+      task_out =
+          AddEigenvalueEstimateTasks(tl, task_out, level, min_level, md, md_comm);
+    }
+
     // If we are finer than the coarsest level:
     if (level > min_level) {
       task_out =
@@ -390,6 +697,9 @@ class MGSolver {
     } else if (smoother == "SRJ3") {
       pre_stages = 3;
       post_stages = 3;
+    } else if (smoother == "Chebyshev") {
+      pre_stages = params_.chebyshev_degree;
+      post_stages = params_.chebyshev_degree;
     } else {
       PARTHENON_FAIL("Unknown solver type.");
     }
@@ -449,8 +759,15 @@ class MGSolver {
     // 2. Do pre-smooth and fill solution on this level
     set_from_finer =
         tl.AddTask(set_from_finer, BTF(&equations::template SetDiagonal<D>), &eqs_, md);
-    auto pre_smooth = AddSRJIteration<BoundaryType::gmg_same>(
-        tl, set_from_finer, pre_stages, multilevel, md, md_comm);
+    auto pre_smooth = AddSmootherTasks<BoundaryType::gmg_same>(
+        tl, set_from_finer, pre_stages, level, multilevel, md, md_comm);
+    // On the coarsest level the smoother is repeated to approximate a solve, which is
+    // cheap when the level has been agglomerated onto a few ranks
+    if (level == min_level) {
+      for (int sweep = 1; sweep < params_.coarsest_sweeps; ++sweep)
+        pre_smooth = AddSmootherTasks<BoundaryType::gmg_same>(
+            tl, pre_smooth, pre_stages, level, multilevel, md, md_comm);
+    }
     // If we are finer than the coarsest level:
     auto post_smooth = pre_smooth;
     if (level > min_level) {
@@ -484,8 +801,8 @@ class MGSolver {
           prolongate, BTF(AddFieldsAndStore<u, res_err, u, true>), md, 1.0, 1.0);
 
       // 8. Post smooth using communication field and stored RHS
-      post_smooth = AddSRJIteration<BoundaryType::gmg_same>(tl, update_sol, post_stages,
-                                                            multilevel, md, md_comm);
+      post_smooth = AddSmootherTasks<BoundaryType::gmg_same>(
+          tl, update_sol, post_stages, level, multilevel, md, md_comm);
 
     } else {
       post_smooth = tl.AddTask(pre_smooth, BTF(CopyData<u, res_err, true>), md);
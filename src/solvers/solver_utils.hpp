@@ -22,6 +22,38 @@
 
 #include "kokkos_abstraction.hpp"
 
+namespace parthenon {
+namespace solvers {
+namespace utils {
+namespace impl {
+// Fixed number of sums that are reduced together in a single par_reduce
+template <int N>
+struct SumArray {
+  Real v[N];
+  KOKKOS_INLINE_FUNCTION SumArray() {
+    for (int n = 0; n < N; ++n)
+      v[n] = 0.0;
+  }
+  KOKKOS_INLINE_FUNCTION SumArray &operator+=(const SumArray &other) {
+    for (int n = 0; n < N; ++n)
+      v[n] += other.v[n];
+    return *this;
+  }
+};
+} // namespace impl
+} // namespace utils
+} // namespace solvers
+} // namespace parthenon
+
+namespace Kokkos {
+template <int N>
+struct reduction_identity<parthenon::solvers::utils::impl::SumArray<N>> {
+  KOKKOS_FORCEINLINE_FUNCTION static parthenon::solvers::utils::impl::SumArray<N> sum() {
+    return parthenon::solvers::utils::impl::SumArray<N>();
+  }
+};
+} // namespace Kokkos
+
 #define PARTHENON_INTERNALSOLVERVARIABLE(base, varname)                                  \
   struct varname : public parthenon::variable_names::base_t<false> {                     \
     template <class... Ts>                                                               \
@@ -305,6 +337,87 @@ TaskID DotProduct(TaskID dependency_in, TaskList &tl, AllReduce<Real> *adotb,
   return finish_global_adotb;
 }
 
+// Pair of fields whose inner product is computed by DotProducts, a norm squared is the
+// inner product of a field with itself
+template <class a, class b>
+struct DotPair {
+  using a_t = a;
+  using b_t = b;
+};
+
+namespace impl {
+template <int I, class pack_t>
+KOKKOS_INLINE_FUNCTION void AccumulateDotProducts(const pack_t &pack, const int b,
+                                                  const int k, const int j, const int i,
+                                                  Real *sums) {}
+
+template <int I, class pair, class... pairs, class pack_t>
+KOKKOS_INLINE_FUNCTION void AccumulateDotProducts(const pack_t &pack, const int b,
+                                                  const int k, const int j, const int i,
+                                                  Real *sums) {
+  using a_t = typename pair::a_t;
+  using b_t = typename pair::b_t;
+  constexpr auto te = parthenon::TopologicalElement::CC;
+  const int nvars = pack.GetUpperBound(b, a_t()) - pack.GetLowerBound(b, a_t()) + 1;
+  for (int c = 0; c < nvars; ++c)
+    sums[I] += pack(b, te, a_t(c), k, j, i) * pack(b, te, b_t(c), k, j, i);
+  AccumulateDotProducts<I + 1, pairs...>(pack, b, k, j, i, sums);
+}
+} // namespace impl
+
+// Computes the inner products of all pairs in a single sweep over the interior of the
+// blocks in md and adds them to dots->val[offset + n] for the n-th pair. Each field is
+// read once however many products it appears in.
+template <class... pairs>
+TaskStatus DotProductsLocal(const std::shared_ptr<MeshData<Real>> &md,
+                            AllReduce<std::vector<Real>> *dots, const int offset = 0) {
+  constexpr int npairs = sizeof...(pairs);
+  PARTHENON_REQUIRE(static_cast<int>(dots->val.size()) >= offset + npairs,
+                    "Not enough room for the dot products.");
+  using TE = parthenon::TopologicalElement;
+  TE te = TE::CC;
+  IndexRange ib = md->GetBoundsI(IndexDomain::interior, te);
+  IndexRange jb = md->GetBoundsJ(IndexDomain::interior, te);
+  IndexRange kb = md->GetBoundsK(IndexDomain::interior, te);
+
+  static auto desc = parthenon::MakePackDescriptor<typename pairs::a_t...,
+                                                   typename pairs::b_t...>(md.get());
+  auto pack = desc.GetPack(md.get());
+  impl::SumArray<npairs> gsums;
+  parthenon::par_reduce(
+      parthenon::loop_pattern_mdrange_tag, "DotProducts", DevExecSpace(), 0,
+      pack.GetNBlocks() - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+      KOKKOS_LAMBDA(const int b, const int k, const int j, const int i,
+                    impl::SumArray<npairs> &lsums) {
+        impl::AccumulateDotProducts<0, pairs...>(pack, b, k, j, i, lsums.v);
+      },
+      Kokkos::Sum<impl::SumArray<npairs>>(gsums));
+  for (int n = 0; n < npairs; ++n)
+    dots->val[offset + n] += gsums.v[n];
+  return TaskStatus::complete;
+}
+
+// Global inner products of all pairs with a single sweep over the data and a single
+// reduction over ranks, the result for the n-th pair is dots->val[n]
+template <class... pairs>
+TaskID DotProducts(TaskID dependency_in, TaskList &tl, AllReduce<std::vector<Real>> *dots,
+                   const std::shared_ptr<MeshData<Real>> &md) {
+  auto zero_dots = tl.AddTask(
+      TaskQualifier::once_per_region | TaskQualifier::local_sync, dependency_in,
+      [](AllReduce<std::vector<Real>> *r) {
+        r->val.assign(sizeof...(pairs), 0.0);
+        return TaskStatus::complete;
+      },
+      dots);
+  auto get_dots = tl.AddTask(TaskQualifier::local_sync, zero_dots,
+                             DotProductsLocal<pairs...>, md, dots, 0);
+  auto start_global_dots =
+      tl.AddTask(TaskQualifier::once_per_region, get_dots,
+                 &AllReduce<std::vector<Real>>::StartReduce, dots, MPI_SUM);
+  return tl.AddTask(TaskQualifier::once_per_region | TaskQualifier::local_sync,
+                    start_global_dots, &AllReduce<std::vector<Real>>::CheckReduce, dots);
+}
+
 template <class a_t>
 TaskStatus GlobalMinLocal(const std::shared_ptr<MeshData<Real>> &md,
                           AllReduce<Real> *amin) {
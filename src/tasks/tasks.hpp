@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <functional>
 #include <list>
@@ -37,6 +38,7 @@
 
 #include "globals.hpp"
 #include "thread_pool.hpp"
+#include "utils/communicator_pool.hpp"
 #include "utils/concepts_lite.hpp"
 #include "utils/error_checking.hpp"
 
@@ -144,8 +146,6 @@ class Task {
       // enforce maximum number of iterations
       if (num_calls == exec_limits.second) status = TaskStatus::complete;
     }
-    // save the status in the Task object
-    SetStatus(status);
     return status;
   }
   TaskID GetID() { return this; }
@@ -158,7 +158,28 @@ class Task {
     }
     return go;
   }
+  // Claim the right to enqueue this task through an edge that isn't tracked by the
+  // dependency counter (e.g. a task re-polling itself or a list restarting).  Only
+  // the first caller gets true until ReleaseQueue is called after the task has run.
+  bool TryQueue() { return !queued.exchange(true); }
+  void ReleaseQueue() { queued.store(false); }
+  // Record that one dependency has finished.  Returns true for exactly one caller per
+  // execution of the task, the one that satisfied its last outstanding dependency.
+  // The counter is refilled at that point (rather than when the task finishes) so
+  // that dependencies finishing early for the next iteration aren't lost.
+  bool DependencySatisfied() {
+    if (remaining_deps.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      remaining_deps.fetch_add(num_refire_deps, std::memory_order_acq_rel);
+      return true;
+    }
+    return false;
+  }
+  void ResetDependencyCount() { remaining_deps.store(num_deps); }
   void AddDependency(Task *t) { dependencies.insert(t); }
+  void AddRegionalDependency(Task *t) {
+    dependencies.insert(t);
+    regional_dependencies.insert(t);
+  }
   std::unordered_set<Task *> &GetDependencies() { return dependencies; }
   void AddDependent(Task *t, TaskStatus status) {
     dependent[static_cast<int>(status)].push_back(t);
@@ -166,16 +187,41 @@ class Task {
   std::vector<Task *> &GetDependent(TaskStatus status = TaskStatus::complete) {
     return dependent[static_cast<int>(status)];
   }
+  // Tasks to notify when this task returns status, each paired with whether the edge
+  // counts towards the dependent's dependency counter.  Built by FinalizeDependencies.
+  const std::vector<std::pair<Task *, bool>> &GetLaunchEdges(TaskStatus status) const {
+    return launch_edges[static_cast<int>(status)];
+  }
+  // Called once the graph is complete.  iteration_scope holds every task that is
+  // re-executed along with this one when its innermost iterating list repeats, or is
+  // nullptr if this task only executes once per region.  Dependencies outside that
+  // scope only finish once, so they are not expected again on later iterations.
+  void FinalizeDependencies(const std::unordered_set<Task *> *iteration_scope) {
+    num_deps = dependencies.size();
+    num_refire_deps = num_deps;
+    if (iteration_scope != nullptr) {
+      num_refire_deps = 0;
+      for (auto d : dependencies) {
+        num_refire_deps +=
+            (iteration_scope->count(d) > 0 || regional_dependencies.count(d) > 0);
+      }
+    }
+    for (int s = 0; s < launch_edges.size(); ++s) {
+      launch_edges[s].clear();
+      std::unordered_set<Task *> seen;
+      for (auto t : dependent[s]) {
+        if (!seen.insert(t).second) continue;
+        launch_edges[s].emplace_back(t, t->dependencies.count(this) > 0);
+      }
+    }
+    ResetDependencyCount();
+  }
   void SetType(TaskType type) { task_type = type; }
   TaskType GetType() { return task_type; }
   void SetStatus(TaskStatus status) {
-    std::lock_guard<std::mutex> lock(mutex);
-    task_status = status;
-  }
-  TaskStatus GetStatus() {
-    std::lock_guard<std::mutex> lock(mutex);
-    return task_status;
+    task_status.store(status, std::memory_order_release);
   }
+  TaskStatus GetStatus() { return task_status.load(std::memory_order_acquire); }
   void reset_iteration() { num_calls = 0; }
 
  private:
@@ -183,12 +229,18 @@ class Task {
   // store a list of tasks that might be available to
   // run for each possible status this task returns
   std::array<std::vector<Task *>, 3> dependent;
+  std::array<std::vector<std::pair<Task *, bool>>, 3> launch_edges;
   std::unordered_set<Task *> dependencies;
+  std::unordered_set<Task *> regional_dependencies;
   std::pair<int, int> exec_limits;
   TaskType task_type = TaskType::normal;
   int num_calls = 0;
-  TaskStatus task_status = TaskStatus::incomplete;
-  std::mutex mutex;
+  std::atomic<TaskStatus> task_status{TaskStatus::incomplete};
+  std::atomic<bool> queued{false};
+  // number of dependencies that have yet to finish before this task can run
+  std::atomic<int> remaining_deps{0};
+  int num_deps = 0;
+  int num_refire_deps = 0;
   int verbose_level_;
   std::string label_;
 };
@@ -268,10 +320,15 @@ class TaskList {
     // can depend on.  Also simplifies exiting completed iterations
     tasks.push_back(std::make_shared<Task>(
         TaskID(), "last_task",
-        [&completion_tasks = completion_tasks]() {
+        [&completion_tasks = completion_tasks, iteration_tasks = iteration_tasks]() {
           for (auto t : completion_tasks) {
             t->reset_iteration();
           }
+          // tasks following a completion task may have been partially satisfied on the
+          // final iteration, so start them fresh in case this list is executed again
+          for (auto t : *iteration_tasks) {
+            t->ResetDependencyCount();
+          }
           return TaskStatus::complete;
         },
         exec_limits));
@@ -334,16 +391,12 @@ class TaskList {
       // make status, request, and comm for this global task
       global_status.push_back(std::make_shared<int>(0));
       global_request.push_back(std::make_shared<MPI_Request>(MPI_REQUEST_NULL));
-      // be careful about the custom deleter so it doesn't call
-      // an MPI function after Finalize
-      global_comm.emplace_back(new MPI_Comm, [&](MPI_Comm *d) {
-        int finalized;
-        PARTHENON_MPI_CHECK(MPI_Finalized(&finalized));
-        if (!finalized) PARTHENON_MPI_CHECK(MPI_Comm_free(d));
-      });
       // we need another communicator to support multiple in flight non-blocking
-      // collectives where we can't guarantee calling order across ranks
-      PARTHENON_MPI_CHECK(MPI_Comm_dup(MPI_COMM_WORLD, global_comm.back().get()));
+      // collectives where we can't guarantee calling order across ranks. Only the list
+      // with unique_id = 0 calls MPI, and the communicator goes back to the pool when
+      // the list is destroyed.
+      global_comm.push_back(unique_id == 0 ? CommunicatorPool::Get().Acquire()
+                                           : nullptr);
       do_mpi = true;
 #endif // MPI_PARALLEL
       TaskID start;
@@ -458,6 +511,10 @@ class TaskList {
   std::vector<Task *> regional_tasks;
   std::vector<Task *> global_tasks;
   std::vector<Task *> completion_tasks;
+  // every task in this list and its sublists if this list iterates, shared so that
+  // copies of the list (and last_task) see the same object
+  std::shared_ptr<std::vector<Task *>> iteration_tasks =
+      std::make_shared<std::vector<Task *>>();
   // special startup and takedown tasks auto added to lists
   Task *first_task;
   Task *last_task;
@@ -498,6 +555,29 @@ class TaskList {
       tl->ConnectIteration();
   }
 
+  void AppendAllTasks(std::vector<Task *> &tasks_inout) {
+    for (auto &t : tasks)
+      tasks_inout.push_back(t.get());
+    for (auto &tl : sublists)
+      tl->AppendAllTasks(tasks_inout);
+  }
+
+  // Set up the dependency counters of every task.  scope is the set of tasks that
+  // repeat along with the innermost enclosing list that iterates, if any.
+  void FinalizeDependencies(const std::unordered_set<Task *> *scope) {
+    std::unordered_set<Task *> my_scope;
+    if (completion_tasks.size() != 0) {
+      iteration_tasks->clear();
+      AppendAllTasks(*iteration_tasks);
+      my_scope.insert(iteration_tasks->begin(), iteration_tasks->end());
+      scope = &my_scope;
+    }
+    for (auto &t : tasks)
+      t->FinalizeDependencies(scope);
+    for (auto &tl : sublists)
+      tl->FinalizeDependencies(scope);
+  }
+
   template <class F>
   std::string MakeUserTaskLabel(std::optional<std::string> label) {
     if (!label.has_value()) label = "anon";
@@ -550,10 +630,6 @@ class TaskRegion {
   }
 
   TaskListStatus Execute(ThreadPool &pool) {
-    // for now, require a pool with one thread
-    PARTHENON_REQUIRE_THROWS(pool.size() == 1,
-                             "ThreadPool size != 1 is not currently supported.")
-
     // first, if needed, finish building the graph
     if (!graph_built) BuildGraph();
 
@@ -561,19 +637,37 @@ class TaskRegion {
     std::function<TaskStatus(Task *)> ProcessTask;
     ProcessTask = [&pool, &ProcessTask](Task *task) -> TaskStatus {
       auto status = task->operator()();
-      auto next_up = task->GetDependent(status);
-      for (auto t : next_up) {
-        if (t->ready()) {
-          pool.enqueue([t, &ProcessTask]() { return ProcessTask(t); });
+      // save the status in the Task object
+      task->SetStatus(status);
+      task->ReleaseQueue();
+      if (status == TaskStatus::fail) return status;
+      for (auto &[t, counted] : task->GetLaunchEdges(status)) {
+        if (counted) {
+          // a single atomic decrement per edge, the last one launches the task
+          if (t->DependencySatisfied())
+            pool.enqueue([t = t, &ProcessTask]() { return ProcessTask(t); });
+        } else if (t->TryQueue()) {
+          // a task that is still incomplete is polling (typically on communication),
+          // so let other available work go ahead of it
+          if (t == task && status == TaskStatus::incomplete) {
+            pool.enqueue_deferred([t = t, &ProcessTask]() { return ProcessTask(t); });
+          } else {
+            pool.enqueue([t = t, &ProcessTask]() { return ProcessTask(t); });
+          }
         }
       }
       return status;
     };
 
+    // start every task with a full dependency count
+    for (auto t : all_tasks) {
+      t->ResetDependencyCount();
+    }
+
     // now enqueue the "first_task" for all task lists
     for (auto &tl : task_lists) {
       auto t = tl.GetStartupTask();
-      pool.enqueue([t, &ProcessTask]() { return ProcessTask(t); });
+      if (t->TryQueue()) pool.enqueue([t, &ProcessTask]() { return ProcessTask(t); });
     }
 
     // then wait until everything is done
@@ -597,6 +691,7 @@ class TaskRegion {
 
  private:
   std::vector<TaskList> task_lists;
+  std::vector<Task *> all_tasks;
   bool graph_built = false;
 
   void AppendTasks(std::vector<std::shared_ptr<Task>> &tasks_inout) {
@@ -625,7 +720,7 @@ class TaskRegion {
         for (auto t : reg_dep[j]) {
           for (int k = 0; k < num_lists; k++) {
             if (j == k) continue;
-            t->AddDependency(tasks[k]);
+            t->AddRegionalDependency(tasks[k]);
             tasks[k]->AddDependent(t, TaskStatus::complete);
           }
         }
@@ -655,6 +750,13 @@ class TaskRegion {
       tl.ConnectIteration();
     }
 
+    // with all edges in place, set up dependency counters
+    all_tasks.clear();
+    for (auto &tl : task_lists) {
+      tl.FinalizeDependencies(nullptr);
+      tl.AppendAllTasks(all_tasks);
+    }
+
     graph_built = true;
     for (auto &tl : task_lists) {
       tl.SetGraphBuilt();
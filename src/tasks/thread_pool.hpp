@@ -14,12 +14,14 @@
 #ifndef TASKS_THREAD_POOL_HPP_
 #define TASKS_THREAD_POOL_HPP_
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -28,67 +30,62 @@ namespace parthenon {
 
 class TaskList;
 
+// A double-ended queue owned by a single worker thread.  The owner pushes and pops
+// at the back (LIFO, which keeps a task's successors hot in cache), while other
+// workers steal from the front (FIFO, taking the oldest and typically largest piece
+// of outstanding work).  Work that should yield to everything else, e.g. tasks
+// polling on MPI, is kept in a separate deferred queue that is cycled through in FIFO
+// order.  It is only touched once no regular work is left anywhere, so idle workers
+// steal real work rather than polling tasks.
 template <typename T>
-class ThreadQueue {
+class WorkStealingQueue {
  public:
-  explicit ThreadQueue(const int num_workers) : nworkers(num_workers), nwaiting(0) {}
-  void push(T q) {
+  void push_back(T q) {
     std::lock_guard<std::mutex> lock(mutex);
-    queue.push(q);
-    cv.notify_one();
+    queue.push_back(std::move(q));
   }
-  bool pop(T &q) {
-    std::unique_lock<std::mutex> lock(mutex);
-    if (queue.empty()) {
-      nwaiting++;
-      if (waiting && nwaiting == nworkers) {
-        complete = true;
-        complete_cv.notify_all();
-      }
-      cv.wait(lock, [this]() { return exit || !queue.empty(); });
-      nwaiting--;
-      if (exit) return true;
-    }
-    q = queue.front();
-    queue.pop();
-    return false;
+  void push_deferred(T q) {
+    std::lock_guard<std::mutex> lock(mutex);
+    deferred.push_back(std::move(q));
   }
-  void signal_kill() {
+  bool pop_back(T &q) {
     std::lock_guard<std::mutex> lock(mutex);
-    std::queue<T>().swap(queue);
-    complete = true;
-    exit = true;
-    cv.notify_all();
+    if (queue.empty()) return false;
+    q = std::move(queue.back());
+    queue.pop_back();
+    return true;
   }
-  void signal_exit_when_finished() {
+  bool pop_deferred(T &q) {
     std::lock_guard<std::mutex> lock(mutex);
-    exit = true;
-    complete = true;
-    cv.notify_all();
+    return pop_front(deferred, q);
   }
-  void wait_for_complete() {
-    std::unique_lock<std::mutex> lock(mutex);
-    waiting = true;
-    if (queue.empty() && nwaiting == nworkers) {
-      complete = false;
-      waiting = false;
-      return;
-    }
-    complete_cv.wait(lock, [this]() { return complete; });
-    complete = false;
-    waiting = false;
+  bool steal(T &q) {
+    std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+    return lock.owns_lock() && pop_front(queue, q);
+  }
+  bool steal_deferred(T &q) {
+    std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+    return lock.owns_lock() && pop_front(deferred, q);
+  }
+  size_t clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    const size_t n = queue.size() + deferred.size();
+    std::deque<T>().swap(queue);
+    std::deque<T>().swap(deferred);
+    return n;
   }
 
  private:
-  const int nworkers;
-  int nwaiting;
-  std::queue<T> queue;
+  std::deque<T> queue;
+  std::deque<T> deferred;
   std::mutex mutex;
-  std::condition_variable cv;
-  std::condition_variable complete_cv;
-  bool complete = false;
-  bool exit = false;
-  bool waiting = false;
+
+  static bool pop_front(std::deque<T> &d, T &q) {
+    if (d.empty()) return false;
+    q = std::move(d.front());
+    d.pop_front();
+    return true;
+  }
 };
 
 template <typename T>
@@ -125,38 +122,61 @@ class ThreadVector {
 class ThreadPool {
  public:
   explicit ThreadPool(const int numthreads = std::thread::hardware_concurrency())
-      : nthreads(numthreads), queue(nthreads) {
+      : nthreads(std::max(numthreads, 1)), queues(nthreads) {
     for (int i = 0; i < nthreads; i++) {
-      auto worker = [&]() {
-        while (true) {
-          std::function<void()> f;
-          auto stop = queue.pop(f);
-          if (stop) break;
-          if (f) f();
-        }
-      };
-      threads.emplace_back(worker);
+      queues[i] = std::make_unique<WorkStealingQueue<std::function<void()>>>();
+    }
+    for (int i = 0; i < nthreads; i++) {
+      threads.emplace_back([this, i]() { worker_loop(i); });
     }
   }
   ~ThreadPool() {
-    queue.signal_exit_when_finished();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      exit = true;
+    }
+    cv.notify_all();
     for (auto &t : threads) {
       t.join();
     }
   }
 
-  void wait() { queue.wait_for_complete(); }
+  // Block the calling thread until every enqueued task, including tasks enqueued by
+  // other tasks, has finished executing
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    complete_cv.wait(lock, [this]() { return npending.load() == 0; });
+  }
 
-  void kill() { queue.signal_kill(); }
+  // Drop all work that has not yet started and shut the workers down
+  void kill() {
+    for (auto &q : queues) {
+      const int n = static_cast<int>(q->clear());
+      nqueued -= n;
+      finish(n);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      exit = true;
+    }
+    cv.notify_all();
+  }
 
+  // Enqueue work.  When called from one of this pool's workers, the work is pushed
+  // onto that worker's own queue so dependent tasks stay on the thread that produced
+  // them unless another worker runs out of work and steals them.
   template <typename F, class... Args>
   void enqueue(F &&f, Args &&...args) {
-    using return_t = typename std::invoke_result_t<F, Args...>;
-    auto task = std::make_shared<std::packaged_task<return_t()>>(
-        [=, func = std::forward<F>(f)] { return func(std::forward<Args>(args)...); });
-    // If we're listing Prathenon "Tasks" (all current uses) keep the returns
-    if constexpr (std::is_same<return_t, TaskStatus>::value) run_tasks.push(task);
-    queue.push([task]() { (*task)(); });
+    push(wrap(std::forward<F>(f), std::forward<Args>(args)...), false);
+  }
+
+  // Same as enqueue, but the work is placed in the deferred queue of the calling
+  // worker, so it only runs once no worker finds anything else to do.  This is
+  // intended for tasks that are repeatedly re-enqueued while polling, e.g. waiting on
+  // MPI messages, so they don't starve compute tasks.
+  template <typename F, class... Args>
+  void enqueue_deferred(F &&f, Args &&...args) {
+    push(wrap(std::forward<F>(f), std::forward<Args>(args)...), true);
   }
 
   int size() const { return nthreads; }
@@ -165,7 +185,7 @@ class ThreadPool {
   // but we can check returns too.
   // Would need changes for >1 failure mode
   TaskStatus check_task_returns() {
-    queue.wait_for_complete();
+    wait();
     TaskStatus overall = TaskStatus::complete;
     for (auto &task : run_tasks) {
       TaskStatus task_return = task->get_future().get();
@@ -179,8 +199,89 @@ class ThreadPool {
  private:
   const int nthreads;
   std::vector<std::thread> threads;
-  ThreadQueue<std::function<void()>> queue;
+  std::vector<std::unique_ptr<WorkStealingQueue<std::function<void()>>>> queues;
   ThreadVector<std::shared_ptr<std::packaged_task<TaskStatus()>>> run_tasks;
+  // number of tasks sitting in queues and number of tasks enqueued but not finished
+  std::atomic<int> nqueued{0};
+  std::atomic<int> npending{0};
+  std::atomic<int> next_queue{0};
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::condition_variable complete_cv;
+  bool exit = false;
+
+  // identifies the pool and queue owned by the calling thread, if any
+  static inline thread_local ThreadPool *current_pool = nullptr;
+  static inline thread_local int current_queue = -1;
+
+  template <typename F, class... Args>
+  std::function<void()> wrap(F &&f, Args &&...args) {
+    using return_t = typename std::invoke_result_t<F, Args...>;
+    auto task = std::make_shared<std::packaged_task<return_t()>>(
+        [=, func = std::forward<F>(f)] { return func(std::forward<Args>(args)...); });
+    // If we're listing Prathenon "Tasks" (all current uses) keep the returns
+    if constexpr (std::is_same<return_t, TaskStatus>::value) run_tasks.push(task);
+    return [task]() { (*task)(); };
+  }
+
+  void push(std::function<void()> &&f, const bool low_priority) {
+    const int q = (current_pool == this)
+                      ? current_queue
+                      : (next_queue.fetch_add(1, std::memory_order_relaxed) % nthreads);
+    npending++;
+    if (low_priority) {
+      queues[q]->push_deferred(std::move(f));
+    } else {
+      queues[q]->push_back(std::move(f));
+    }
+    {
+      // increment under the lock so a worker can't miss the wakeup between checking
+      // for work and going to sleep
+      std::lock_guard<std::mutex> lock(mutex);
+      nqueued++;
+    }
+    cv.notify_one();
+  }
+
+  // Own work first, then other workers' work, and only then deferred polling tasks,
+  // again preferring the worker's own ones
+  bool try_pop(const int id, std::function<void()> &f) {
+    if (queues[id]->pop_back(f)) return true;
+    for (int i = 1; i < nthreads; i++) {
+      if (queues[(id + i) % nthreads]->steal(f)) return true;
+    }
+    if (queues[id]->pop_deferred(f)) return true;
+    for (int i = 1; i < nthreads; i++) {
+      if (queues[(id + i) % nthreads]->steal_deferred(f)) return true;
+    }
+    return false;
+  }
+
+  void finish(const int n) {
+    if (n > 0 && npending.fetch_sub(n) == n) {
+      std::lock_guard<std::mutex> lock(mutex);
+      complete_cv.notify_all();
+    }
+  }
+
+  void worker_loop(const int id) {
+    current_pool = this;
+    current_queue = id;
+    while (true) {
+      std::function<void()> f;
+      if (try_pop(id, f)) {
+        nqueued--;
+        if (f) f();
+        finish(1);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [this]() { return exit || nqueued.load() > 0; });
+      if (exit && nqueued.load() == 0) break;
+    }
+    current_pool = nullptr;
+    current_queue = -1;
+  }
 };
 
 } // namespace parthenon
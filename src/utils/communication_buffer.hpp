@@ -61,6 +61,43 @@ class CommBuffer {
   using buf_base_t = std::remove_pointer_t<decltype(std::declval<T>().data())>;
   buf_base_t null_buf_ = std::numeric_limits<buf_base_t>::signaling_NaN();
   bool active_ = false;
+  // Data is sent/received as part of an aggregated message (see
+  // bvals/comms/message_aggregation.hpp) rather than by this buffer itself
+  bool aggregated_ = false;
+  // Messages are posted with MPI_Start on persistent requests rather than with
+  // a fresh MPI_Isend/MPI_Irecv
+  bool persistent_ = false;
+
+#ifdef MPI_PARALLEL
+  // Persistent requests for the buffer storage and for null messages. The request for
+  // the storage is rebuilt if the storage changes, which only happens for sparse
+  // variables.
+  struct PersistentRequests {
+    MPI_Request data = MPI_REQUEST_NULL;
+    MPI_Request null = MPI_REQUEST_NULL;
+    // Always MPI_REQUEST_NULL, stands in for active when nothing is in flight
+    MPI_Request inactive = MPI_REQUEST_NULL;
+    MPI_Request *active = nullptr;
+    void *data_ptr = nullptr;
+    int data_count = 0;
+    buf_base_t null_buf = std::numeric_limits<buf_base_t>::signaling_NaN();
+  };
+  std::shared_ptr<PersistentRequests> persistent_requests_;
+
+  MPI_Request *CurrentRequest() {
+    if (!persistent_) return my_request_.get();
+    auto &preqs = *persistent_requests_;
+    return preqs.active == nullptr ? &preqs.inactive : preqs.active;
+  }
+  bool HasPendingRequest() {
+    if (persistent_) return persistent_requests_->active != nullptr;
+    return *my_request_ != MPI_REQUEST_NULL;
+  }
+  void StartRequest(bool send, buf_base_t *data, int count);
+  MPI_Request *GetPersistentRequest(bool send, buf_base_t *data, int count);
+  bool TestRequest(MPI_Status *status);
+  void WaitRequest();
+#endif
 
   std::function<T()> get_resource_;
 
@@ -77,7 +114,8 @@ class CommBuffer {
   }
 
   CommBuffer(int tag, int send_rank, int recv_rank, mpi_comm_t comm_,
-             std::function<T()> get_resource, bool do_sparse_allocation = false);
+             std::function<T()> get_resource, bool do_sparse_allocation = false,
+             bool aggregated = false, bool persistent = false);
 
   ~CommBuffer();
 
@@ -109,6 +147,13 @@ class CommBuffer {
 
   BufferState GetState() { return *state_; }
 
+  bool IsAggregated() const { return aggregated_; }
+  bool IsPersistent() const { return persistent_; }
+
+  // Build the persistent requests up front, this also allocates the storage of
+  // buffers that are not sparse since it will never be freed
+  void PreparePersistentRequests();
+
   void Send() noexcept;
   void SendNull() noexcept;
 
@@ -125,13 +170,19 @@ class CommBuffer {
     }
   }
   void Stale();
+
+  // Used by the receiving end of aggregated messages to make storage available
+  // for the incoming data and to mark the buffer as received once it is unpacked
+  void PrepareAggregatedReceive(bool null);
+  void FinishAggregatedReceive(bool null);
 };
 
 // Method definitions below
 
 template <class T>
 CommBuffer<T>::CommBuffer(int tag, int send_rank, int recv_rank, mpi_comm_t comm,
-                          std::function<T()> get_resource, bool do_sparse_allocation)
+                          std::function<T()> get_resource, bool do_sparse_allocation,
+                          bool aggregated, bool persistent)
     : state_(std::make_shared<BufferState>(BufferState::stale)),
       comm_type_(std::make_shared<BuffCommType>(BuffCommType::both)),
       started_irecv_(std::make_shared<bool>(false)),
@@ -140,8 +191,14 @@ CommBuffer<T>::CommBuffer(int tag, int send_rank, int recv_rank, mpi_comm_t comm
       my_request_(std::make_shared<MPI_Request>(MPI_REQUEST_NULL)),
 #endif
       tag_(tag), send_rank_(send_rank), recv_rank_(recv_rank), comm_(comm),
-      get_resource_(get_resource), buf_() {
+      aggregated_(aggregated), get_resource_(get_resource), buf_() {
   my_rank = Globals::my_rank;
+#ifdef MPI_PARALLEL
+  // Aggregated buffers never post their own messages and buffers
+  // local to this rank do not use MPI at all
+  persistent_ = persistent && !aggregated && (send_rank != recv_rank);
+  if (persistent_) persistent_requests_ = std::make_shared<PersistentRequests>();
+#endif
   if (send_rank == recv_rank) {
     assert(my_rank == send_rank);
     *comm_type_ = BuffCommType::both;
@@ -162,8 +219,12 @@ CommBuffer<T>::CommBuffer(const CommBuffer<U> &in)
     : buf_(in.buf_), state_(in.state_), comm_type_(in.comm_type_),
       started_irecv_(in.started_irecv_), nrecv_tries_(in.nrecv_tries_),
       my_request_(in.my_request_), tag_(in.tag_), send_rank_(in.send_rank_),
-      recv_rank_(in.recv_rank_), comm_(in.comm_), active_(in.active_) {
+      recv_rank_(in.recv_rank_), comm_(in.comm_), active_(in.active_),
+      aggregated_(in.aggregated_), persistent_(in.persistent_) {
   my_rank = Globals::my_rank;
+#ifdef MPI_PARALLEL
+  persistent_requests_ = in.persistent_requests_;
+#endif
 }
 
 template <class T>
@@ -174,13 +235,19 @@ CommBuffer<T>::~CommBuffer() {
     // with this buffer before destroying it
     int flag;
     MPI_Status status;
-    PARTHENON_MPI_CHECK(MPI_Test(my_request_.get(), &flag, &status));
+    PARTHENON_MPI_CHECK(MPI_Test(CurrentRequest(), &flag, &status));
     if (!flag) {
       if (*comm_type_ == BuffCommType::sender) {
-        PARTHENON_MPI_CHECK(MPI_Wait(my_request_.get(), MPI_STATUS_IGNORE));
+        PARTHENON_MPI_CHECK(MPI_Wait(CurrentRequest(), MPI_STATUS_IGNORE));
       } else {
-        PARTHENON_MPI_CHECK(MPI_Cancel(my_request_.get()));
-        PARTHENON_MPI_CHECK(MPI_Wait(my_request_.get(), MPI_STATUS_IGNORE));
+        PARTHENON_MPI_CHECK(MPI_Cancel(CurrentRequest()));
+        PARTHENON_MPI_CHECK(MPI_Wait(CurrentRequest(), MPI_STATUS_IGNORE));
+      }
+    }
+    if (persistent_) {
+      auto &preqs = *persistent_requests_;
+      for (MPI_Request *req : {&preqs.data, &preqs.null}) {
+        if (*req != MPI_REQUEST_NULL) PARTHENON_MPI_CHECK(MPI_Request_free(req));
       }
     }
   }
@@ -201,6 +268,11 @@ CommBuffer<T> &CommBuffer<T>::operator=(const CommBuffer<U> &in) {
   recv_rank_ = in.recv_rank_;
   comm_ = in.comm_;
   active_ = in.active_;
+  aggregated_ = in.aggregated_;
+  persistent_ = in.persistent_;
+#ifdef MPI_PARALLEL
+  persistent_requests_ = in.persistent_requests_;
+#endif
   my_rank = Globals::my_rank;
   return *this;
 }
@@ -215,17 +287,15 @@ void CommBuffer<T>::Send() noexcept {
   PARTHENON_DEBUG_REQUIRE(*state_ == BufferState::stale,
                           "Trying to send from buffer that hasn't been staled.");
   *state_ = BufferState::sending;
-  if (*comm_type_ == BuffCommType::sender) {
+  if (*comm_type_ == BuffCommType::sender && !aggregated_) {
 // Make sure that this request isn't still out,
 // this could be blocking
 #ifdef MPI_PARALLEL
     PARTHENON_REQUIRE(
         buf_.size() > 0,
         "Trying to send zero size buffer, which will be interpreted as sending_null.");
-    PARTHENON_MPI_CHECK(MPI_Wait(my_request_.get(), MPI_STATUS_IGNORE));
-    PARTHENON_MPI_CHECK(MPI_Isend(buf_.data(), buf_.size(),
-                                  MPITypeMap<buf_base_t>::type(), recv_rank_, tag_, comm_,
-                                  my_request_.get()));
+    WaitRequest();
+    StartRequest(true, buf_.data(), buf_.size());
 #endif
   }
   if (*comm_type_ == BuffCommType::receiver) {
@@ -239,13 +309,12 @@ void CommBuffer<T>::SendNull() noexcept {
   PARTHENON_DEBUG_REQUIRE(*state_ == BufferState::stale,
                           "Trying to send_null from buffer that hasn't been staled.");
   *state_ = BufferState::sending_null;
-  if (*comm_type_ == BuffCommType::sender) {
+  if (*comm_type_ == BuffCommType::sender && !aggregated_) {
 // Make sure that this request isn't still out,
 // this could be blocking
 #ifdef MPI_PARALLEL
-    PARTHENON_MPI_CHECK(MPI_Wait(my_request_.get(), MPI_STATUS_IGNORE));
-    PARTHENON_MPI_CHECK(MPI_Isend(&null_buf_, 0, MPITypeMap<buf_base_t>::type(),
-                                  recv_rank_, tag_, comm_, my_request_.get()));
+    WaitRequest();
+    StartRequest(true, &null_buf_, 0);
 #endif
   }
   if (*comm_type_ == BuffCommType::receiver) {
@@ -262,11 +331,17 @@ bool CommBuffer<T>::IsAvailableForWrite() {
     // setting the buffer to stale, all we care about for a pure sender is wether
     // or not its last send message has been completed
     if (*state_ == BufferState::stale) return true;
-    if (*my_request_ == MPI_REQUEST_NULL) return true;
-    int flag, test;
+    if (aggregated_) {
+      // The data has already been copied into the aggregated message, which
+      // tracks the completion of its own send
+      *state_ = BufferState::stale;
+      return true;
+    }
+    if (!HasPendingRequest()) return true;
+    int test;
     PARTHENON_MPI_CHECK(MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &test,
                                    MPI_STATUS_IGNORE));
-    PARTHENON_MPI_CHECK(MPI_Test(my_request_.get(), &flag, MPI_STATUS_IGNORE));
+    const bool flag = TestRequest(MPI_STATUS_IGNORE);
     if (flag) *state_ = BufferState::stale;
     return flag;
 #else
@@ -282,15 +357,15 @@ bool CommBuffer<T>::IsAvailableForWrite() {
 template <class T>
 void CommBuffer<T>::TryStartReceive() noexcept {
 #ifdef MPI_PARALLEL
+  // Receives for aggregated buffers are posted by the mailbox on the mesh
+  if (aggregated_) return;
   if (*comm_type_ == BuffCommType::receiver && !*started_irecv_) {
     PARTHENON_REQUIRE(
-        *my_request_ == MPI_REQUEST_NULL,
+        !HasPendingRequest(),
         "Cannot have another pending request in a buffer that is starting to receive.");
     if (!IsActive())
       Allocate(); // For early start of Irecv, always need storage space even if not used
-    PARTHENON_MPI_CHECK(MPI_Irecv(buf_.data(), buf_.size(),
-                                  MPITypeMap<buf_base_t>::type(), send_rank_, tag_, comm_,
-                                  my_request_.get()));
+    StartRequest(false, buf_.data(), buf_.size());
     *started_irecv_ = true;
   } else if (*comm_type_ == BuffCommType::sparse_receiver && !*started_irecv_) {
     int test;
@@ -304,13 +379,10 @@ void CommBuffer<T>::TryStartReceive() noexcept {
       PARTHENON_MPI_CHECK(MPI_Get_count(&status, MPITypeMap<buf_base_t>::type(), &size));
       if (size > 0) {
         if (!active_) Allocate();
-        PARTHENON_MPI_CHECK(MPI_Irecv(buf_.data(), buf_.size(),
-                                      MPITypeMap<buf_base_t>::type(), send_rank_, tag_,
-                                      comm_, my_request_.get()));
+        StartRequest(false, buf_.data(), buf_.size());
       } else {
         if (active_) Free();
-        PARTHENON_MPI_CHECK(MPI_Irecv(&null_buf_, 0, MPITypeMap<buf_base_t>::type(),
-                                      send_rank_, tag_, comm_, my_request_.get()));
+        StartRequest(false, &null_buf_, 0);
       }
       *started_irecv_ = true;
     }
@@ -323,6 +395,9 @@ bool CommBuffer<T>::TryReceive() noexcept {
   if (*state_ == BufferState::received || *state_ == BufferState::received_null)
     return true;
 
+  // Aggregated buffers are set to received when the mailbox unpacks their data
+  if (aggregated_) return false;
+
   if (*comm_type_ == BuffCommType::receiver ||
       *comm_type_ == BuffCommType::sparse_receiver) {
 #ifdef MPI_PARALLEL
@@ -362,7 +437,7 @@ bool CommBuffer<T>::TryReceive() noexcept {
       for (int i = 0; i < 1; ++i)
         PARTHENON_MPI_CHECK(MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag,
                                        MPI_STATUS_IGNORE));
-      PARTHENON_MPI_CHECK(MPI_Test(my_request_.get(), &flag, &status));
+      flag = TestRequest(&status);
       if (flag) {
         // Check the size of the message, it will be zero if the sender wants you to use
         // default buffer data
@@ -370,7 +445,7 @@ bool CommBuffer<T>::TryReceive() noexcept {
         PARTHENON_MPI_CHECK(
             MPI_Get_count(&status, MPITypeMap<buf_base_t>::type(), &size));
 
-        PARTHENON_REQUIRE(*my_request_ == MPI_REQUEST_NULL,
+        PARTHENON_REQUIRE(!HasPendingRequest(),
                           "MPI request should be finished to get here.");
         // Set flags based on a finished receive
         *started_irecv_ = false;
@@ -412,11 +487,106 @@ void CommBuffer<T>::Stale() {
   if (!(*state_ == BufferState::received || *state_ == BufferState::received_null))
     PARTHENON_DEBUG_WARN("Staling buffer not in the received state.");
 #ifdef MPI_PARALLEL
-  if (MPI_REQUEST_NULL != *my_request_)
-    PARTHENON_WARN("Staling buffer with pending request.");
+  if (HasPendingRequest()) PARTHENON_WARN("Staling buffer with pending request.");
 #endif
   *state_ = BufferState::stale;
 }
 
+#ifdef MPI_PARALLEL
+template <class T>
+void CommBuffer<T>::StartRequest(bool send, buf_base_t *data, int count) {
+  const int partner = send ? recv_rank_ : send_rank_;
+  if (!persistent_) {
+    if (send) {
+      PARTHENON_MPI_CHECK(MPI_Isend(data, count, MPITypeMap<buf_base_t>::type(), partner,
+                                    tag_, comm_, my_request_.get()));
+    } else {
+      PARTHENON_MPI_CHECK(MPI_Irecv(data, count, MPITypeMap<buf_base_t>::type(), partner,
+                                    tag_, comm_, my_request_.get()));
+    }
+    return;
+  }
+
+  PARTHENON_REQUIRE(persistent_requests_->active == nullptr,
+                    "Cannot start a persistent request while another one is active.");
+  MPI_Request *req = GetPersistentRequest(send, data, count);
+  PARTHENON_MPI_CHECK(MPI_Start(req));
+  persistent_requests_->active = req;
+}
+
+template <class T>
+MPI_Request *CommBuffer<T>::GetPersistentRequest(bool send, buf_base_t *data, int count) {
+  auto &preqs = *persistent_requests_;
+  const int partner = send ? recv_rank_ : send_rank_;
+  MPI_Request *req = &preqs.null;
+  if (count == 0) {
+    data = &preqs.null_buf;
+  } else {
+    req = &preqs.data;
+    // The storage of the buffer has changed since the request was built
+    if (*req != MPI_REQUEST_NULL && (preqs.data_ptr != data || preqs.data_count != count))
+      PARTHENON_MPI_CHECK(MPI_Request_free(req));
+  }
+  if (*req == MPI_REQUEST_NULL) {
+    if (send) {
+      PARTHENON_MPI_CHECK(MPI_Send_init(data, count, MPITypeMap<buf_base_t>::type(),
+                                        partner, tag_, comm_, req));
+    } else {
+      PARTHENON_MPI_CHECK(MPI_Recv_init(data, count, MPITypeMap<buf_base_t>::type(),
+                                        partner, tag_, comm_, req));
+    }
+    if (count > 0) {
+      preqs.data_ptr = data;
+      preqs.data_count = count;
+    }
+  }
+  return req;
+}
+
+template <class T>
+bool CommBuffer<T>::TestRequest(MPI_Status *status) {
+  int flag;
+  PARTHENON_MPI_CHECK(MPI_Test(CurrentRequest(), &flag, status));
+  // Completed persistent requests become inactive rather than MPI_REQUEST_NULL
+  if (flag && persistent_) persistent_requests_->active = nullptr;
+  return flag;
+}
+
+template <class T>
+void CommBuffer<T>::WaitRequest() {
+  PARTHENON_MPI_CHECK(MPI_Wait(CurrentRequest(), MPI_STATUS_IGNORE));
+  if (persistent_) persistent_requests_->active = nullptr;
+}
+#endif
+
+template <class T>
+void CommBuffer<T>::PreparePersistentRequests() {
+#ifdef MPI_PARALLEL
+  if (!persistent_) return;
+  const bool send = (*comm_type_ == BuffCommType::sender);
+  GetPersistentRequest(send, nullptr, 0);
+  // Sparse receivers only allocate storage once they know there is data coming
+  if (*comm_type_ == BuffCommType::sparse_receiver) return;
+  Allocate();
+  if (buf_.size() > 0) GetPersistentRequest(send, buf_.data(), buf_.size());
+#endif
+}
+
+template <class T>
+void CommBuffer<T>::PrepareAggregatedReceive(bool null) {
+  PARTHENON_REQUIRE(aggregated_ && *state_ == BufferState::stale,
+                    "Can only receive aggregated data into a stale aggregated buffer.");
+  if (!null) {
+    if (!active_) Allocate();
+  } else if (*comm_type_ == BuffCommType::sparse_receiver && active_) {
+    Free();
+  }
+}
+
+template <class T>
+void CommBuffer<T>::FinishAggregatedReceive(bool null) {
+  *state_ = null ? BufferState::received_null : BufferState::received;
+}
+
 } // namespace parthenon
 #endif // UTILS_COMMUNICATION_BUFFER_HPP_
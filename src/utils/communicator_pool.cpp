@@ -0,0 +1,91 @@
+//========================================================================================
+// Parthenon performance portable AMR framework
+// Copyright(C) 2024 The Parthenon collaboration
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include "utils/communicator_pool.hpp"
+
+#ifdef MPI_PARALLEL
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+#include "utils/error_checking.hpp"
+
+namespace parthenon {
+
+CommunicatorPool &CommunicatorPool::Get() {
+  static CommunicatorPool *pool = new CommunicatorPool();
+  return *pool;
+}
+
+std::shared_ptr<MPI_Comm> CommunicatorPool::Acquire() {
+  MPI_Comm comm;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (available_.empty()) {
+      PARTHENON_MPI_CHECK(MPI_Comm_dup(MPI_COMM_WORLD, &comm));
+      stats_.num_created++;
+    } else {
+      comm = available_.back();
+      available_.pop_back();
+      stats_.num_reused++;
+    }
+    stats_.num_live++;
+    stats_.max_live = std::max(stats_.max_live, stats_.num_live);
+  }
+  return std::shared_ptr<MPI_Comm>(new MPI_Comm(comm),
+                                   [this](MPI_Comm *comm) { Release(comm); });
+}
+
+void CommunicatorPool::Release(MPI_Comm *comm) {
+  std::unique_ptr<MPI_Comm> owned(comm);
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.num_live--;
+  // Communicators released after MPI_Finalize have been freed by MPI already
+  int finalized;
+  PARTHENON_MPI_CHECK(MPI_Finalized(&finalized));
+  if (!finalized) available_.push_back(*comm);
+}
+
+void CommunicatorPool::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &comm : available_)
+    PARTHENON_MPI_CHECK(MPI_Comm_free(&comm));
+  available_.clear();
+}
+
+std::size_t CommunicatorPool::NumAvailable() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return available_.size();
+}
+
+CommunicatorPool::Statistics CommunicatorPool::GetStatistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void CommunicatorPool::PrintStatistics() const {
+  auto stats = GetStatistics();
+  std::cout << stats.num_created << " communicators created, " << stats.num_reused
+            << " reused, " << stats.num_live << " live (at most " << stats.max_live
+            << " at once), " << NumAvailable() << " available for reuse." << std::endl;
+}
+
+} // namespace parthenon
+
+#endif // MPI_PARALLEL
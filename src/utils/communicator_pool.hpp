@@ -0,0 +1,82 @@
+//========================================================================================
+// Parthenon performance portable AMR framework
+// Copyright(C) 2024 The Parthenon collaboration
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#ifndef UTILS_COMMUNICATOR_POOL_HPP_
+#define UTILS_COMMUNICATOR_POOL_HPP_
+
+#include "parthenon_mpi.hpp"
+
+#ifdef MPI_PARALLEL
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace parthenon {
+
+// Pool of duplicates of MPI_COMM_WORLD for non-blocking collectives. Collectives that
+// can be in flight at the same time need separate communicators, since the order in
+// which they are started may differ between ranks, so every reduction object and every
+// global sync of a task list owns one. Duplicating a communicator is itself a collective
+// that is slow at scale, and MPI libraries limit how many may exist, so communicators
+// that are released by their owners are handed out again instead of being freed.
+//
+// A communicator is only matched across ranks by the order in which it is handed out.
+// This holds as long as all ranks acquire and release communicators in the same order,
+// which is the case when they construct and destroy the same objects in the same order
+// (as creating new communicators already required).
+class CommunicatorPool {
+ public:
+  struct Statistics {
+    std::uint64_t num_created = 0; // communicators duplicated from MPI_COMM_WORLD
+    std::uint64_t num_reused = 0;  // requests served by a released communicator
+    std::uint64_t num_live = 0;    // communicators currently handed out
+    std::uint64_t max_live = 0;    // largest number handed out at the same time
+  };
+
+  // The pool is never destroyed, so communicators can be released by objects that
+  // outlive other static objects
+  static CommunicatorPool &Get();
+
+  // Returns a communicator that goes back to the pool once the last copy of the
+  // pointer is destroyed
+  std::shared_ptr<MPI_Comm> Acquire();
+
+  // Frees all communicators available for reuse, must be called before MPI_Finalize
+  void Clear();
+
+  // Number of communicators held for reuse, those handed out are not included
+  std::size_t NumAvailable() const;
+
+  Statistics GetStatistics() const;
+  void PrintStatistics() const;
+
+ private:
+  CommunicatorPool() = default;
+  void Release(MPI_Comm *comm);
+
+  mutable std::mutex mutex_;
+  std::vector<MPI_Comm> available_;
+  Statistics stats_;
+};
+
+} // namespace parthenon
+
+#endif // MPI_PARALLEL
+
+#endif // UTILS_COMMUNICATOR_POOL_HPP_
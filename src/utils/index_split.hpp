@@ -32,6 +32,10 @@ class IndexSplit {
   IndexSplit(MeshData<Real> *md, const IndexRange &kb, const IndexRange &jb,
              const IndexRange &ib, const int nkp, const int njp);
   IndexSplit(MeshData<Real> *md, IndexDomain domain, const int nkp, const int njp);
+  // Splits a box of cells, e.g. IndexShape::GetCoreBox or one of the slabs of
+  // IndexShape::GetShellBoxes. The box must not be empty.
+  IndexSplit(MeshData<Real> *md, const IndexBox &box, const int nkp, const int njp)
+      : IndexSplit(md, box.k, box.j, box.i, nkp, njp) {}
 
   int outer_size() const { return nkp_ * njp_; }
   KOKKOS_INLINE_FUNCTION
@@ -21,6 +21,7 @@
 #include <kokkos_abstraction.hpp>
 #include <parthenon_mpi.hpp>
 #include <utils/cleantypes.hpp>
+#include <utils/communicator_pool.hpp>
 #include <utils/concepts_lite.hpp>
 #include <utils/error_checking.hpp>
 #include <utils/mpi_types.hpp>
@@ -66,10 +67,9 @@ struct ReductionBase {
   ReductionBase() {
 #ifdef MPI_PARALLEL
     // Store the communicator in a shared_ptr, so that
-    // MPI_Comm_free is called, but only when the last
+    // it is returned to the pool, but only when the last
     // copy of this ReductionBase is destroyed.
-    pcomm = std::shared_ptr<MPI_Comm>(new MPI_Comm, MPI_Comm_disconnect);
-    PARTHENON_MPI_CHECK(MPI_Comm_dup(MPI_COMM_WORLD, pcomm.get()));
+    pcomm = CommunicatorPool::Get().Acquire();
 #endif
   }
 
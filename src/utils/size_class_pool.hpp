@@ -0,0 +1,142 @@
+//========================================================================================
+// Parthenon performance portable AMR framework
+// Copyright(C) 2024 The Parthenon collaboration
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#ifndef UTILS_SIZE_CLASS_POOL_HPP_
+#define UTILS_SIZE_CLASS_POOL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+#include "kokkos_abstraction.hpp"
+#include "utils/error_checking.hpp"
+
+namespace parthenon {
+
+// Pool of one dimensional device arrays that recycles storage between users asking for
+// arrays of similar size. Requests are rounded up to the next size class, of which there
+// are four per power of two so that at most a quarter of an array goes unused, and are
+// served from arrays that have been released before new memory is allocated. Unlike
+// ObjectPool, arrays are handed out as ordinary reference counted views and only return
+// to the pool if they are explicitly released by their last owner. Get and Release may
+// be called concurrently from task bodies running on different threads.
+template <class T>
+class SizeClassPool {
+ public:
+  using array_t = ParArray1D<T>;
+
+  struct Statistics {
+    std::uint64_t num_allocated = 0;   // requests served by allocating new memory
+    std::uint64_t num_reused = 0;      // requests served by a released array
+    std::uint64_t num_released = 0;    // arrays returned to the pool
+    std::uint64_t bytes_allocated = 0; // memory allocated by the pool over its lifetime
+  };
+
+  // Smallest size class that holds n elements, i.e. the smallest m * 2^e >= n with
+  // m in [4, 8)
+  static std::size_t SizeClass(std::size_t n) {
+    if (n <= 4) return n;
+    std::size_t m = n - 1;
+    int e = 0;
+    while (m >= 8) {
+      m >>= 1;
+      ++e;
+    }
+    return (m + 1) << e;
+  }
+
+  // Returns a zero initialized array of at least size elements
+  array_t Get(const std::string &label, std::size_t size) {
+    const std::size_t size_class = SizeClass(std::max<std::size_t>(size, 1));
+    array_t out;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto &available = available_[size_class];
+      if (available.empty()) {
+        stats_.num_allocated++;
+        stats_.bytes_allocated += size_class * sizeof(T);
+      } else {
+        out = std::move(available.back());
+        available.pop_back();
+        bytes_available_ -= size_class * sizeof(T);
+        stats_.num_reused++;
+      }
+    }
+    // Allocating and zeroing happen outside the lock
+    if (!out.KokkosView().is_allocated()) return array_t(label, size_class);
+    Kokkos::deep_copy(out.KokkosView(), T());
+    return out;
+  }
+
+  // Keeps the array for reuse if the caller holds the last reference to it. Arrays that
+  // are still referenced elsewhere are simply dropped and should be released by whoever
+  // owns them last.
+  void Release(array_t &&in) {
+    if (!in.KokkosView().is_allocated() || in.KokkosView().use_count() > 1) return;
+    const std::size_t size_class = in.size();
+    PARTHENON_DEBUG_REQUIRE(size_class == SizeClass(size_class),
+                            "Released array was not obtained from the pool");
+    std::lock_guard<std::mutex> lock(mutex_);
+    bytes_available_ += size_class * sizeof(T);
+    stats_.num_released++;
+    available_[size_class].push_back(std::move(in));
+  }
+
+  // Frees all arrays held for reuse
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    available_.clear();
+    bytes_available_ = 0;
+  }
+
+  // Memory held by the pool for reuse, arrays that are handed out are not included
+  std::uint64_t SizeInBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_available_;
+  }
+
+  Statistics GetStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+  void PrintStatistics() const {
+    const auto stats = GetStatistics();
+    std::cout << stats.num_allocated << " arrays allocated (" << stats.bytes_allocated
+              << " bytes), " << stats.num_reused << " reused, " << stats.num_released
+              << " released, " << SizeInBytes() << " bytes available for reuse."
+              << std::endl;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::size_t, std::vector<array_t>> available_;
+  std::uint64_t bytes_available_ = 0;
+  Statistics stats_;
+};
+
+} // namespace parthenon
+
+#endif // UTILS_SIZE_CLASS_POOL_HPP_
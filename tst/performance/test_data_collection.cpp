@@ -0,0 +1,116 @@
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "basic_types.hpp"
+#include "interface/data_collection.hpp"
+#include "interface/mesh_data.hpp"
+#include "interface/meshblock_data.hpp"
+#include "interface/state_descriptor.hpp"
+#include "mesh/mesh.hpp"
+#include "mesh/meshblock.hpp"
+
+using parthenon::BlockList_t;
+using parthenon::BlockListPartition;
+using parthenon::DataCollection;
+using parthenon::GridIdentifier;
+using parthenon::MeshBlock;
+using parthenon::MeshData;
+using parthenon::Metadata;
+using parthenon::Real;
+using parthenon::StateDescriptor;
+
+// File scope variables
+constexpr int Nblocks = 256; // blocks on the rank
+constexpr int Npack = 4;      // blocks per partition
+constexpr int Nstages = 8;    // stages of the collection, e.g. of an integrator
+constexpr int Nside = 4;      // cells per side of a block
+
+TEST_CASE("DataCollection lookup performance", "[DataCollection][performance]") {
+  GIVEN("A collection with a container for every stage and partition") {
+    auto pkg = std::make_shared<StateDescriptor>("DataCollection test");
+    pkg->AddField("var", Metadata({Metadata::Independent}, std::vector<int>(6, 1)));
+    BlockList_t blocks;
+    for (int b = 0; b < Nblocks; ++b) {
+      auto pmb = std::make_shared<MeshBlock>(Nside, 3);
+      pmb->gid = b;
+      pmb->resolved_packages = pkg;
+      pmb->meshblock_data.Get()->Initialize(pkg, pmb);
+      blocks.push_back(pmb);
+    }
+    std::vector<std::shared_ptr<BlockListPartition>> partitions;
+    for (int p = 0; p < Nblocks / Npack; ++p) {
+      partitions.push_back(std::make_shared<BlockListPartition>(
+          p, GridIdentifier::leaf(),
+          BlockList_t(blocks.begin() + p * Npack, blocks.begin() + (p + 1) * Npack),
+          nullptr));
+    }
+
+    DataCollection<MeshData<Real>> d;
+    std::vector<std::string> labels;
+    std::vector<int> stage_ids;
+    for (int s = 0; s < Nstages; ++s) {
+      labels.push_back(s == 0 ? "base" : "stage" + std::to_string(s));
+      stage_ids.push_back(d.GetStageId(labels.back()));
+      for (auto &partition : partitions) {
+        d.Add(labels.back(), partition);
+      }
+    }
+
+    // What a lookup cost before containers were tabulated by stage id and partition
+    BENCHMARK("Legacy string key lookup") {
+      int nfound = 0;
+      for (const auto &label : labels) {
+        for (const auto &partition : partitions) {
+          auto key = label;
+          for (const auto &pmb : partition->block_list)
+            key += "_" + std::to_string(pmb->gid);
+          nfound += d.Stages().count(key);
+        }
+      }
+      return nfound;
+    };
+
+    BENCHMARK("Lookup by stage label") {
+      std::size_t sum = 0;
+      for (const auto &label : labels) {
+        for (const auto &partition : partitions) {
+          sum += d.Add(label, partition)->NumBlocks();
+        }
+      }
+      return sum;
+    };
+
+    BENCHMARK("Lookup by stage id") {
+      std::size_t sum = 0;
+      for (const int stage_id : stage_ids) {
+        for (const auto &partition : partitions) {
+          sum += d.GetOrAdd(stage_id, partition)->NumBlocks();
+        }
+      }
+      return sum;
+    };
+
+    THEN("All lookups find the same containers") {
+      for (int s = 0; s < Nstages; ++s) {
+        for (auto &partition : partitions) {
+          REQUIRE(d.Add(labels[s], partition) == d.GetOrAdd(stage_ids[s], partition));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,118 @@
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "basic_types.hpp"
+#include "interface/swarm.hpp"
+#include "interface/swarm_default_names.hpp"
+#include "kokkos_abstraction.hpp"
+#include "mesh/mesh.hpp"
+
+#include <parthenon/driver.hpp>
+#include <parthenon/package.hpp>
+
+using parthenon::ApplicationInput;
+using parthenon::Mesh;
+using parthenon::MeshBlock;
+using parthenon::Metadata;
+using parthenon::Packages_t;
+using parthenon::ParameterInput;
+using parthenon::Real;
+using parthenon::Swarm;
+
+namespace {
+// Remove every particle whose index falls in the removed fraction of a repeating
+// pattern, which leaves holes scattered throughout the pool like the output of a
+// transport step does
+void RemoveFraction(MeshBlock *pmb, Swarm *swarm, const Real fill) {
+  auto swarm_d = swarm->GetDeviceContext();
+  constexpr int period = 97;
+  const int nkeep = static_cast<int>(fill * period);
+  pmb->par_for(
+      PARTHENON_AUTO_LABEL, 0, swarm->GetMaxActiveIndex(), KOKKOS_LAMBDA(const int n) {
+        if (swarm_d.IsActive(n) && (n * 31) % period >= nkeep) {
+          swarm_d.MarkParticleForRemoval(n);
+        }
+      });
+  swarm->RemoveMarkedParticles();
+}
+
+bool IsContiguous(MeshBlock *pmb, Swarm *swarm) {
+  auto swarm_d = swarm->GetDeviceContext();
+  const int num_active = swarm->GetNumActive();
+  int nwrong = 0;
+  pmb->par_reduce(
+      PARTHENON_AUTO_LABEL, 0, swarm->GetMask().size() - 1,
+      KOKKOS_LAMBDA(const int n, int &lwrong) {
+        lwrong += (swarm_d.IsActive(n) != (n < num_active));
+      },
+      Kokkos::Sum<int>(nwrong));
+  return nwrong == 0 && swarm->GetMaxActiveIndex() == num_active - 1;
+}
+} // namespace
+
+TEST_CASE("Swarm defragmentation performance", "[Swarm][performance]") {
+  std::stringstream is;
+  is << "<parthenon/mesh>" << std::endl;
+  is << "nx1 = 4" << std::endl;
+  is << "nx2 = 4" << std::endl;
+  is << "nx3 = 4" << std::endl;
+  is << "pack_size = 1" << std::endl;
+  auto pin = std::make_shared<ParameterInput>();
+  pin->LoadFromStream(is);
+  auto app_in = std::make_shared<ApplicationInput>();
+  Packages_t packages;
+  packages.Add(std::make_shared<parthenon::StateDescriptor>("test"));
+  auto meshblock = std::make_shared<MeshBlock>(1, 1);
+  auto mesh = std::make_shared<Mesh>(pin.get(), app_in.get(), packages, 1);
+  meshblock->loc = mesh->GetLocList()[0];
+  meshblock->pmy_mesh = mesh.get();
+
+  for (const int nparticles : {10000, 100000, 1000000}) {
+    for (const Real fill : {0.5, 0.9}) {
+      GIVEN(std::to_string(nparticles) + " particles with fill fraction " +
+            std::to_string(fill)) {
+        Metadata m;
+        auto swarm = std::make_shared<Swarm>("bench swarm", m, nparticles);
+        swarm->SetBlockPointer(meshblock);
+        Metadata m_real({Metadata::Real, Metadata::Particle});
+        swarm->Add(std::vector<std::string>{"v1", "v2", "v3", "weight"}, m_real);
+        Metadata m_int({Metadata::Integer, Metadata::Particle});
+        swarm->Add("id", m_int);
+        swarm->AddEmptyParticles(nparticles);
+
+        BENCHMARK_ADVANCED("Remove, defragment and refill")
+        (Catch::Benchmark::Chronometer meter) {
+          meter.measure([&] {
+            RemoveFraction(meshblock.get(), swarm.get(), fill);
+            swarm->Defrag();
+            swarm->AddEmptyParticles(nparticles - swarm->GetNumActive());
+            Kokkos::fence();
+          });
+        };
+
+        THEN("The swarm is contiguous after defragmenting") {
+          RemoveFraction(meshblock.get(), swarm.get(), fill);
+          REQUIRE(swarm->GetNumActive() < nparticles);
+          swarm->Defrag();
+          REQUIRE(IsContiguous(meshblock.get(), swarm.get()));
+        }
+      }
+    }
+  }
+}
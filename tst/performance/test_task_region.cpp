@@ -0,0 +1,97 @@
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "basic_types.hpp"
+#include "tasks/tasks.hpp"
+
+using parthenon::TaskCollection;
+using parthenon::TaskID;
+using parthenon::TaskListStatus;
+using parthenon::TaskQualifier;
+using parthenon::TaskRegion;
+using parthenon::TaskStatus;
+using parthenon::ThreadPool;
+
+// File scope variables
+constexpr int Nlists = 64;  // number of task lists (i.e. partitions) per region
+constexpr int Nwork = 2000; // iterations per compute task
+constexpr int Npolls = 4;   // times a "communication" task reports incomplete
+
+namespace {
+// stand-in for a compute kernel on a partition
+TaskStatus Compute(std::vector<double> *data, const int i) {
+  double x = (*data)[i];
+  for (int n = 0; n < Nwork; ++n) {
+    x = std::sqrt(x * x + 1.0) - 0.5;
+  }
+  (*data)[i] = x;
+  return TaskStatus::complete;
+}
+
+// stand-in for a task polling on MPI messages
+TaskStatus Poll(std::vector<int> *polls, const int i) {
+  if (++(*polls)[i] % Npolls != 0) return TaskStatus::incomplete;
+  return TaskStatus::complete;
+}
+
+// data holds two slots per list, since the send and interior tasks of a list may run
+// concurrently
+void BuildRegion(TaskRegion &tr, std::vector<double> &data, std::vector<int> &polls) {
+  for (int i = 0; i < tr.size(); ++i) {
+    auto &tl = tr[i];
+    auto send = tl.AddTask(TaskID(), Compute, &data, 2 * i);
+    auto interior = tl.AddTask(TaskID(), Compute, &data, 2 * i + 1);
+    auto recv = tl.AddTask(send, Poll, &polls, i);
+    auto bounds = tl.AddTask(recv | interior, Compute, &data, 2 * i);
+    auto sync = tl.AddTask(TaskQualifier::local_sync, bounds, Compute, &data, 2 * i);
+    tl.AddTask(sync, Compute, &data, 2 * i);
+  }
+}
+} // namespace
+
+TEST_CASE("TaskRegion throughput vs. thread count", "[TaskRegion][performance]") {
+  const int max_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<int> thread_counts;
+  for (int n = 1; n <= max_threads; n *= 2)
+    thread_counts.push_back(n);
+  if (thread_counts.back() != max_threads) thread_counts.push_back(max_threads);
+
+  for (const int nthreads : thread_counts) {
+    GIVEN("A ThreadPool with " + std::to_string(nthreads) + " threads") {
+      ThreadPool pool(nthreads);
+      std::vector<double> data(2 * Nlists, 1.0);
+      std::vector<int> polls(Nlists, 0);
+
+      const std::string name = "Execute region, nthreads = " + std::to_string(nthreads);
+      BENCHMARK_ADVANCED(name.c_str())(Catch::Benchmark::Chronometer meter) {
+        TaskCollection tc;
+        BuildRegion(tc.AddRegion(Nlists), data, polls);
+        meter.measure([&]() { return tc.Execute(pool); });
+      };
+
+      THEN("The region executes to completion") {
+        TaskCollection tc;
+        BuildRegion(tc.AddRegion(Nlists), data, polls);
+        REQUIRE(tc.Execute(pool) == TaskListStatus::complete);
+      }
+    }
+  }
+}
@@ -26,6 +26,12 @@ sys.dont_write_bytecode = True
 class TestCase(utils.test_case.TestCaseAbs):
     def Prepare(self, parameters, step):
         parameters.coverage_status = "both"
+        # Same as step 1 but overlapping the ghost exchange with the interior fluxes
+        if step == 2:
+            parameters.driver_cmd_line_args = [
+                "parthenon/job/problem_id=outflow_overlap",
+                "Advection/overlap_comm=true",
+            ]
         return parameters
 
     def Analyse(self, parameters):
@@ -56,6 +62,20 @@ class TestCase(utils.test_case.TestCaseAbs):
             print("Compare to gold standard failed. Files differ!")
             test_passed = False
 
+        # the core/shell split only reorders the work, so results must be identical
+        delta = compare(
+            [
+                "outflow_overlap.out0.final.phdf",
+                "outflow.out0.final.phdf",
+            ],
+            check_metadata=False,
+            tol=0.0,
+        )
+
+        if delta != 0:
+            print("Overlapping task collection differs from the default one!")
+            test_passed = False
+
         try:
             from phdf import phdf
         except ModuleNotFoundError:
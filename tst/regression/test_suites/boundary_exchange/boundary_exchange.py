@@ -28,6 +28,19 @@ class TestCase(utils.test_case.TestCaseAbs):
 
         parameters.coverage_status = "both"
 
+        # Repeat the exchange using persistent MPI requests
+        if step == 2:
+            parameters.driver_cmd_line_args = [
+                "parthenon/job/problem_id=boundary_exchange_persistent",
+                "parthenon/mesh/persistent_boundary_requests=true",
+            ]
+        # Repeat the exchange applying the physical boundaries block by block
+        if step == 3:
+            parameters.driver_cmd_line_args = [
+                "parthenon/job/problem_id=boundary_exchange_unfused",
+                "parthenon/mesh/fused_physical_boundaries=false",
+            ]
+
         return parameters
 
     def Analyse(self, parameters):
@@ -57,4 +70,33 @@ class TestCase(utils.test_case.TestCaseAbs):
             check_metadata=False,
         )
 
+        if delta != 0:
+            return False
+
+        delta = compare(
+            [
+                "boundary_exchange_persistent.out0.00000.phdf",
+                parameters.parthenon_path
+                + "/tst/regression/gold_standard/boundary_exchange.out0.00000.phdf",
+            ],
+            one=True,
+            tol=1e-12,
+            check_metadata=False,
+        )
+
+        if delta != 0:
+            return False
+
+        # ghost zones (including edges and corners) filled by the fused physical
+        # boundary kernels must match those filled block by block
+        delta = compare(
+            [
+                "boundary_exchange.out0.00000.phdf",
+                "boundary_exchange_unfused.out0.00000.phdf",
+            ],
+            one=True,
+            tol=1e-12,
+            check_metadata=False,
+        )
+
         return delta == 0
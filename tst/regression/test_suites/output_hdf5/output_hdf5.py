@@ -76,6 +76,15 @@ class TestCase(utils.test_case.TestCaseAbs):
                 "Advection/cfl=0.3",
                 "parthenon/time/tlim=0.01",
             ]
+        # Same as step 1 but writing the data outputs asynchronously, which needs
+        # MPI_THREAD_MULTIPLE to be requested
+        elif step == 5:
+            parameters.driver_env = {"PARTHENON_MPI_THREAD_MULTIPLE": "true"}
+            parameters.driver_cmd_line_args = [
+                "parthenon/job/problem_id=advection_2d_async",
+                "parthenon/mesh/nx1=64",
+                "parthenon/output0/async_write=true",
+            ]
         return parameters
 
     def Analyse(self, parameters):
@@ -116,7 +125,16 @@ class TestCase(utils.test_case.TestCaseAbs):
             one=True,
         )
 
-        if ret_2d != 0 or ret_3d != 0:
+        ret_async = phdf_diff.compare(
+            [
+                "advection_2d_async.out0.final.phdf",
+                parameters.parthenon_path
+                + "/tst/regression/gold_standard/advection_2d.out0.final.phdf",
+            ],
+            one=True,
+        )
+
+        if ret_2d != 0 or ret_3d != 0 or ret_async != 0:
             analyze_status = False
 
         hst_2d = np.genfromtxt("advection_2d.out1.hst")
@@ -16,16 +16,64 @@
 # ========================================================================================
 
 # Modules
+import math
 import sys
 import utils.test_case
 
 # To prevent littering up imported folders with .pyc files or __pycache_ folder
 sys.dont_write_bytecode = True
 
+# Command line overrides of each step and the allowed relative deviation of its final rms
+# error from the first step, which is the MG solve with SRJ2 smoothing of the input file.
+# All steps converge to the same discrete solution.
+steps = [
+    ([], 0.0),
+    # Agglomerating coarse GMG levels onto fewer ranks
+    (["parthenon/mesh/gmg_agglomeration_blocks_per_rank=2"], 1e-6),
+    (["parthenon/mesh/gmg_single_rank_blocks=4"], 1e-6),
+    # Chebyshev smoothing, on its own and as preconditioner of BiCGSTAB
+    (["poisson/solver_params/smoother=Chebyshev"], 1e-6),
+    (["poisson/solver=BiCGSTAB", "poisson/solver_params/smoother=Chebyshev"], 1e-6),
+    # Pipelined CG, which is somewhat more sensitive to round off. Unpreconditioned it
+    # needs many more iterations to converge on the refined mesh.
+    (["poisson/solver=CG", "poisson/solver_params/precondition=true"], 1e-6),
+    (
+        [
+            "poisson/solver=CG",
+            "poisson/solver_params/precondition=false",
+            "poisson/solver_params/max_iterations=5000",
+        ],
+        1e-4,
+    ),
+]
+
 
 class TestCase(utils.test_case.TestCaseAbs):
     def Prepare(self, parameters, step):
+        parameters.driver_cmd_line_args = [
+            "poisson/solver_params/max_iterations=100"
+        ] + steps[step - 1][0]
         return parameters
 
     def Analyse(self, parameters):
-        return True
+        errors = []
+        for output in parameters.stdouts:
+            for line in output.decode("utf-8").split("\n"):
+                if "Final rms error:" in line:
+                    errors.append(float(line.split(":")[1]))
+
+        if len(errors) != len(steps):
+            print("Expected a final rms error from every step, found", errors)
+            return False
+
+        analyze_status = True
+        for step, error in enumerate(errors, start=1):
+            tol = steps[step - 1][1] * errors[0]
+            if not math.isfinite(error) or abs(error - errors[0]) > tol:
+                print(
+                    "Step %d final rms error %e differs from reference %e"
+                    % (step, error, errors[0])
+                )
+                analyze_status = False
+
+        return analyze_status
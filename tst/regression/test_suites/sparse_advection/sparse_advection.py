@@ -54,6 +54,13 @@ class TestCase(utils.test_case.TestCaseAbs):
                 "parthenon/static_refinement0/level=3",
             ]
 
+        # Rerun the standard setup with aggregated boundary messages
+        if step == 4:
+            parameters.driver_cmd_line_args = [
+                "parthenon/job/problem_id=sparse_aggregated",
+                "parthenon/mesh/aggregate_boundary_messages=true",
+            ]
+
         return parameters
 
     def Analyse(self, parameters):
@@ -128,5 +135,19 @@ class TestCase(utils.test_case.TestCaseAbs):
             )
             if delta != 0:
                 print("Sparse advection failed for two-tree SMR grid setup.")
+                return False
+
+            delta = compare(
+                [
+                    "sparse_aggregated.out0.final.phdf",
+                    parameters.parthenon_path
+                    + "/tst/regression/gold_standard/sparse_true.out0.final.phdf",
+                ],
+                one=True,
+                tol=1e-12,
+                check_metadata=False,
+            )
+            if delta != 0:
+                print("Sparse advection failed with aggregated boundary messages.")
 
         return delta == 0
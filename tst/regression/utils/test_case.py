@@ -32,6 +32,8 @@ class Parameters:
     num_ranks = 1
     mpi_opts = ""
     driver_cmd_line_args = []
+    # Additional environment variables for the driver, only set for the current step
+    driver_env = {}
     stdouts = []
     kokkos_args = []
     # Options
@@ -198,6 +200,7 @@ class TestManager:
         print("Preparing Test Case Step %d" % step)
         print("*****************************************************************\n")
         sys.stdout.flush()
+        self.parameters.driver_env = {}
         self.parameters = self.test_case.Prepare(self.parameters, step)
 
     def Run(self):
@@ -241,10 +244,17 @@ class TestManager:
             return
 
         print("Command to execute driver")
-        print(" ".join(run_command))
+        env_vars = ["%s=%s" % kv for kv in self.parameters.driver_env.items()]
+        print(" ".join(env_vars + run_command))
         sys.stdout.flush()
         try:
-            proc = subprocess.run(run_command, check=True, stdout=PIPE, stderr=STDOUT)
+            proc = subprocess.run(
+                run_command,
+                check=True,
+                stdout=PIPE,
+                stderr=STDOUT,
+                env=dict(os.environ, **self.parameters.driver_env),
+            )
             print(proc.stdout.decode())
             self.parameters.stdouts.append(proc.stdout)
         except subprocess.CalledProcessError as err:
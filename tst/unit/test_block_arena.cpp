@@ -0,0 +1,115 @@
+//========================================================================================
+// Parthenon performance portable AMR framework
+// Copyright(C) 2024 The Parthenon collaboration
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "basic_types.hpp"
+#include "globals.hpp"
+#include "interface/data_collection.hpp"
+#include "interface/meshblock_data.hpp"
+#include "interface/metadata.hpp"
+#include "interface/state_descriptor.hpp"
+#include "kokkos_abstraction.hpp"
+#include "mesh/meshblock.hpp"
+
+using parthenon::DataCollection;
+using parthenon::DevExecSpace;
+using parthenon::loop_pattern_flatrange_tag;
+using parthenon::MeshBlock;
+using parthenon::MeshBlockData;
+using parthenon::Metadata;
+using parthenon::par_for;
+using parthenon::Real;
+using parthenon::StateDescriptor;
+namespace Globals = parthenon::Globals;
+
+TEST_CASE("Dense variables can be allocated from a block arena", "[MeshBlockData]") {
+  GIVEN("A package with dense and sparse variables and the block arena enabled") {
+    constexpr int N = 6;
+    constexpr int NDIM = 3;
+    const auto arena_config = Globals::block_arena;
+    Globals::block_arena.enabled = true;
+    Globals::block_arena.alignment = 256;
+
+    Metadata m({Metadata::Cell, Metadata::Independent});
+    Metadata m_vector({Metadata::Cell, Metadata::Independent, Metadata::Vector},
+                      std::vector<int>{3});
+    Metadata m_sparse({Metadata::Cell, Metadata::Independent, Metadata::Sparse});
+    auto pkg = std::make_shared<StateDescriptor>("Block arena test");
+    pkg->AddField("v1", m);
+    pkg->AddField("v3", m_vector);
+    pkg->AddSparsePool("s", m_sparse, std::vector<int>{1});
+
+    DataCollection<MeshBlockData<Real>> d;
+    auto pmb = std::make_shared<MeshBlock>(N, NDIM);
+    auto &mbd = d.Get();
+    mbd->Initialize(pkg, pmb);
+
+    const auto &arena = mbd->GetArena();
+    const auto *start = arena.data();
+    const auto *end = start + arena.size();
+    auto in_arena = [&](const Real *p) { return p >= start && p < end; };
+
+    THEN("All dense variables live in one aligned slab") {
+      REQUIRE(arena.IsAllocated());
+      REQUIRE(reinterpret_cast<std::uintptr_t>(start) % 256 == 0);
+      auto &v1 = mbd->Get("v1").data;
+      auto &v3 = mbd->Get("v3").data;
+      REQUIRE(in_arena(v1.data()));
+      REQUIRE(in_arena(v3.data()));
+      REQUIRE(reinterpret_cast<std::uintptr_t>(v3.data()) % 256 == 0);
+      AND_THEN("With grouped interleaving the cell data is contiguous") {
+        auto padded = [](std::size_t n) { return (n * sizeof(Real) + 255) / 256 * 256; };
+        REQUIRE(v3.data() == v1.data() + padded(v1.size()) / sizeof(Real));
+        REQUIRE(arena.size() == (padded(v1.size()) + padded(v3.size())) / sizeof(Real));
+      }
+    }
+
+    THEN("Sparse variables are allocated individually") {
+      if (Globals::sparse_config.enabled) {
+        REQUIRE(!mbd->Get("s_1").IsAllocated());
+      } else {
+        REQUIRE(!in_arena(mbd->Get("s_1").data.data()));
+      }
+    }
+
+    WHEN("We make a stage copy of the block data") {
+      auto &v1 = mbd->Get("v1").data;
+      par_for(
+          loop_pattern_flatrange_tag, "init v1", DevExecSpace(), 0, 0,
+          KOKKOS_LAMBDA(const int i) { v1(0) = 1.0; });
+      auto copy = d.Add("copy", mbd);
+      auto &cv1 = copy->Get("v1").data;
+      THEN("The copy gets its own zero initialized arena") {
+        REQUIRE(copy->GetArena().IsAllocated());
+        REQUIRE(copy->GetArena().data() != start);
+        REQUIRE(cv1.data() == copy->GetArena().data());
+        auto h_cv1 = cv1.GetHostMirrorAndCopy();
+        auto h_v1 = v1.GetHostMirrorAndCopy();
+        REQUIRE(h_cv1(0) == 0.0);
+        REQUIRE(h_v1(0) == 1.0);
+      }
+    }
+
+    Globals::block_arena = arena_config;
+  }
+}
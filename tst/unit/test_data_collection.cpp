@@ -21,13 +21,17 @@
 #include "interface/meshblock_data.hpp"
 #include "interface/metadata.hpp"
 #include "kokkos_abstraction.hpp"
+#include "mesh/mesh.hpp"
 #include "mesh/meshblock.hpp"
 
 // TODO(jcd): can't call the MeshBlock constructor without mesh_refinement.hpp???
 #include "mesh/mesh_refinement.hpp"
 
+using parthenon::BlockList_t;
+using parthenon::BlockListPartition;
 using parthenon::DataCollection;
 using parthenon::DevExecSpace;
+using parthenon::GridIdentifier;
 using parthenon::loop_pattern_flatrange_tag;
 using parthenon::MeshBlock;
 using parthenon::MeshBlockData;
@@ -149,3 +153,61 @@ TEST_CASE("Adding MeshBlockData objects to a DataCollection", "[DataCollection]"
     }
   }
 }
+
+TEST_CASE("Looking up MeshData in a DataCollection by stage id", "[DataCollection]") {
+  GIVEN("Two partitions of a set of blocks") {
+    constexpr int NBLOCKS = 4;
+    auto pkg = std::make_shared<StateDescriptor>("DataCollection test");
+    pkg->AddField("var", Metadata({Metadata::Independent}, std::vector<int>(6, 1)));
+    BlockList_t blocks;
+    for (int b = 0; b < NBLOCKS; ++b) {
+      auto pmb = std::make_shared<MeshBlock>(4, 3);
+      pmb->gid = b;
+      pmb->resolved_packages = pkg;
+      pmb->meshblock_data.Get()->Initialize(pkg, pmb);
+      blocks.push_back(pmb);
+    }
+    auto MakePartitions = [&]() {
+      return std::vector<std::shared_ptr<BlockListPartition>>{
+          std::make_shared<BlockListPartition>(
+              0, GridIdentifier::leaf(), BlockList_t(blocks.begin(), blocks.begin() + 2),
+              nullptr),
+          std::make_shared<BlockListPartition>(
+              1, GridIdentifier::leaf(), BlockList_t(blocks.begin() + 2, blocks.end()),
+              nullptr)};
+    };
+    auto partitions = MakePartitions();
+    DataCollection<MeshData<Real>> d;
+    const int base_id = d.GetStageId("base");
+    const int stage_id = d.GetStageId("stage");
+
+    THEN("Stage ids are interned") {
+      REQUIRE(base_id != stage_id);
+      REQUIRE(d.GetStageId("stage") == stage_id);
+    }
+
+    THEN("Integer and string lookups return the same containers") {
+      auto &md0 = d.GetOrAdd(stage_id, partitions[0]);
+      auto &md1 = d.GetOrAdd(stage_id, partitions[1]);
+      REQUIRE(md0 != md1);
+      REQUIRE(md0->NumBlocks() == 2);
+      REQUIRE(md0->GetBlockData(0)->GetBlockPointer() == blocks[0].get());
+      REQUIRE(md1->GetBlockData(0)->GetBlockPointer() == blocks[2].get());
+      REQUIRE(d.Add("stage", partitions[0]) == md0);
+      REQUIRE(d.GetOrAdd(stage_id, partitions[0]) == md0);
+      REQUIRE(d.GetOrAdd(base_id, partitions[0]) != md0);
+
+      AND_THEN("Rebuilt partitions with the same blocks find the same containers") {
+        auto md0_old = md0;
+        partitions = MakePartitions();
+        REQUIRE(d.GetOrAdd(stage_id, partitions[0]) == md0_old);
+      }
+
+      AND_THEN("Purging the collection removes the containers") {
+        auto md0_old = md0;
+        d.PurgeNonBase();
+        REQUIRE(d.GetOrAdd(stage_id, partitions[0]) != md0_old);
+      }
+    }
+  }
+}
@@ -15,8 +15,10 @@
 // the public, perform publicly and display publicly, and to permit others to do so.
 //========================================================================================
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include <catch2/catch.hpp>
 
@@ -181,3 +183,42 @@ TEST_CASE("Singular forest construction", "[forest]") {
     REQUIRE(locs.size() == 93);
   }
 }
+
+TEST_CASE("Sorted internal node list", "[forest]") {
+  GIVEN("A refined forest with three-, four-, and five-valent points") {
+    auto forest = n_blocks(3, 5);
+    auto leaves = forest.GetMeshBlockListAndResolveGids();
+    constexpr int min_level = -2;
+
+    std::vector<parthenon::LogicalLocation> internal;
+    for (const auto &loc : forest.GetSortedInternalNodeList()) {
+      if (loc.level() >= min_level) internal.push_back(loc);
+    }
+
+    THEN("The internal nodes are ordered by gid") {
+      int nwrong = 0;
+      for (int n = 1; n < internal.size(); ++n) {
+        if (forest.GetGid(internal[n]) <= forest.GetGid(internal[n - 1])) nwrong++;
+      }
+      REQUIRE(nwrong == 0);
+      REQUIRE(forest.GetGid(internal.front()) == leaves.size());
+    }
+
+    THEN("They match the nodes found by walking up from the leaves") {
+      // Every internal node shares its Morton number with exactly one leaf, so walking
+      // up from each leaf while the Morton number stays the same finds each of them once
+      std::vector<parthenon::LogicalLocation> from_leaves;
+      for (const auto &leaf : leaves) {
+        auto loc = leaf.GetParent();
+        while (loc.level() >= min_level && loc.morton() == leaf.morton()) {
+          from_leaves.push_back(loc);
+          loc = loc.GetParent();
+        }
+      }
+      std::sort(from_leaves.begin(), from_leaves.end(), [&](auto &a, auto &b) {
+        return forest.GetGid(a) < forest.GetGid(b);
+      });
+      REQUIRE(from_leaves == internal);
+    }
+  }
+}
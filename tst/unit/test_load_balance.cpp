@@ -0,0 +1,201 @@
+//========================================================================================
+// Parthenon performance portable AMR framework
+// Copyright(C) 2024 The Parthenon collaboration
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "mesh/load_balance.hpp"
+
+using namespace parthenon::load_balance;
+
+namespace {
+// Brute force minimum over all partitions into nranks contiguous chunks of the maximum
+// chunk cost
+double BruteForceBottleneck(const std::vector<double> &costs, int nranks) {
+  const int n = costs.size();
+  std::vector<double> prefix(n + 1, 0.0);
+  for (int i = 0; i < n; ++i)
+    prefix[i + 1] = prefix[i] + costs[i];
+  std::vector<double> best(n + 1, 1e300), next(n + 1);
+  best[0] = 0.0;
+  for (int r = 0; r < nranks; ++r) {
+    std::fill(next.begin(), next.end(), 1e300);
+    for (int j = 0; j <= n; ++j) {
+      for (int i = 0; i <= j; ++i) {
+        next[j] = std::min(next[j], std::max(best[i], prefix[j] - prefix[i]));
+      }
+    }
+    best.swap(next);
+  }
+  return best[n];
+}
+
+double MaxRankCost(const std::vector<double> &costs, const std::vector<int> &ranks,
+                   int nranks) {
+  std::vector<double> rank_costs(nranks, 0.0);
+  for (int i = 0; i < costs.size(); ++i)
+    rank_costs[ranks[i]] += costs[i];
+  return *std::max_element(rank_costs.begin(), rank_costs.end());
+}
+
+// Every rank gets a non-empty chunk and the chunks are ordered by rank
+bool IsContiguous(const std::vector<int> &ranks, int nranks) {
+  if (ranks.front() != 0 || ranks.back() != nranks - 1) return false;
+  for (int i = 1; i < ranks.size(); ++i) {
+    if (ranks[i] != ranks[i - 1] && ranks[i] != ranks[i - 1] + 1) return false;
+  }
+  return true;
+}
+
+int NumMoved(const std::vector<int> &from, const std::vector<int> &to) {
+  int nmoved = 0;
+  for (int i = 0; i < from.size(); ++i)
+    nmoved += (from[i] != to[i]);
+  return nmoved;
+}
+} // namespace
+
+TEST_CASE("Chains-on-chains partitioning is optimal", "[load_balance]") {
+  GIVEN("Random cost lists") {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> cost_dist(0.1, 5.0);
+    int nwrong_bottleneck = 0, nwrong_partition = 0;
+    for (int trial = 0; trial < 200; ++trial) {
+      const int nblocks = 1 + gen() % 40;
+      const int nranks = 1 + gen() % nblocks;
+      std::vector<double> costs(nblocks);
+      for (auto &c : costs)
+        c = (gen() % 3 == 0) ? 1.0 : cost_dist(gen);
+
+      const double optimal = BruteForceBottleneck(costs, nranks);
+      if (OptimalBottleneck(costs, nranks) != Approx(optimal)) nwrong_bottleneck++;
+
+      std::vector<int> ranks;
+      ChainsOnChainsPartition(costs, nranks, ranks);
+      if (ranks.size() != nblocks || !IsContiguous(ranks, nranks) ||
+          MaxRankCost(costs, ranks, nranks) > optimal * (1.0 + 1.e-12)) {
+        nwrong_partition++;
+      }
+    }
+    THEN("The bottleneck matches a brute force search") {
+      REQUIRE(nwrong_bottleneck == 0);
+    }
+    THEN("The partition achieves the bottleneck") { REQUIRE(nwrong_partition == 0); }
+  }
+
+  GIVEN("A cost list the greedy partitioner splits poorly") {
+    // The greedy partitioner stops filling a rank as soon as its target is reached
+    std::vector<double> costs{1.0, 1.0, 1.0, 1.0, 4.0, 1.0};
+    std::vector<int> greedy, optimal;
+    GreedyPartition(costs, 3, greedy);
+    ChainsOnChainsPartition(costs, 3, optimal);
+    THEN("The optimal partition has a lower maximum cost") {
+      REQUIRE(OptimalBottleneck(costs, 3) == 4.0);
+      REQUIRE(MaxRankCost(costs, optimal, 3) == 4.0);
+      REQUIRE(MaxRankCost(costs, greedy, 3) > 4.0);
+    }
+  }
+}
+
+TEST_CASE("Migration aware partitioning", "[load_balance]") {
+  GIVEN("Blocks currently distributed evenly by count") {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> cost_dist(0.5, 1.5);
+    constexpr int nblocks = 256;
+    constexpr int nranks = 16;
+    std::vector<double> costs(nblocks);
+    for (auto &c : costs)
+      c = cost_dist(gen);
+    std::vector<int> current;
+    GreedyPartition(std::vector<double>(nblocks, 1.0), nranks, current);
+
+    const double optimal = OptimalBottleneck(costs, nranks);
+    std::vector<int> unaware, aware;
+    ChainsOnChainsPartition(costs, nranks, unaware);
+    MigrationAwarePartition(costs, current, nranks, 0.1, aware);
+
+    THEN("The load stays within the tolerance of the optimum") {
+      REQUIRE(IsContiguous(aware, nranks));
+      REQUIRE(MaxRankCost(costs, aware, nranks) <= 1.1 * optimal * (1.0 + 1.e-12));
+    }
+    THEN("Fewer blocks move than with the optimal partition") {
+      REQUIRE(NumMoved(current, aware) <= NumMoved(current, unaware));
+    }
+    THEN("A partition within the tolerance is left untouched") {
+      std::vector<int> again;
+      MigrationAwarePartition(costs, aware, nranks, 0.1, again);
+      REQUIRE(again == aware);
+    }
+  }
+
+  GIVEN("No current distribution") {
+    std::vector<double> costs{3.0, 1.0, 1.0, 2.0, 2.0, 5.0, 1.0};
+    std::vector<int> aware, optimal;
+    MigrationAwarePartition(costs, {}, 3, 0.5, aware);
+    ChainsOnChainsPartition(costs, 3, optimal);
+    THEN("It falls back to the optimal partition") { REQUIRE(aware == optimal); }
+  }
+}
+
+TEST_CASE("Agglomerating sparse GMG levels", "[load_balance]") {
+  // Default ranks of 12 blocks evenly distributed over 4 ranks
+  const std::vector<int> default_ranks{0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3};
+  constexpr int nranks = 4;
+
+  GIVEN("Agglomeration disabled") {
+    THEN("The default ranks are kept") {
+      REQUIRE(AgglomerateGMGLevel(default_ranks, nranks, 0, 0) == default_ranks);
+    }
+  }
+
+  GIVEN("A level with at least blocks_per_rank blocks per rank") {
+    THEN("The default ranks are kept") {
+      REQUIRE(AgglomerateGMGLevel(default_ranks, nranks, 3, 0) == default_ranks);
+    }
+  }
+
+  GIVEN("A level with fewer than blocks_per_rank blocks per rank") {
+    auto ranks = AgglomerateGMGLevel(default_ranks, nranks, 4, 0);
+    THEN("Chunks of blocks_per_rank blocks move to the owner of their first block") {
+      const std::vector<int> expected{0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2};
+      REQUIRE(ranks == expected);
+    }
+  }
+
+  GIVEN("A level whose last chunk is incomplete") {
+    auto ranks = AgglomerateGMGLevel(default_ranks, nranks, 5, 0);
+    THEN("The last chunk holds the remaining blocks") {
+      const std::vector<int> expected{0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 3, 3};
+      REQUIRE(ranks == expected);
+    }
+  }
+
+  GIVEN("A level with at most single_rank_blocks blocks") {
+    THEN("All blocks move to the owner of the first block") {
+      REQUIRE(AgglomerateGMGLevel(default_ranks, nranks, 4, 12) ==
+              std::vector<int>(12, 0));
+      const std::vector<int> shifted{1, 1, 2, 2, 3};
+      REQUIRE(AgglomerateGMGLevel(shifted, nranks, 0, 8) == std::vector<int>(5, 1));
+    }
+    THEN("Larger levels are not affected by the single rank rule") {
+      REQUIRE(AgglomerateGMGLevel(default_ranks, nranks, 0, 11) == default_ranks);
+    }
+  }
+}
@@ -15,6 +15,7 @@
 // the public, perform publicly and display publicly, and to permit others to do so.
 //========================================================================================
 
+#include <algorithm>
 #include <cstdio>
 #include <memory>
 #include <string>
@@ -178,6 +179,20 @@ TEST_CASE("The VarInfo object produces appropriate ranges", "[VarInfo][OutputUti
         REQUIRE(info.Size() == 3 * 4);
         REQUIRE(info.TensorSize() * info.ntop_elems == 3 * 4);
       }
+      THEN("Packing visits every element exactly once") {
+        for (const bool do_ghosts : {false, true}) {
+          int idx = 0;
+          std::vector<int> visits(info.Size(), 0);
+          PackOrUnpackVar(info, do_ghosts, idx,
+                          [&](auto index, int topo, int t, int u, int v, int k, int j,
+                              int i) {
+                            REQUIRE(index < info.Size());
+                            visits[index]++;
+                          });
+          REQUIRE(idx == info.Size());
+          REQUIRE(std::count(visits.begin(), visits.end(), 1) == info.Size());
+        }
+      }
     }
 
     WHEN("We initialize VarInfo on a vector face var") {
@@ -0,0 +1,145 @@
+//========================================================================================
+// Parthenon performance portable AMR framework
+// Copyright(C) 2024 The Parthenon collaboration
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+// (C) (or copyright) 2024. Triad National Security, LLC. All rights reserved.
+//
+// This program was produced under U.S. Government contract 89233218CNA000001 for Los
+// Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC
+// for the U.S. Department of Energy/National Nuclear Security Administration. All rights
+// in the program are reserved by Triad National Security, LLC, and the U.S. Department
+// of Energy/National Nuclear Security Administration. The Government is granted for
+// itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide
+// license in this material to reproduce, prepare derivative works, distribute copies to
+// the public, perform publicly and display publicly, and to permit others to do so.
+//========================================================================================
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "basic_types.hpp"
+#include "kokkos_abstraction.hpp"
+#include "tasks/tasks.hpp"
+#include "utils/size_class_pool.hpp"
+
+using parthenon::DevExecSpace;
+using parthenon::loop_pattern_flatrange_tag;
+using parthenon::par_for;
+using parthenon::Real;
+using parthenon::SizeClassPool;
+using parthenon::TaskCollection;
+using parthenon::TaskID;
+using parthenon::TaskListStatus;
+using parthenon::TaskStatus;
+using parthenon::ThreadPool;
+
+TEST_CASE("Size classes", "[SizeClassPool]") {
+  using pool_t = SizeClassPool<Real>;
+  int nwrong = 0;
+  for (std::size_t n = 1; n < 100000; ++n) {
+    const std::size_t c = pool_t::SizeClass(n);
+    // A class holds the request, wastes at most a quarter and is its own class
+    if (c < n || 4 * (c - n) > c || pool_t::SizeClass(c) != c) nwrong++;
+  }
+  REQUIRE(nwrong == 0);
+  REQUIRE(pool_t::SizeClass(9) == 10);
+  REQUIRE(pool_t::SizeClass(16) == 16);
+  REQUIRE(pool_t::SizeClass(17) == 20);
+}
+
+TEST_CASE("Recycling arrays in a size class pool", "[SizeClassPool]") {
+  GIVEN("A pool and an array taken from it") {
+    SizeClassPool<Real> pool;
+    constexpr std::size_t N = 1000;
+    auto a = pool.Get("a", N);
+    const Real *ptr = a.data();
+    REQUIRE(a.size() == SizeClassPool<Real>::SizeClass(N));
+    REQUIRE(pool.GetStatistics().num_allocated == 1);
+    REQUIRE(pool.SizeInBytes() == 0);
+
+    par_for(
+        loop_pattern_flatrange_tag, "fill", DevExecSpace(), 0, a.size() - 1,
+        KOKKOS_LAMBDA(const int i) { a(i) = 1.0; });
+    Kokkos::fence();
+
+    WHEN("The array is released and a similar size is requested") {
+      pool.Release(std::move(a));
+      REQUIRE(pool.SizeInBytes() == SizeClassPool<Real>::SizeClass(N) * sizeof(Real));
+      auto b = pool.Get("b", N - 10);
+      THEN("The storage is reused and zeroed") {
+        REQUIRE(b.data() == ptr);
+        REQUIRE(pool.GetStatistics().num_reused == 1);
+        REQUIRE(pool.GetStatistics().num_allocated == 1);
+        REQUIRE(pool.SizeInBytes() == 0);
+        auto b_h = b.GetHostMirrorAndCopy();
+        Real sum = 0.0;
+        for (int i = 0; i < b_h.size(); ++i)
+          sum += b_h(i);
+        REQUIRE(sum == 0.0);
+      }
+    }
+
+    WHEN("A different size class is requested") {
+      pool.Release(std::move(a));
+      auto b = pool.Get("b", 4 * N);
+      THEN("New storage is allocated") {
+        REQUIRE(b.data() != ptr);
+        REQUIRE(pool.GetStatistics().num_allocated == 2);
+      }
+    }
+
+    WHEN("An array that is still referenced elsewhere is released") {
+      auto copy = a;
+      pool.Release(std::move(a));
+      THEN("The pool does not take it back") {
+        REQUIRE(pool.GetStatistics().num_released == 0);
+        REQUIRE(pool.SizeInBytes() == 0);
+      }
+    }
+
+    WHEN("The pool is cleared") {
+      pool.Release(std::move(a));
+      pool.Clear();
+      THEN("No memory is held anymore") { REQUIRE(pool.SizeInBytes() == 0); }
+    }
+  }
+}
+
+TEST_CASE("Using a size class pool from several threads", "[SizeClassPool]") {
+  GIVEN("A pool shared by task lists executed on several threads") {
+    constexpr int nlists = 8;
+    constexpr int nrepeat = 50;
+    constexpr std::size_t N = 100;
+    for (int nthreads : {1, 2, 4}) {
+      SizeClassPool<Real> pool;
+      ThreadPool threads(nthreads);
+      TaskCollection tc;
+      auto &tr = tc.AddRegion(nlists);
+      for (int i = 0; i < nlists; ++i) {
+        tr[i].AddTask(TaskID(), [&pool, i]() {
+          for (int rep = 0; rep < nrepeat; ++rep) {
+            // One size class shared by all lists and one shared by half of them
+            std::vector<SizeClassPool<Real>::array_t> arrays;
+            arrays.push_back(pool.Get("a", N));
+            arrays.push_back(pool.Get("b", (i % 2 + 1) * 4 * N));
+            for (auto &a : arrays)
+              pool.Release(std::move(a));
+          }
+          return TaskStatus::complete;
+        });
+      }
+      REQUIRE(tc.Execute(threads) == TaskListStatus::complete);
+
+      // Every request is accounted for and all storage is back in the pool
+      const auto stats = pool.GetStatistics();
+      REQUIRE(stats.num_allocated + stats.num_reused == 2 * nlists * nrepeat);
+      REQUIRE(stats.num_released == 2 * nlists * nrepeat);
+      REQUIRE(stats.num_allocated <= 2 * nlists);
+      REQUIRE(pool.SizeInBytes() == stats.bytes_allocated);
+    }
+  }
+}
@@ -377,6 +377,25 @@ TEST_CASE("Test behavior of sparse packs", "[SparsePack]") {
         REQUIRE(nwrong == 0);
       }
 
+      THEN("A cached sparse pack is reused until the allocation status changes") {
+        auto desc = parthenon::MakePackDescriptor<v1, v3, v5>(pkg.get());
+        auto pack = desc.GetPack(&mesh_data);
+        pack = desc.GetPack(&mesh_data);
+        REQUIRE(mesh_data.GetSparsePackCache().size() == 1);
+        REQUIRE(pack.ContainsHost(1, v5()));
+
+        const auto epoch = block_list[1]->GetAllocationEpoch();
+        block_list[1]->DeallocateSparse("v5");
+        REQUIRE(block_list[1]->GetAllocationEpoch() > epoch);
+        REQUIRE(block_list[1]->GetAllocationEpoch() >
+                block_list[0]->GetAllocationEpoch());
+
+        pack = desc.GetPack(&mesh_data);
+        REQUIRE(mesh_data.GetSparsePackCache().size() == 1);
+        REQUIRE(!pack.ContainsHost(1, v5()));
+        REQUIRE(pack.ContainsHost(0, v5()));
+      }
+
       THEN("A sparse pack built with a subset of blocks is the right size") {
         auto desc =
             parthenon::MakePackDescriptor<parthenon::variable_names::any_nonautoflux>(
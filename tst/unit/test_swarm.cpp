@@ -17,10 +17,12 @@
 // so.
 //========================================================================================
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <random>
 #include <string>
+#include <vector>
 
 #include <catch2/catch.hpp>
 
@@ -38,6 +40,8 @@
 using Real = double;
 using parthenon::ApplicationInput;
 using parthenon::BoundaryFlag;
+using parthenon::IndexDomain;
+using parthenon::IndexRange;
 using parthenon::Mesh;
 using parthenon::MeshBlock;
 using parthenon::Metadata;
@@ -238,3 +242,200 @@ TEST_CASE("Swarm memory management", "[Swarm]") {
   failures_h = failures_d.GetHostMirrorAndCopy();
   REQUIRE(failures_h(0) == 0);
 }
+
+TEST_CASE("Swarm sorting by cell", "[Swarm]") {
+  std::stringstream is;
+  is << "<parthenon/mesh>" << endl;
+  is << "x1min = -0.5" << endl;
+  is << "x2min = -0.5" << endl;
+  is << "x3min = -0.5" << endl;
+  is << "x1max = 0.5" << endl;
+  is << "x2max = 0.5" << endl;
+  is << "x3max = 0.5" << endl;
+  is << "nx1 = 4" << endl;
+  is << "nx2 = 4" << endl;
+  is << "nx3 = 4" << endl;
+  is << "pack_size = 1" << endl;
+  auto pin = std::make_shared<ParameterInput>();
+  pin->LoadFromStream(is);
+  auto app_in = std::make_shared<ApplicationInput>();
+  Packages_t packages;
+  packages.Add(std::make_shared<parthenon::StateDescriptor>("test"));
+  auto mesh = std::make_shared<Mesh>(pin.get(), app_in.get(), packages, 1);
+  auto meshblock = std::make_shared<MeshBlock>(4, 3);
+  meshblock->loc = mesh->GetLocList()[0];
+  meshblock->pmy_mesh = mesh.get();
+  meshblock->coords = parthenon::Coordinates_t(mesh->mesh_size, pin.get());
+
+  Metadata m;
+  auto swarm = std::make_shared<Swarm>("test swarm", m, NUMINIT);
+  swarm->SetBlockPointer(meshblock);
+  swarm->AddEmptyParticles(6);
+
+  // Particles 0, 2 and 5 share the first interior cell, particle 3 is in the last
+  // interior cell and particle 4 in a ghost cell. Particle 1 is removed.
+  const auto &coords = meshblock->coords;
+  const IndexRange ib = meshblock->cellbounds.GetBoundsI(IndexDomain::interior);
+  const IndexRange jb = meshblock->cellbounds.GetBoundsJ(IndexDomain::interior);
+  const IndexRange kb = meshblock->cellbounds.GetBoundsK(IndexDomain::interior);
+  auto x_h = swarm->Get<Real>(swarm_position::x::name()).Get().GetHostMirror();
+  auto y_h = swarm->Get<Real>(swarm_position::y::name()).Get().GetHostMirror();
+  auto z_h = swarm->Get<Real>(swarm_position::z::name()).Get().GetHostMirror();
+  for (int n : {0, 1, 2, 5}) {
+    x_h(n) = coords.Xc<1>(ib.s);
+    y_h(n) = coords.Xc<2>(jb.s);
+    z_h(n) = coords.Xc<3>(kb.s);
+  }
+  x_h(3) = coords.Xc<1>(ib.e);
+  y_h(3) = coords.Xc<2>(jb.e);
+  z_h(3) = coords.Xc<3>(kb.e);
+  x_h(4) = coords.Xc<1>(ib.s - 1);
+  y_h(4) = coords.Xc<2>(jb.s);
+  z_h(4) = coords.Xc<3>(kb.s);
+  swarm->Get<Real>(swarm_position::x::name()).Get().DeepCopy(x_h);
+  swarm->Get<Real>(swarm_position::y::name()).Get().DeepCopy(y_h);
+  swarm->Get<Real>(swarm_position::z::name()).Get().DeepCopy(z_h);
+
+  auto swarm_d = swarm->GetDeviceContext();
+  meshblock->par_for(
+      "Remove particle", 0, 0,
+      KOKKOS_LAMBDA(const int n) { swarm_d.MarkParticleForRemoval(1); });
+  swarm->RemoveMarkedParticles();
+  swarm->SortParticlesByCell();
+  swarm_d = swarm->GetDeviceContext();
+
+  const int ks = kb.s, js = jb.s, is_ = ib.s;
+  const int ke = kb.e, je = jb.e, ie = ib.e;
+  int nparticles = 0, first_cell = 0, last_cell = -1, ghost_cell = -1;
+  const IndexRange ib_all = meshblock->cellbounds.GetBoundsI(IndexDomain::entire);
+  const IndexRange jb_all = meshblock->cellbounds.GetBoundsJ(IndexDomain::entire);
+  const IndexRange kb_all = meshblock->cellbounds.GetBoundsK(IndexDomain::entire);
+  meshblock->par_reduce(
+      "Count sorted particles", kb_all.s, kb_all.e, jb_all.s, jb_all.e, ib_all.s,
+      ib_all.e,
+      KOKKOS_LAMBDA(const int k, const int j, const int i, int &lcount) {
+        lcount += swarm_d.GetParticleCountPerCell(k, j, i);
+      },
+      Kokkos::Sum<int>(nparticles));
+  meshblock->par_reduce(
+      "Check first cell", 0, 0,
+      KOKKOS_LAMBDA(const int, int &lsum) {
+        for (int n = 0; n < swarm_d.GetParticleCountPerCell(ks, js, is_); n++) {
+          const int idx = swarm_d.GetFullIndex(ks, js, is_, n);
+          lsum += (idx == 0) ? 1 : (idx == 2) ? 10 : (idx == 5) ? 100 : 1000;
+        }
+      },
+      Kokkos::Sum<int>(first_cell));
+  meshblock->par_reduce(
+      "Check last cell", 0, 0,
+      KOKKOS_LAMBDA(const int, int &lidx) {
+        lidx = (swarm_d.GetParticleCountPerCell(ke, je, ie) == 1)
+                   ? swarm_d.GetFullIndex(ke, je, ie, 0)
+                   : -2;
+      },
+      Kokkos::Max<int>(last_cell));
+  meshblock->par_reduce(
+      "Check ghost cell", 0, 0,
+      KOKKOS_LAMBDA(const int, int &lidx) {
+        lidx = (swarm_d.GetParticleCountPerCell(ks, js, is_ - 1) == 1)
+                   ? swarm_d.GetFullIndex(ks, js, is_ - 1, 0)
+                   : -2;
+      },
+      Kokkos::Max<int>(ghost_cell));
+
+  REQUIRE(nparticles == 5);
+  REQUIRE(first_cell == 111);
+  REQUIRE(last_cell == 3);
+  REQUIRE(ghost_cell == 4);
+}
+
+TEST_CASE("Swarm defragmentation preserves particle data", "[Swarm]") {
+  std::stringstream is;
+  is << "<parthenon/mesh>" << endl;
+  is << "nx1 = 4" << endl;
+  is << "nx2 = 4" << endl;
+  is << "nx3 = 4" << endl;
+  is << "pack_size = 1" << endl;
+  auto pin = std::make_shared<ParameterInput>();
+  pin->LoadFromStream(is);
+  auto app_in = std::make_shared<ApplicationInput>();
+  Packages_t packages;
+  packages.Add(std::make_shared<parthenon::StateDescriptor>("test"));
+  auto mesh = std::make_shared<Mesh>(pin.get(), app_in.get(), packages, 1);
+  auto meshblock = std::make_shared<MeshBlock>(1, 1);
+  meshblock->loc = mesh->GetLocList()[0];
+  meshblock->pmy_mesh = mesh.get();
+
+  Metadata m;
+  auto swarm = std::make_shared<Swarm>("test swarm", m, NUMINIT);
+  swarm->SetBlockPointer(meshblock);
+  swarm->Add("id", Metadata({Metadata::Integer, Metadata::Particle}));
+
+  // Enough particles to grow the pool, each tagged with its original index
+  constexpr int NPART = 3 * NUMINIT + 7;
+  swarm->AddEmptyParticles(NPART);
+  auto x_h = swarm->Get<Real>(swarm_position::x::name()).Get().GetHostMirror();
+  auto id_h = swarm->Get<int>("id").Get().GetHostMirror();
+  for (int n = 0; n < NPART; n++) {
+    x_h(n) = 0.5 + n;
+    id_h(n) = n;
+  }
+  swarm->Get<Real>(swarm_position::x::name()).Get().DeepCopy(x_h);
+  swarm->Get<int>("id").Get().DeepCopy(id_h);
+
+  // Remove a scattered subset, including the first and the last particle. The device
+  // kernel below repeats the same condition.
+  auto removed = [](const int n) { return n % 3 == 0 || n % 7 == 5; };
+  std::vector<int> survivors;
+  for (int n = 0; n < NPART; n++) {
+    if (!removed(n)) survivors.push_back(n);
+  }
+  const int nsurvivors = static_cast<int>(survivors.size());
+  REQUIRE(removed(0));
+  REQUIRE(removed(NPART - 1));
+
+  auto swarm_d = swarm->GetDeviceContext();
+  meshblock->par_for(
+      "Remove particles", 0, NPART - 1, KOKKOS_LAMBDA(const int n) {
+        if (n % 3 == 0 || n % 7 == 5) swarm_d.MarkParticleForRemoval(n);
+      });
+  swarm->RemoveMarkedParticles();
+  swarm->Defrag();
+
+  THEN("The surviving particles occupy the lowest slots") {
+    REQUIRE(swarm->GetNumActive() == nsurvivors);
+    REQUIRE(swarm->GetMaxActiveIndex() == nsurvivors - 1);
+    auto mask_h = Kokkos::create_mirror_view_and_copy(parthenon::HostMemSpace(),
+                                                      swarm->GetMask());
+    for (int n = 0; n < mask_h.extent_int(0); n++) {
+      REQUIRE(mask_h(n) == (n < nsurvivors));
+    }
+  }
+
+  THEN("Every surviving particle keeps all of its data") {
+    x_h = swarm->Get<Real>(swarm_position::x::name()).Get().GetHostMirrorAndCopy();
+    id_h = swarm->Get<int>("id").Get().GetHostMirrorAndCopy();
+    std::vector<int> ids;
+    for (int n = 0; n < nsurvivors; n++) {
+      REQUIRE(x_h(n) == 0.5 + id_h(n));
+      ids.push_back(id_h(n));
+    }
+    std::sort(ids.begin(), ids.end());
+    REQUIRE(ids == survivors);
+  }
+
+  THEN("New particles fill the freed slots above the survivors") {
+    const int nnew = NPART - nsurvivors;
+    auto new_particles = swarm->AddEmptyParticles(nnew);
+    int nwrong = 0;
+    meshblock->par_reduce(
+        "Check new indices", 0, nnew - 1,
+        KOKKOS_LAMBDA(const int n, int &lwrong) {
+          lwrong += (new_particles.GetNewParticleIndex(n) != nsurvivors + n);
+        },
+        Kokkos::Sum<int>(nwrong));
+    REQUIRE(nwrong == 0);
+    REQUIRE(swarm->GetNumActive() == NPART);
+    REQUIRE(swarm->GetMaxActiveIndex() == NPART - 1);
+  }
+}
@@ -12,7 +12,9 @@
 //========================================================================================
 
 // STL Includes
+#include <atomic>
 #include <memory>
+#include <vector>
 
 // Third Party Includes
 #include <catch2/catch.hpp>
@@ -21,9 +23,13 @@
 #include "basic_types.hpp"
 #include "tasks/tasks.hpp"
 
+using parthenon::TaskCollection;
 using parthenon::TaskID;
 using parthenon::TaskList;
+using parthenon::TaskListStatus;
+using parthenon::TaskQualifier;
 using parthenon::TaskStatus;
+using parthenon::ThreadPool;
 
 TEST_CASE("Task Object Lifecycle", "[TaskList][AddTask]") {
   GIVEN("A TaskList") {
@@ -48,3 +54,88 @@ TEST_CASE("Task Object Lifecycle", "[TaskList][AddTask]") {
     REQUIRE(track_destruction.expired());
   }
 }
+
+TEST_CASE("Multi-threaded TaskRegion execution", "[TaskList][ThreadPool]") {
+  GIVEN("A region with many lists containing joins, polling tasks, and iteration") {
+    constexpr int nlists = 16;
+    constexpr int nrepeat = 20;
+    for (int nthreads : {1, 2, 4}) {
+      ThreadPool pool(nthreads);
+      for (int rep = 0; rep < nrepeat; ++rep) {
+        std::atomic<int> count{0};
+        std::vector<int> polls(nlists, 0);
+        std::vector<int> iters(nlists, 0);
+        auto incr = [&count]() {
+          count++;
+          return TaskStatus::complete;
+        };
+
+        TaskCollection tc;
+        auto &tr = tc.AddRegion(nlists);
+        for (int i = 0; i < nlists; ++i) {
+          auto a = tr[i].AddTask(TaskID(), incr);
+          auto b = tr[i].AddTask(a, incr);
+          auto c = tr[i].AddTask(a, incr);
+          auto d = tr[i].AddTask(b | c, [&count, &polls, i]() {
+            if (++polls[i] < 3) return TaskStatus::incomplete;
+            count++;
+            return TaskStatus::complete;
+          });
+          auto e = tr[i].AddTask(TaskQualifier::local_sync, d, incr);
+          auto [sl, sl_id] = tr[i].AddSublist(e, {1, 10});
+          sl.AddTask(TaskQualifier::completion, TaskID(), [&count, &iters, i]() {
+            count++;
+            return (++iters[i] < 3) ? TaskStatus::iterate : TaskStatus::complete;
+          });
+          tr[i].AddTask(sl_id, incr);
+        }
+
+        REQUIRE(tc.Execute(pool) == TaskListStatus::complete);
+        // a, b, c, d, e, 3 iterations of the sublist task, and the final task
+        REQUIRE(count == nlists * 9);
+      }
+    }
+  }
+}
+
+TEST_CASE("Iterating sublists with regional dependencies", "[TaskList][ThreadPool]") {
+  GIVEN("A region whose lists iterate a sublist containing local_sync tasks") {
+    constexpr int nlists = 8;
+    constexpr int niters = 4;
+    for (int nthreads : {1, 2, 4}) {
+      ThreadPool pool(nthreads);
+      std::atomic<int> count{0};
+      std::vector<int> iters(nlists, 0);
+      auto incr = [&count]() {
+        count++;
+        return TaskStatus::complete;
+      };
+
+      TaskCollection tc;
+      auto &tr = tc.AddRegion(nlists);
+      for (int i = 0; i < nlists; ++i) {
+        auto a = tr[i].AddTask(TaskID(), incr);
+        auto b = tr[i].AddTask(TaskID(), incr);
+        auto [itl, itl_id] = tr[i].AddSublist(a, {1, 2 * niters});
+        auto sync = itl.AddTask(TaskQualifier::local_sync, TaskID(), incr);
+        // depends on a task outside of the iterating sublist
+        auto c = itl.AddTask(sync | b, incr);
+        auto once = itl.AddTask(
+            TaskQualifier::once_per_region | TaskQualifier::local_sync, c, incr);
+        itl.AddTask(TaskQualifier::completion, once, [&count, &iters, i]() {
+          count++;
+          return (++iters[i] < niters) ? TaskStatus::iterate : TaskStatus::complete;
+        });
+        tr[i].AddTask(itl_id, incr);
+      }
+
+      REQUIRE(tc.Execute(pool) == TaskListStatus::complete);
+      // a, b, and the final task once, sync, c, and the completion task every
+      // iteration on every list, and the once_per_region task every iteration
+      REQUIRE(count == 3 * nlists + niters * (3 * nlists + 1));
+      for (int i = 0; i < nlists; ++i) {
+        REQUIRE(iters[i] == niters);
+      }
+    }
+  }
+}
@@ -455,3 +455,75 @@ TEST_CASE("Checking IndexShape cell counts", "[IndexShape]") {
     REQUIRE(shape.ncellsk(entire) == 1);
   }
 }
+
+TEST_CASE("Splitting the interior into core and shell", "[IndexShape]") {
+  using parthenon::IndexBox;
+  using parthenon::TopologicalElement;
+  auto count = [](const IndexBox &b) {
+    if (b.empty()) return 0;
+    return (b.k.e - b.k.s + 1) * (b.j.e - b.j.s + 1) * (b.i.e - b.i.s + 1);
+  };
+
+  GIVEN("A 3D Index Shape") {
+    parthenon::IndexShape shape(4, 6, 8, 2);
+    const int ninterior = shape.GetTotal(parthenon::IndexDomain::interior);
+
+    WHEN("We take the core one cell away from the ghost zones") {
+      auto core = shape.GetCoreBox(1);
+      THEN("Its bounds are shrunk in every direction") {
+        REQUIRE(core.i.s == 3);
+        REQUIRE(core.i.e == 8);
+        REQUIRE(core.j.s == 3);
+        REQUIRE(core.j.e == 6);
+        REQUIRE(core.k.s == 3);
+        REQUIRE(core.k.e == 4);
+      }
+      THEN("Core and shell cover the interior exactly once") {
+        int nshell = 0;
+        for (const auto &b : shape.GetShellBoxes(core))
+          nshell += count(b);
+        REQUIRE(count(core) + nshell == ninterior);
+        REQUIRE(count(core) == 2 * 4 * 6);
+      }
+    }
+
+    WHEN("The core is wider than the block") {
+      auto core = shape.GetCoreBox(2);
+      THEN("It is empty and the shell holds the whole interior") {
+        REQUIRE(core.empty());
+        int nshell = 0;
+        for (const auto &b : shape.GetShellBoxes(core))
+          nshell += count(b);
+        REQUIRE(nshell == ninterior);
+      }
+    }
+
+    WHEN("We only shrink the x1 faces along x1") {
+      const auto F1 = TopologicalElement::F1;
+      auto core = shape.GetBox(parthenon::IndexDomain::interior, F1);
+      core.i = shape.GetCoreBoundsI(1, F1);
+      THEN("The shell consists of the two outermost faces") {
+        REQUIRE(core.i.s == 3);
+        REQUIRE(core.i.e == 9);
+        auto shell = shape.GetShellBoxes(core, F1);
+        REQUIRE(count(shell[4]) == 4 * 6);
+        REQUIRE(count(shell[5]) == 4 * 6);
+        REQUIRE(count(shell[0]) + count(shell[1]) + count(shell[2]) + count(shell[3]) ==
+                0);
+      }
+    }
+  }
+
+  GIVEN("A 1D Index Shape") {
+    parthenon::IndexShape shape(8, 2);
+    THEN("Dimensions without ghost zones are not shrunk") {
+      auto core = shape.GetCoreBox(1);
+      REQUIRE(core.i.s == 3);
+      REQUIRE(core.i.e == 8);
+      REQUIRE(core.j.s == 0);
+      REQUIRE(core.j.e == 0);
+      REQUIRE(core.k.s == 0);
+      REQUIRE(core.k.e == 0);
+    }
+  }
+}